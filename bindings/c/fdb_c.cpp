@@ -19,6 +19,7 @@
  */
 
 #include "fdbclient/FDBTypes.h"
+#include "flow/ApiVersion.h"
 #include "flow/ProtocolVersion.h"
 #include <cstdint>
 #define FDB_USE_LATEST_API_VERSION
@@ -508,6 +509,15 @@ extern "C" DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_database_get_client_statu
 	return (FDBFuture*)(DB(db)->getClientStatus().extractPtr());
 }
 
+extern "C" DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_database_warm_location_cache(FDBDatabase* db,
+                                                                                 uint8_t const* begin_key_name,
+                                                                                 int begin_key_name_length,
+                                                                                 uint8_t const* end_key_name,
+                                                                                 int end_key_name_length) {
+	KeyRangeRef range(KeyRef(begin_key_name, begin_key_name_length), KeyRef(end_key_name, end_key_name_length));
+	return (FDBFuture*)(DB(db)->warmLocationCache(range).extractPtr());
+}
+
 extern "C" DLLEXPORT void fdb_transaction_destroy(FDBTransaction* tr) {
 	try {
 		TXN(tr)->delref();
@@ -538,6 +548,13 @@ FDBFuture* fdb_transaction_get_v13(FDBTransaction* tr, uint8_t const* key_name,
 	return fdb_transaction_get_impl(tr, key_name, key_name_length, 0);
 }
 
+extern "C" DLLEXPORT FDBFuture* fdb_transaction_get_multiple(FDBTransaction* tr,
+                                                             FDBKey const* keys,
+                                                             int count,
+                                                             fdb_bool_t snapshot) {
+	return (FDBFuture*)(TXN(tr)->getMultiple(VectorRef<KeyRef>((KeyRef*)keys, count), snapshot).extractPtr());
+}
+
 FDBFuture* fdb_transaction_get_key_impl(FDBTransaction* tr,
                                         uint8_t const* key_name,
                                         int key_name_length,
@@ -588,8 +605,9 @@ FDBFuture* validate_and_update_parameters(int& limit,
 		return TSAV_ERROR(Standalone<RangeResultRef>, exact_mode_without_limits);
 
 	/* _ITERATOR mode maps to one of the known streaming modes
-	   depending on iteration */
-	const int mode_bytes_array[] = { GetRangeLimits::BYTE_LIMIT_UNLIMITED, 256, 1000, 4096, 120000 };
+	   depending on iteration. _PARALLEL batches cover several shards read
+	   concurrently */
+	const int mode_bytes_array[] = { GetRangeLimits::BYTE_LIMIT_UNLIMITED, 256, 1000, 4096, 120000, 1000000 };
 
 	/* The progression used for FDB_STREAMING_MODE_ITERATOR.
 	   Goes 1.5 * previous. */
@@ -610,6 +628,8 @@ FDBFuture* validate_and_update_parameters(int& limit,
 		mode_bytes = iteration_progression[iteration - 1];
 	} else if (mode >= 0 && mode <= FDB_STREAMING_MODE_SERIAL)
 		mode_bytes = mode_bytes_array[mode];
+	else if (mode == FDB_STREAMING_MODE_PARALLEL && ApiVersion(g_api_version).hasParallelRangeReads())
+		mode_bytes = mode_bytes_array[mode];
 	else
 		return TSAV_ERROR(Standalone<RangeResultRef>, client_invalid_operation);
 
@@ -639,12 +659,14 @@ FDBFuture* fdb_transaction_get_range_impl(FDBTransaction* tr,
 	FDBFuture* r = validate_and_update_parameters(limit, target_bytes, mode, iteration, reverse);
 	if (r != nullptr)
 		return r;
+	GetRangeLimits limits(limit, target_bytes);
+	limits.parallel = mode == FDB_STREAMING_MODE_PARALLEL;
 	return (
 	    FDBFuture*)(TXN(tr)
 	                    ->getRange(
 	                        KeySelectorRef(KeyRef(begin_key_name, begin_key_name_length), begin_or_equal, begin_offset),
 	                        KeySelectorRef(KeyRef(end_key_name, end_key_name_length), end_or_equal, end_offset),
-	                        GetRangeLimits(limit, target_bytes),
+	                        limits,
 	                        snapshot,
 	                        reverse)
 	                    .extractPtr());
@@ -730,6 +752,10 @@ extern "C" DLLEXPORT void fdb_transaction_set(FDBTransaction* tr,
 	CATCH_AND_DIE(TXN(tr)->set(KeyRef(key_name, key_name_length), ValueRef(value, value_length)););
 }
 
+extern "C" DLLEXPORT void fdb_transaction_set_multiple(FDBTransaction* tr, FDBKeyValue const* key_values, int count) {
+	CATCH_AND_DIE(TXN(tr)->setMultiple(VectorRef<KeyValueRef>((KeyValueRef*)key_values, count)););
+}
+
 extern "C" DLLEXPORT void fdb_transaction_atomic_op(FDBTransaction* tr,
                                                     uint8_t const* key_name,
                                                     int key_name_length,
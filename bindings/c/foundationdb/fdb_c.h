@@ -417,6 +417,14 @@ DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_database_get_server_protocol(FDBData
 
 DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_database_get_client_status(FDBDatabase* db);
 
+#if FDB_API_VERSION >= 800
+DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_database_warm_location_cache(FDBDatabase* db,
+                                                                         uint8_t const* begin_key_name,
+                                                                         int begin_key_name_length,
+                                                                         uint8_t const* end_key_name,
+                                                                         int end_key_name_length);
+#endif
+
 DLLEXPORT void fdb_transaction_destroy(FDBTransaction* tr);
 
 DLLEXPORT void fdb_transaction_cancel(FDBTransaction* tr);
@@ -439,6 +447,13 @@ DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_transaction_get(FDBTransaction* tr,
                                                             fdb_bool_t snapshot);
 #endif
 
+#if FDB_API_VERSION >= 800
+DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_transaction_get_multiple(FDBTransaction* tr,
+                                                                     FDBKey const* keys,
+                                                                     int count,
+                                                                     fdb_bool_t snapshot);
+#endif
+
 #if FDB_API_VERSION >= 14
 DLLEXPORT WARN_UNUSED_RESULT FDBFuture* fdb_transaction_get_key(FDBTransaction* tr,
                                                                 uint8_t const* key_name,
@@ -494,6 +509,10 @@ DLLEXPORT void fdb_transaction_set(FDBTransaction* tr,
                                    uint8_t const* value,
                                    int value_length);
 
+#if FDB_API_VERSION >= 800
+DLLEXPORT void fdb_transaction_set_multiple(FDBTransaction* tr, FDBKeyValue const* key_values, int count);
+#endif
+
 DLLEXPORT void fdb_transaction_atomic_op(FDBTransaction* tr,
                                          uint8_t const* key_name,
                                          int key_name_length,
@@ -242,6 +242,7 @@ class ClientConfigTest:
             "StorageServers",
             "Connections",
             "NumConnectionsFailed",
+            "LocationCache",
         }
         db_status = self.status_json["DatabaseStatus"]
         self.tc.assertEqual(expected_db_attributes, set(db_status.keys()))
@@ -124,6 +124,7 @@ repeat_immediate_steps:
 		f.then([this, state = shared_from_this()](Future f) {
 			if (auto postStepFn = opTable[iter.op].postStepFunction(iter.step))
 				postStepFn(f, tx, args, key1, key2, val);
+			stats.addBytesRead(iter.op, rangeReadBytes(iter.op, f));
 			if (iter.stepKind() != StepKind::ON_ERROR) {
 				if (auto err = f.error()) {
 					logr.printWithLogLevel(isExpectedError(err) ? VERBOSE_WARN : VERBOSE_NONE,
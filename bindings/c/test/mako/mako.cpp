@@ -287,6 +287,7 @@ transaction_begin:
 		}
 		if (auto postStepFn = opTable[op].postStepFunction(step))
 			postStepFn(f, tx, args, key1, key2, val);
+		stats.addBytesRead(op, rangeReadBytes(op, f));
 		watch_step.stop();
 		if (future_rc != FutureRC::OK) {
 			if (future_rc == FutureRC::ABORT) {
@@ -1118,7 +1119,7 @@ void usage() {
 	       "Specify the prefix of transaction tag - mako${txntagging_prefix} (Default: '')");
 	printf("%-24s %s\n", "    --knobs=KNOBS", "Set client knobs");
 	printf("%-24s %s\n", "    --flatbuffers", "Use flatbuffers");
-	printf("%-24s %s\n", "    --streaming", "Streaming mode: all (default), iterator, small, medium, large, serial");
+	printf("%-24s %s\n", "    --streaming", "Streaming mode: all (default), iterator, small, medium, large, serial, parallel");
 	printf("%-24s %s\n", "    --disable_ryw", "Disable snapshot read-your-writes");
 	printf(
 	    "%-24s %s\n", "    --disable_client_bypass", "Disable client-bypass forcing mako to use multi-version client");
@@ -1383,6 +1384,8 @@ int parseArguments(int argc, char* argv[], Arguments& args) {
 				args.streaming_mode = FDB_STREAMING_MODE_LARGE;
 			} else if (strncmp(optarg, "serial", 6) == 0) {
 				args.streaming_mode = FDB_STREAMING_MODE_SERIAL;
+			} else if (strncmp(optarg, "parallel", 8) == 0) {
+				args.streaming_mode = FDB_STREAMING_MODE_PARALLEL;
 			} else {
 				logr.error("Invalid streaming mode {}", optarg);
 				return -1;
@@ -2200,6 +2203,29 @@ void printReport(Arguments const& args,
 		}
 	}
 
+	fmt::print("\n");
+
+	/* Bytes read per second */
+	if (fp) {
+		fmt::fprintf(fp, "}, \"bytesReadPerSec\": {");
+	}
+	putTitle("Bytes/s");
+	first_op = true;
+	for (auto op = 0; op < MAX_OP; op++) {
+		if ((args.txnspec.ops[op][OP_COUNT] > 0 && op != OP_TRANSACTION) || op == OP_COMMIT) {
+			const auto bytes_rate = measured_worker_stats.getBytesRead(op) / measurement_duration_sec;
+			putFieldFloat(bytes_rate, 2);
+			if (fp) {
+				if (first_op) {
+					first_op = false;
+				} else {
+					fmt::fprintf(fp, ",");
+				}
+				fmt::fprintf(fp, "\"%s\": %.2f", getOpName(op), bytes_rate);
+			}
+		}
+	}
+
 	if (fp) {
 		fmt::fprintf(fp, "}, \"numSamples\": {");
 	}
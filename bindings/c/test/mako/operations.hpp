@@ -121,6 +121,17 @@ force_inline OpIterator getOpBegin(Arguments const& args) noexcept {
 	return OpEnd;
 }
 
+// Key and value bytes returned by a successful GETRANGE or SGETRANGE step, 0 for other ops
+force_inline uint64_t rangeReadBytes(int op, fdb::Future& f) {
+	if ((op != OP_GETRANGE && op != OP_SGETRANGE) || !f || f.error())
+		return 0;
+	auto [kvs, count, more] = f.get<fdb::future_var::KeyValueRefArray>();
+	auto bytes = uint64_t{};
+	for (auto i = 0; i < count; i++)
+		bytes += kvs[i].key_length + kvs[i].value_length;
+	return bytes;
+}
+
 force_inline OpIterator getOpNext(Arguments const& args, OpIterator current) noexcept {
 	auto& [op, count, step] = current;
 	assert(op < MAX_OP && !isAbstractOp(op));
@@ -99,6 +99,7 @@ class alignas(64) WorkflowStatistics {
 	std::array<uint64_t, MAX_OP> timeouts;
 	std::array<uint64_t, MAX_OP> latency_samples;
 	std::array<uint64_t, MAX_OP> latency_us_total;
+	std::array<uint64_t, MAX_OP> bytes_read;
 	std::vector<DDSketchMako> sketches;
 
 public:
@@ -108,6 +109,7 @@ public:
 		std::fill(timeouts.begin(), timeouts.end(), 0);
 		std::fill(latency_samples.begin(), latency_samples.end(), 0);
 		std::fill(latency_us_total.begin(), latency_us_total.end(), 0);
+		std::fill(bytes_read.begin(), bytes_read.end(), 0);
 		sketches.resize(MAX_OP);
 	}
 
@@ -130,6 +132,8 @@ public:
 
 	uint64_t getLatencyUsTotal(int op) const noexcept { return latency_us_total[op]; }
 
+	uint64_t getBytesRead(int op) const noexcept { return bytes_read[op]; }
+
 	uint64_t getLatencyUsMin(int op) const noexcept { return sketches[op].min(); }
 
 	uint64_t getLatencyUsMax(int op) const noexcept { return sketches[op].max(); }
@@ -150,6 +154,7 @@ public:
 			total_timeouts += other.timeouts[op];
 			latency_samples[op] += other.latency_samples[op];
 			latency_us_total[op] += other.latency_us_total[op];
+			bytes_read[op] += other.bytes_read[op];
 		}
 	}
 
@@ -168,6 +173,8 @@ public:
 		timeouts[op]++;
 	}
 
+	void addBytesRead(int op, uint64_t bytes) noexcept { bytes_read[op] += bytes; }
+
 	void addLatency(int op, timediff_t diff) noexcept {
 		const auto latency_us = toIntegerMicroseconds(diff);
 		latency_samples[op]++;
@@ -186,9 +193,11 @@ public:
 			assert(ops[op] >= baseline.ops[op]);
 			assert(errors[op] >= baseline.errors[op]);
 			assert(timeouts[op] >= baseline.timeouts[op]);
+			assert(bytes_read[op] >= baseline.bytes_read[op]);
 			ops[op] -= baseline.ops[op];
 			errors[op] -= baseline.errors[op];
 			timeouts[op] -= baseline.timeouts[op];
+			bytes_read[op] -= baseline.bytes_read[op];
 		}
 	}
 
@@ -252,6 +261,13 @@ inline std::ofstream& operator<<(std::ofstream& os, WorkflowStatistics& stats) {
 	}
 	writer.EndArray();
 
+	writer.String("bytes_read");
+	writer.StartArray();
+	for (auto op = 0; op < MAX_OP; op++) {
+		writer.Uint64(stats.bytes_read[op]);
+	}
+	writer.EndArray();
+
 	for (auto op = 0; op < MAX_OP; op++) {
 		if (stats.sketches[op].getPopulationSize() > 0) {
 			std::string op_name = getOpName(op);
@@ -293,6 +309,10 @@ inline std::ifstream& operator>>(std::ifstream& is, WorkflowStatistics& stats) {
 	populateArray(stats.timeouts, jsonTimeouts);
 	populateArray(stats.latency_samples, jsonLatencySamples);
 	populateArray(stats.latency_us_total, jsonLatencyUsTotal);
+	if (doc.HasMember("bytes_read")) {
+		auto jsonBytesRead = doc["bytes_read"].GetArray();
+		populateArray(stats.bytes_read, jsonBytesRead);
+	}
 	for (int op = 0; op < MAX_OP; op++) {
 		const std::string op_name = getOpName(op);
 		stats.sketches[op].deserialize(doc[op_name.c_str()]);
@@ -188,6 +188,14 @@ ValueFuture Transaction::get(std::string_view key, fdb_bool_t snapshot) {
 	return ValueFuture(fdb_transaction_get(tr_, (const uint8_t*)key.data(), key.size(), snapshot));
 }
 
+KeyValueArrayFuture Transaction::get_multiple(const std::vector<std::string>& keys, fdb_bool_t snapshot) {
+	std::vector<FDBKey> fdb_keys;
+	for (const auto& key : keys) {
+		fdb_keys.push_back(FDBKey{ (const uint8_t*)key.data(), (int)key.size() });
+	}
+	return KeyValueArrayFuture(fdb_transaction_get_multiple(tr_, fdb_keys.data(), fdb_keys.size(), snapshot));
+}
+
 KeyFuture Transaction::get_key(const uint8_t* key_name,
                                int key_name_length,
                                fdb_bool_t or_equal,
@@ -291,6 +299,15 @@ void Transaction::set(std::string_view key, std::string_view value) {
 	fdb_transaction_set(tr_, (const uint8_t*)key.data(), key.size(), (const uint8_t*)value.data(), value.size());
 }
 
+void Transaction::set_multiple(const std::vector<std::pair<std::string, std::string>>& key_values) {
+	std::vector<FDBKeyValue> kvs;
+	for (const auto& [key, value] : key_values) {
+		kvs.push_back(FDBKeyValue{
+		    (const uint8_t*)key.data(), (int)key.size(), (const uint8_t*)value.data(), (int)value.size() });
+	}
+	fdb_transaction_set_multiple(tr_, kvs.data(), kvs.size());
+}
+
 void Transaction::atomic_op(std::string_view key,
                             const uint8_t* param,
                             int param_length,
@@ -44,6 +44,7 @@
 
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace fdb {
 
@@ -256,6 +257,10 @@ public:
 	// Returns a future which will be set to the value of `key` in the database.
 	ValueFuture get(std::string_view key, fdb_bool_t snapshot);
 
+	// Returns a future which will be set to an FDBKeyValue array holding the
+	// present keys of `keys` and their values.
+	KeyValueArrayFuture get_multiple(const std::vector<std::string>& keys, fdb_bool_t snapshot);
+
 	// Returns a future which will be set to the key in the database matching the
 	// passed key selector.
 	KeyFuture get_key(const uint8_t* key_name,
@@ -323,6 +328,9 @@ public:
 	// Wrapper around fdb_transaction_set.
 	void set(std::string_view key, std::string_view value);
 
+	// Wrapper around fdb_transaction_set_multiple.
+	void set_multiple(const std::vector<std::pair<std::string, std::string>>& key_values);
+
 	// Wrapper around fdb_transaction_atomic_op.
 	void atomic_op(std::string_view key, const uint8_t* param, int param_length, FDBMutationType operationType);
 
@@ -1290,6 +1290,55 @@ TEST_CASE("fdb_transaction_get_range FDB_STREAMING_MODE_EXACT") {
 	}
 }
 
+TEST_CASE("fdb_transaction_get_range FDB_STREAMING_MODE_PARALLEL") {
+	std::map<std::string, std::string> input;
+	for (int i = 0; i < 1000; i++) {
+		input[format("%04d", i)] = std::string(200, 'a' + i % 26);
+	}
+	std::map<std::string, std::string> data = create_data(std::move(input));
+	insert_data(db, data);
+
+	fdb::Transaction tr(db);
+	std::string begin = key("0000");
+	std::string end = key("9999");
+	std::vector<std::pair<std::string, std::string>> kvs;
+	while (1) {
+		// Small byte targets make the reads continue across calls and within shards
+		auto result = get_range(tr,
+		                        FDB_KEYSEL_FIRST_GREATER_OR_EQUAL((const uint8_t*)begin.c_str(), begin.size()),
+		                        FDB_KEYSEL_FIRST_GREATER_OR_EQUAL((const uint8_t*)end.c_str(), end.size()),
+		                        /* limit */ 0,
+		                        /* target_bytes */ 50000,
+		                        /* FDBStreamingMode */ FDB_STREAMING_MODE_PARALLEL,
+		                        /* iteration */ 0,
+		                        /* snapshot */ false,
+		                        /* reverse */ 0);
+
+		if (result.err) {
+			fdb::EmptyFuture f1 = tr.on_error(result.err);
+			fdb_check(wait_future(f1));
+			begin = key("0000");
+			kvs.clear();
+			continue;
+		}
+
+		kvs.insert(kvs.end(), result.kvs.begin(), result.kvs.end());
+		if (!result.more) {
+			break;
+		}
+		CHECK(result.kvs.size() > 0);
+		begin = result.kvs.back().first + '\x00';
+	}
+
+	CHECK(kvs.size() == data.size());
+	auto it = data.begin();
+	for (const auto& kv : kvs) {
+		CHECK(kv.first == it->first);
+		CHECK(kv.second == it->second);
+		++it;
+	}
+}
+
 TEST_CASE("fdb_transaction_clear") {
 	insert_data(db, create_data({ { "foo", "bar" } }));
 
@@ -1311,6 +1360,55 @@ TEST_CASE("fdb_transaction_clear") {
 	REQUIRE(!value.has_value());
 }
 
+TEST_CASE("fdb_transaction_set_multiple and fdb_transaction_get_multiple") {
+	clear_data(db);
+
+	fdb::Transaction tr(db);
+	while (1) {
+		tr.set_multiple({ { key("a"), "1" }, { key("b"), "" }, { key("c"), "3" } });
+		fdb::EmptyFuture f1 = tr.commit();
+
+		fdb_error_t err = wait_future(f1);
+		if (err) {
+			fdb::EmptyFuture f2 = tr.on_error(err);
+			fdb_check(wait_future(f2));
+			continue;
+		}
+		break;
+	}
+
+	tr.reset();
+	while (1) {
+		// Includes a write in the same transaction, a missing key, an empty value and a repeated key
+		tr.set(key("d"), "4");
+		fdb::KeyValueArrayFuture f1 =
+		    tr.get_multiple({ key("c"), key("missing"), key("a"), key("b"), key("d"), key("c") }, /* snapshot */ false);
+
+		fdb_error_t err = wait_future(f1);
+		if (err) {
+			fdb::EmptyFuture f2 = tr.on_error(err);
+			fdb_check(wait_future(f2));
+			continue;
+		}
+
+		FDBKeyValue const* out_kv;
+		int out_count;
+		int out_more;
+		fdb_check(f1.get(&out_kv, &out_count, &out_more));
+
+		std::vector<std::pair<std::string, std::string>> expected = {
+			{ key("c"), "3" }, { key("a"), "1" }, { key("b"), "" }, { key("d"), "4" }, { key("c"), "3" }
+		};
+		CHECK(!out_more);
+		REQUIRE(out_count == (int)expected.size());
+		for (int i = 0; i < out_count; ++i) {
+			CHECK(std::string((const char*)out_kv[i].key, out_kv[i].key_length) == expected[i].first);
+			CHECK(std::string((const char*)out_kv[i].value, out_kv[i].value_length) == expected[i].second);
+		}
+		break;
+	}
+}
+
 TEST_CASE("fdb_transaction_atomic_op FDB_MUTATION_TYPE_ADD") {
 	insert_data(db, create_data({ { "foo", "\x00" } }));
 
@@ -1970,6 +2068,21 @@ TEST_CASE("fdb_database_get_server_protocol") {
 	fdb_future_destroy(protocolFuture);
 }
 
+TEST_CASE("fdb_database_warm_location_cache") {
+	insert_data(db, create_data({ { "a", "1" }, { "b", "2" }, { "c", "3" } }));
+	std::string begin = key("a");
+	std::string end = key("d");
+
+	// The second call finds every shard of the range already cached
+	for (int i = 0; i < 2; i++) {
+		FDBFuture* f = fdb_database_warm_location_cache(
+		    db, (const uint8_t*)begin.c_str(), begin.size(), (const uint8_t*)end.c_str(), end.size());
+		fdb_check(fdb_future_block_until_ready(f));
+		fdb_check(fdb_future_get_error(f));
+		fdb_future_destroy(f);
+	}
+}
+
 TEST_CASE("fdb_transaction_watch read_your_writes_disable") {
 	// Watches created on a transaction with the option READ_YOUR_WRITES_DISABLE
 	// should return a watches_disabled error.
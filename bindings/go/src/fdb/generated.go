@@ -348,6 +348,13 @@ func (o DatabaseOptions) SetLocationCacheSize(param int64) error {
 	return o.setOpt(10, int64ToBytes(param))
 }
 
+// Restore the client location cache from this file when it was written for the same cluster, and periodically save the location cache to it. This lets a restarting client skip fetching shard locations from the commit proxies on its first reads.
+//
+// Parameter: Path to the location cache snapshot file
+func (o DatabaseOptions) SetLocationCacheSnapshotFile(param string) error {
+	return o.setOpt(11, []byte(param))
+}
+
 // Set the maximum number of watches allowed to be outstanding on a database connection. Increasing this number could result in increased resource usage. Reducing this number will not cancel any outstanding watches. Defaults to 10000 and cannot be larger than 1000000.
 //
 // Parameter: Max outstanding watches
@@ -775,6 +782,13 @@ const (
 	// get reasonable read bandwidth from the database. If the client stops
 	// iteration early, considerable disk and network bandwidth may be wasted.
 	StreamingModeSerial StreamingMode = 5
+
+	// Transfer data in batches larger than “SERIAL“, reading several shards
+	// of the range from the storage servers concurrently. Results are still
+	// delivered in key order. Intended for scanning ranges that span many
+	// shards. Reverse range reads and key selectors with offsets are read one
+	// shard at a time as in “SERIAL“.
+	StreamingModeParallel StreamingMode = 6
 )
 
 // Performs an addition of little-endian integers. If the existing value in the database is not present or shorter than ``param``, it is first extended to the length of ``param`` with zero bytes.  If ``param`` is shorter than the existing value in the database, the existing value is truncated to match the length of ``param``. The integers to be added must be stored in a little-endian representation.  They can be signed in two's complement representation or unsigned. You can add to an integer at a known offset in the value by prepending the appropriate number of zero bytes to ``param`` and padding with zero bytes to match the length of the value. However, this offset technique requires that you know the addition will not cause the integer field within the value to overflow.
@@ -176,9 +176,11 @@ struct MutationFilesReadProgress : public ReferenceCounted<MutationFilesReadProg
 			Version msgVersion = invalidVersion;
 
 			try {
-				// Read block header
-				if (reader.consume<int32_t>() != PARTITIONED_MLOG_VERSION)
-					throw restore_unsupported_file_version();
+				// Read block header, decompressing the messages of compressed blocks
+				Arena arena;
+				arena.dependsOn(buf.arena());
+				reader = StringRefReader(fileBackup::decodePartitionedLogFileBlock(block, arena),
+				                         restore_corrupted_data());
 
 				while (1) {
 					// If eof reached or first key len bytes is 0xFF then end of block was reached.
@@ -191,8 +193,7 @@ struct MutationFilesReadProgress : public ReferenceCounted<MutationFilesReadProg
 					int msgSize = bigEndian32(reader.consume<int>());
 					const uint8_t* message = reader.consume(msgSize);
 
-					ArenaReader rd(
-					    buf.arena(), StringRef(message, msgSize), AssumeVersion(g_network->protocolVersion()));
+					ArenaReader rd(arena, StringRef(message, msgSize), AssumeVersion(g_network->protocolVersion()));
 					MutationRef m;
 					rd >> m;
 					count++;
@@ -205,8 +206,7 @@ struct MutationFilesReadProgress : public ReferenceCounted<MutationFilesReadProg
 						break; // skip
 					}
 					if (msgVersion >= minVersion) {
-						mutations.emplace_back(
-						    LogMessageVersion(msgVersion, sub), StringRef(message, msgSize), buf.arena());
+						mutations.emplace_back(LogMessageVersion(msgVersion, sub), StringRef(message, msgSize), arena);
 						inserted++;
 					}
 				}
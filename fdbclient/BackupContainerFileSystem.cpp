@@ -105,6 +105,29 @@ public:
 			throw restore_missing_data();
 		}
 
+		// The files of an incremental snapshot combine files written for it with unmodified files carried over from
+		// its base snapshot. Both are listed in "files", check that the combination is complete.
+		std::string baseSnapshot;
+		if (doc.tryGet("baseSnapshot", baseSnapshot)) {
+			json_spirit::mValue& reusedArray = doc.create("reusedFiles");
+			if (reusedArray.type() != json_spirit::array_type)
+				throw restore_corrupted_data();
+			std::set<std::string> listed;
+			for (const auto& f : results) {
+				listed.insert(f.fileName);
+			}
+			for (auto const& fileValue : reusedArray.get_array()) {
+				if (fileValue.type() != json_spirit::str_type || !listed.contains(fileValue.get_str()))
+					throw restore_corrupted_data();
+			}
+			TraceEvent("BackupContainerIncrementalSnapshot")
+			    .detail("URL", bc->getURL())
+			    .detail("Snapshot", snapshot.fileName)
+			    .detail("BaseSnapshot", baseSnapshot)
+			    .detail("Files", results.size())
+			    .detail("ReusedFiles", reusedArray.get_array().size());
+		}
+
 		// Check key ranges for files
 		std::map<std::string, KeyRange> fileKeyRanges;
 		JSONDoc ranges = doc.subDoc("keyRanges"); // Create an empty doc if not existed
@@ -194,6 +217,12 @@ public:
 					throw restore_unknown_file_type();
 				co_await yield();
 			}
+
+			// Every range in an incremental snapshot is unchanged between its file's version and the snapshot
+			// version, so the snapshot ends there even if all of its files were reused from the base snapshot.
+			if (metadata.present() && metadata.get().isIncremental() && metadata.get().snapshotVersion > maxVer) {
+				maxVer = metadata.get().snapshotVersion;
+			}
 		}
 
 		json_spirit::mValue json;
@@ -228,6 +257,18 @@ public:
 			}
 		}
 
+		// An incremental snapshot still lists every file it needs, reused or not, so readers that don't know about
+		// incremental snapshots restore it correctly. The extra fields only record where the reused files came from.
+		if (metadata.present() && metadata.get().isIncremental()) {
+			json_spirit::mArray reusedArray;
+			for (const auto& f : metadata.get().reusedFiles) {
+				reusedArray.push_back(f);
+			}
+			doc.create("snapshotType") = metadata.get().snapshotType;
+			doc.create("baseSnapshot") = metadata.get().baseSnapshot;
+			doc.create("reusedFiles") = std::move(reusedArray);
+		}
+
 		co_await yield();
 		std::string docString = json_spirit::write_string(json);
 
@@ -2633,4 +2674,209 @@ TEST_CASE("/backup/containers/localdir/continuousLogEndVersion") {
 	    format("file://%s/fdb_backups/%llx", params.getDataDir().c_str(), timer_int()), Optional<std::string>());
 }
 
+// Writes a full snapshot, then an incremental snapshot rewriting one of its ranges and one reusing all of them, and
+// checks that restores from the incremental snapshots get the base files they reuse.
+Future<Void> testIncrementalSnapshots(std::string url) {
+	FlowLock lock(100e6);
+	printf("BackupContainerTest URL %s\n", url.c_str());
+
+	Reference<IBackupContainer> c = IBackupContainer::openContainer(url, {}, {});
+	try {
+		co_await c->deleteContainer();
+	} catch (Error& e) {
+		if (e.code() != error_code_backup_invalid_url && e.code() != error_code_backup_does_not_exist)
+			throw;
+	}
+	co_await c->create();
+
+	std::vector<std::pair<Key, Key>> beginEndKeys = { { "a"_sr, "b"_sr }, { "b"_sr, "c"_sr }, { "c"_sr, "d"_sr } };
+	int blockSize = 1024;
+	Version v = deterministicRandom()->randomInt64(0, std::numeric_limits<Version>::max() / 2);
+	Version logStart = v;
+	std::vector<Future<Void>> writes;
+
+	// Full snapshot
+	std::vector<std::string> baseFiles;
+	for (int i = 0; i < beginEndKeys.size(); ++i) {
+		Reference<IBackupFile> range = co_await c->writeRangeFile(v, 0, v, blockSize);
+		writes.push_back(writeAndVerifyFile(c, range, deterministicRandom()->randomInt(0, 1e5), &lock));
+		baseFiles.push_back(range->getFileName());
+		v = nextVersion(v);
+	}
+	co_await waitForAll(writes);
+	co_await c->writeKeyspaceSnapshotFile(baseFiles, beginEndKeys, 0, IncludeKeyRangeMap::True);
+	BackupFileList listing = co_await c->dumpFileList();
+	ASSERT_EQ(listing.snapshots.size(), 1);
+	std::string baseSnapshot = listing.snapshots[0].fileName;
+
+	// Only the last range changed
+	Version incrementalBegin = v;
+	v = nextVersion(v);
+	Reference<IBackupFile> rewritten = co_await c->writeRangeFile(incrementalBegin, 0, v, blockSize);
+	co_await writeAndVerifyFile(c, rewritten, deterministicRandom()->randomInt(0, 1e5), &lock);
+	std::vector<std::string> incrementalFiles = { baseFiles[0], baseFiles[1], rewritten->getFileName() };
+	co_await c->writeKeyspaceSnapshotFile(
+	    incrementalFiles,
+	    beginEndKeys,
+	    0,
+	    IncludeKeyRangeMap::True,
+	    SnapshotMetadata::incremental(baseSnapshot, { baseFiles[0], baseFiles[1] }, incrementalBegin));
+	Version incrementalEnd = v;
+	listing = co_await c->dumpFileList();
+	ASSERT_EQ(listing.snapshots.size(), 2);
+	ASSERT_EQ(listing.snapshots[1].endVersion, incrementalEnd);
+
+	// Nothing changed, the snapshot ends at its begin version
+	v = nextVersion(v);
+	Version unchangedBegin = v;
+	co_await c->writeKeyspaceSnapshotFile(
+	    incrementalFiles,
+	    beginEndKeys,
+	    0,
+	    IncludeKeyRangeMap::True,
+	    SnapshotMetadata::incremental(listing.snapshots[1].fileName, incrementalFiles, unchangedBegin));
+
+	// Continuous logs through all snapshots
+	v = nextVersion(v);
+	while (logStart < v) {
+		Version logEnd = nextVersion(logStart);
+		Reference<IBackupFile> log = co_await c->writeLogFile(logStart, logEnd, blockSize);
+		co_await writeAndVerifyFile(c, log, deterministicRandom()->randomInt(0, 1e5), &lock);
+		logStart = logEnd;
+	}
+
+	listing = co_await c->dumpFileList();
+	printFileList(listing);
+	ASSERT_EQ(listing.snapshots.size(), 3);
+
+	std::set<std::string> expected(incrementalFiles.begin(), incrementalFiles.end());
+	std::vector<Version> targets = { incrementalEnd, unchangedBegin };
+	for (Version target : targets) {
+		Optional<RestorableFileSet> rest = co_await c->getRestoreSet(target);
+		ASSERT(rest.present());
+		ASSERT_EQ(rest.get().snapshot.endVersion, target);
+		// Reused files are older than the snapshot, so logs are needed from the oldest of them
+		ASSERT_EQ(rest.get().snapshot.beginVersion, listing.snapshots[0].beginVersion);
+		std::set<std::string> restored;
+		for (const auto& f : rest.get().ranges) {
+			restored.insert(f.fileName);
+		}
+		ASSERT(restored == expected);
+		ASSERT_EQ(rest.get().keyRanges.size(), beginEndKeys.size());
+	}
+
+	co_await c->deleteContainer();
+	printf("BackupContainerTest URL=%s PASSED.\n", url.c_str());
+}
+
+TEST_CASE("/backup/containers/localdir/incrementalSnapshots") {
+	co_await testIncrementalSnapshots(format("file://%s/fdb_backups/%llx", params.getDataDir().c_str(), timer_int()));
+}
+
+Future<std::string> writeRangeFileForTest(Reference<IBackupContainer> c, Version version, FlowLock* lock) {
+	Reference<IBackupFile> range = co_await c->writeRangeFile(version, 0, version, 1024);
+	co_await writeAndVerifyFile(c, range, deterministicRandom()->randomInt(0, 1e5), lock);
+	co_return range->getFileName();
+}
+
+// Writes a full snapshot and two incremental snapshots the way the backup agent does, each carrying over only files its
+// base wrote itself, and checks that data can be expired up to the begin version of the last one without force.
+Future<Void> testExpireIncrementalSnapshots(std::string url) {
+	FlowLock lock(100e6);
+	printf("BackupContainerTest URL %s\n", url.c_str());
+
+	Reference<IBackupContainer> c = IBackupContainer::openContainer(url, {}, {});
+	try {
+		co_await c->deleteContainer();
+	} catch (Error& e) {
+		if (e.code() != error_code_backup_invalid_url && e.code() != error_code_backup_does_not_exist)
+			throw;
+	}
+	co_await c->create();
+
+	std::vector<std::pair<Key, Key>> beginEndKeys = { { "a"_sr, "b"_sr }, { "b"_sr, "c"_sr }, { "c"_sr, "d"_sr } };
+	Version v = deterministicRandom()->randomInt64(0, std::numeric_limits<Version>::max() / 2);
+	Version logStart = v;
+
+	// Full snapshot
+	std::vector<std::string> baseFiles;
+	for (int i = 0; i < beginEndKeys.size(); ++i) {
+		baseFiles.push_back(co_await writeRangeFileForTest(c, v, &lock));
+		v = nextVersion(v);
+	}
+	co_await c->writeKeyspaceSnapshotFile(baseFiles, beginEndKeys, 0, IncludeKeyRangeMap::True);
+	BackupFileList listing = co_await c->dumpFileList();
+	ASSERT_EQ(listing.snapshots.size(), 1);
+
+	// The last range changed, the others are carried over from the full snapshot
+	Version firstBegin = v;
+	std::string rewritten = co_await writeRangeFileForTest(c, firstBegin, &lock);
+	co_await c->writeKeyspaceSnapshotFile(
+	    { baseFiles[0], baseFiles[1], rewritten },
+	    beginEndKeys,
+	    0,
+	    IncludeKeyRangeMap::True,
+	    SnapshotMetadata::incremental(listing.snapshots[0].fileName, { baseFiles[0], baseFiles[1] }, firstBegin));
+	listing = co_await c->dumpFileList();
+	ASSERT_EQ(listing.snapshots.size(), 2);
+	std::string firstIncremental = listing.snapshots[1].fileName;
+
+	// Nothing changed, but only the file written by the previous snapshot may be carried over again
+	v = nextVersion(v);
+	Version secondBegin = v;
+	std::vector<std::string> secondFiles;
+	secondFiles.push_back(co_await writeRangeFileForTest(c, secondBegin, &lock));
+	v = nextVersion(v);
+	secondFiles.push_back(co_await writeRangeFileForTest(c, v, &lock));
+	secondFiles.push_back(rewritten);
+	co_await c->writeKeyspaceSnapshotFile(secondFiles,
+	                                      beginEndKeys,
+	                                      0,
+	                                      IncludeKeyRangeMap::True,
+	                                      SnapshotMetadata::incremental(firstIncremental, { rewritten }, secondBegin));
+
+	// Continuous logs through all snapshots
+	v = nextVersion(v);
+	while (logStart < v) {
+		Version logEnd = nextVersion(logStart);
+		Reference<IBackupFile> log = co_await c->writeLogFile(logStart, logEnd, 1024);
+		co_await writeAndVerifyFile(c, log, deterministicRandom()->randomInt(0, 1e5), &lock);
+		logStart = logEnd;
+	}
+
+	listing = co_await c->dumpFileList();
+	printFileList(listing);
+	ASSERT_EQ(listing.snapshots.size(), 3);
+	KeyspaceSnapshotFile last = listing.snapshots.back();
+	ASSERT_EQ(last.beginVersion, firstBegin);
+
+	// The last snapshot begins at the file it carried over, so that is as far as data can be expired
+	Future<Void> f = c->expireData(last.beginVersion + 1);
+	co_await ready(f);
+	ASSERT(f.isError() && f.getError().code() == error_code_backup_cannot_expire);
+	co_await c->expireData(last.beginVersion);
+
+	BackupDescription desc = co_await c->describeBackup();
+	printf("\n%s\n", desc.toString().c_str());
+	// The expire end moves back to the begin of the log file containing it
+	ASSERT(desc.expiredEndVersion.present() && desc.expiredEndVersion.get() <= last.beginVersion);
+
+	Optional<RestorableFileSet> rest = co_await c->getRestoreSet(last.endVersion);
+	ASSERT(rest.present());
+	ASSERT_EQ(rest.get().snapshot.fileName, last.fileName);
+	std::set<std::string> restored;
+	for (const auto& file : rest.get().ranges) {
+		restored.insert(file.fileName);
+	}
+	ASSERT(restored == std::set<std::string>(secondFiles.begin(), secondFiles.end()));
+
+	co_await c->deleteContainer();
+	printf("BackupContainerTest URL=%s PASSED.\n", url.c_str());
+}
+
+TEST_CASE("/backup/containers/localdir/expireIncrementalSnapshots") {
+	co_await testExpireIncrementalSnapshots(
+	    format("file://%s/fdb_backups/%llx", params.getDataDir().c_str(), timer_int()));
+}
+
 } // namespace backup_test
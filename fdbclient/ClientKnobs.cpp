@@ -202,9 +202,11 @@ void ClientKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( LOCATION_CACHE_EVICTION_SIZE_SIM,         10 ); if( randomize && BUGGIFY ) LOCATION_CACHE_EVICTION_SIZE_SIM = 3;
 	init( LOCATION_CACHE_ENDPOINT_FAILURE_GRACE_PERIOD,     60 );
 	init( LOCATION_CACHE_FAILED_ENDPOINT_RETRY_INTERVAL,    60 );
+	init( LOCATION_CACHE_SNAPSHOT_INTERVAL,                300 ); if( randomize && BUGGIFY ) LOCATION_CACHE_SNAPSHOT_INTERVAL = 5;
 
 	init( GET_RANGE_SHARD_LIMIT,                     2 );
 	init( WARM_RANGE_SHARD_LIMIT,                  100 );
+	init( GET_RANGE_PARALLEL_SHARDS,                 8 ); if( randomize && BUGGIFY ) GET_RANGE_PARALLEL_SHARDS = deterministicRandom()->randomInt(1, 4);
 	init( STORAGE_METRICS_SHARD_LIMIT,             100 ); if( randomize && BUGGIFY ) STORAGE_METRICS_SHARD_LIMIT = 10;
 	init( SHARD_COUNT_LIMIT,                        80 ); if( randomize && BUGGIFY ) SHARD_COUNT_LIMIT = 3;
 	init( STORAGE_METRICS_UNFAIR_SPLIT_LIMIT,  2.0/3.0 );
@@ -287,12 +289,17 @@ void ClientKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( BACKUP_POLL_PROGRESS_SECONDS,             10 );
 	init( SIM_BACKUP_TASKS_PER_AGENT,               10 );
 	init( BACKUP_RANGEFILE_BLOCK_SIZE,      1024 * 1024);
+	init( BACKUP_RANGEFILE_COMPRESSION,          false ); if( randomize && BUGGIFY ) BACKUP_RANGEFILE_COMPRESSION = true;
+	init( BACKUP_INCREMENTAL_SNAPSHOTS,          false ); if( randomize && BUGGIFY ) BACKUP_INCREMENTAL_SNAPSHOTS = true;
+	init( BACKUP_INCREMENTAL_SNAPSHOT_MAX_AGE,  30 * 24 * 3600 ); if( randomize && BUGGIFY ) BACKUP_INCREMENTAL_SNAPSHOT_MAX_AGE = deterministicRandom()->randomInt(10, 1000);
 	init( BACKUP_LOGFILE_BLOCK_SIZE,        1024 * 1024);
 	init( BACKUP_DISPATCH_ADDTASK_SIZE,             50 );
 	init( RESTORE_DISPATCH_ADDTASK_SIZE,           150 );
 	init( RESTORE_DISPATCH_BATCH_SIZE,           30000 ); if( randomize && BUGGIFY ) RESTORE_DISPATCH_BATCH_SIZE = 20;
 	init (RESTORE_PARTITIONED_BATCH_VERSION_SIZE, 10000000); // each step restores 10s worth of data
 	init( RESTORE_WRITE_TX_SIZE,            256 * 1024 );
+	init( RESTORE_LOG_APPLIER_STREAMS,               4 ); if( randomize && BUGGIFY ) RESTORE_LOG_APPLIER_STREAMS = deterministicRandom()->randomInt(1, 10);
+	init( RESTORE_LOG_WRITES_IN_FLIGHT,              4 ); if( randomize && BUGGIFY ) RESTORE_LOG_WRITES_IN_FLIGHT = 1;
 	init( APPLY_MAX_LOCK_BYTES,                    1e9 );
 	init( APPLY_MIN_LOCK_BYTES,                   11e6 ); //Must be bigger than TRANSACTION_SIZE_LIMIT
 	init( APPLY_BLOCK_SIZE,     LOG_RANGE_BLOCK_SIZE/5 );
@@ -349,6 +356,11 @@ void ClientKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( BLOBSTORE_MULTIPART_MIN_PART_SIZE,   5242880 );
 	init( BLOBSTORE_MULTIPART_RETRY_DELAY_MS,     1000 );
 	init( BLOBSTORE_GLOBAL_CONNECTION_POOL,      false );
+	init( BLOBSTORE_MAX_IDLE_CONNECTION_TIME,        0 ); if ( randomize && BUGGIFY ) BLOBSTORE_MAX_IDLE_CONNECTION_TIME = deterministicRandom()->randomInt(1, 30);
+	init( BLOBSTORE_PREWARM_CONNECTIONS,             0 ); if ( randomize && BUGGIFY ) BLOBSTORE_PREWARM_CONNECTIONS = deterministicRandom()->randomInt(1, 8);
+	init( BLOBSTORE_ADAPTIVE_CONCURRENCY,         false ); if ( randomize && BUGGIFY ) BLOBSTORE_ADAPTIVE_CONCURRENCY = deterministicRandom()->coinflip();
+	init( BLOBSTORE_ADAPTIVE_CONCURRENCY_MIN,        2 );
+	init( BLOBSTORE_ADAPTIVE_CONCURRENCY_LATENCY_RATIO, 3.0 );
 	init( BLOBSTORE_ENABLE_LOGGING,               true );
 	init( BLOBSTORE_STATS_LOGGING_INTERVAL,       10.0 );
 	init( BLOBSTORE_LATENCY_LOGGING_INTERVAL,    120.0 );
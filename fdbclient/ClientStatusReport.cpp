@@ -41,6 +41,7 @@ public:
 			reportClientInfo();
 			reportStorageServers();
 			reportConnections();
+			reportLocationCache();
 			statusObj["Healthy"] = healthy;
 		}
 		return StringRef(json_spirit::write_string(json_spirit::mValue(statusObj)));
@@ -106,6 +107,15 @@ private:
 		statusObj["StorageServers"] = storageServerArr;
 	}
 
+	void reportLocationCache() {
+		json_spirit::mObject locationCache;
+		locationCache["Size"] = cx.locationCache.size();
+		locationCache["Hits"] = cx.locationCacheHits.getValue();
+		locationCache["Misses"] = cx.locationCacheMisses.getValue();
+		locationCache["KeyServerLocationRequests"] = cx.transactionKeyServerLocationRequests.getValue();
+		statusObj["LocationCache"] = locationCache;
+	}
+
 	void reportConnections() {
 		json_spirit::mArray connectionArr;
 		for (const auto& addr : serverAddresses) {
@@ -21,6 +21,7 @@
 #include "fdbclient/CommitProxyInterface.h"
 #include "fdbclient/DatabaseConfiguration.h"
 #include "fdbrpc/simulator.h"
+#include "flow/CompressionUtils.h"
 #include "flow/EncryptUtils.h"
 #include "flow/FastRef.h"
 #include "flow/flow.h"
@@ -46,12 +47,14 @@
 #include "fdbclient/TaskBucket.h"
 #include "flow/network.h"
 #include "flow/Trace.h"
+#include "flow/UnitTest.h"
 #include "flow/Util.h"
 
 #include <cinttypes>
 #include <cstdint>
 #include <ctime>
 #include <climits>
+#include <deque>
 #include "flow/IAsyncFile.h"
 #include "flow/genericactors.actor.h"
 #include "flow/Hash3.h"
@@ -688,6 +691,15 @@ public:
 			size = 0;
 		}
 		bool is_valid() { return fetchingData.has_value(); }
+		// Replaces the data, growing the buffer if needed
+		void setData(StringRef contents) {
+			if (contents.size() > capacity) {
+				capacity = contents.size();
+				data = std::shared_ptr<char[]>(new char[capacity]());
+			}
+			std::memcpy(data.get(), contents.begin(), contents.size());
+			size = contents.size();
+		}
 		void reset() {
 			size = 0;
 			index = 0;
@@ -836,6 +848,13 @@ Future<Void> TwoBuffers::readNextBlock(Reference<TwoBuffers> self, int index) {
 	self->buffers[index]->index = self->currentFileIndex;
 	self->buffers[index]->size = bytesRead; // Set to actual bytes read
 	self->currentFilePosition += bytesRead;
+
+	// A compressed block is served as the uncompressed blocks it holds
+	Optional<Standalone<StringRef>> expanded = fileBackup::expandPartitionedLogFileBlock(
+	    StringRef((const uint8_t*)self->buffers[index]->data.get(), bytesRead), self->bufferCapacity);
+	if (expanded.present()) {
+		self->buffers[index]->setData(expanded.get());
+	}
 }
 
 void TwoBuffers::fillBufferIfAbsent(int index) {
@@ -868,6 +887,7 @@ public:
 	std::vector<RestoreConfig::RestoreFile> files;
 	size_t bufferOffset; // Current read offset
 	int bufferSize;
+	size_t bufferAllocated; // Size of buffer, which can exceed bufferCapacity to hold an expanded compressed block
 	int fileOffset;
 	int fileIndex;
 	std::shared_ptr<char[]> buffer;
@@ -901,6 +921,7 @@ PartitionedLogIteratorSimple::PartitionedLogIteratorSimple(Reference<IBackupCont
                                                            std::vector<Version> _endVersions)
   : bc(_bc), tag(_tag), endVersions(_endVersions), files(std::move(_files)), bufferOffset(0) {
 	bufferCapacity = BATCH_READ_BLOCK_COUNT * BLOCK_SIZE;
+	bufferAllocated = bufferCapacity;
 	buffer = std::shared_ptr<char[]>(new char[bufferCapacity]());
 	fileOffset = 0;
 	fileIndex = 0;
@@ -1017,6 +1038,18 @@ Future<Void> PartitionedLogIteratorSimple::loadNextBlock(Reference<PartitionedLo
 	self->bufferSize = bytesRead; // Set to actual bytes read
 	self->bufferOffset = 0; // Reset bufferOffset for the new data
 	self->fileOffset += bytesRead;
+
+	// A compressed block is served as the uncompressed blocks it holds
+	Optional<Standalone<StringRef>> expanded = fileBackup::expandPartitionedLogFileBlock(
+	    StringRef((const uint8_t*)self->buffer.get(), bytesRead), self->BLOCK_SIZE);
+	if (expanded.present()) {
+		if (expanded.get().size() > self->bufferAllocated) {
+			self->bufferAllocated = expanded.get().size();
+			self->buffer = std::shared_ptr<char[]>(new char[self->bufferAllocated]());
+		}
+		std::memcpy(self->buffer.get(), expanded.get().begin(), expanded.get().size());
+		self->bufferSize = expanded.get().size();
+	}
 }
 
 Future<Version> PartitionedLogIteratorSimple::peekNextVersion() {
@@ -1466,6 +1499,212 @@ private:
 	Key lastValue;
 };
 
+// Compressed range file format, BACKUP_AGENT_COMPRESSED_SNAPSHOT_FILE_VERSION.
+//
+// As in the format above every block starts at a block size boundary, so blocks can still be located by offset and
+// decoded independently and in parallel.  Each block is self contained:
+//
+//   int32 version | uint8 compression filter | uint32 raw length | uint32 compressed length | payload | padding
+//
+// and the decompressed payload stores the block column by column so that similar bytes sit next to each other:
+//
+//   uint32 kv count | begin key | kv count + 1 prefix encoded keys (the kv keys, then the end key) | kv values
+//
+// A prefix encoded key is (uint32 bytes shared with the previous key, uint32 suffix length, suffix), and all lengths
+// are in network byte order.  A block's end key is the first key of the next block, so unlike the format above
+// nothing is repeated across block boundaries.  Decoding a block yields the same [begin, kv pairs..., end] vector.
+//
+// CompressedRangeFileWriter is used exactly like RangeFileWriter.  Entries are buffered until enough of them have
+// been seen to fill a block once compressed; the block is then sealed with the largest prefix of the buffered
+// entries that fits, and the remaining entries start the next block.
+struct CompressedRangeFileWriter : public IRangeFileWriter {
+	// Seal a block as soon as its compressed size reaches this fraction of the available space
+	static constexpr double blockFillTarget = 0.9;
+
+	CompressedRangeFileWriter(Reference<IBackupFile> file, int blockSize)
+	  : file(file), blockSize(blockSize), blockEnd(0),
+	    filter(CompressionUtils::supportedFilters.contains(CompressionFilter::ZSTD) ? CompressionFilter::ZSTD
+	                                                                                : CompressionFilter::NONE),
+	    pendingBytes(0), checkBytes(blockSize), compressionRatio(1.0), fittingCount(0), flushed(false) {}
+
+	// Returns the block holding the first count pending entries, header included but without padding.  The block
+	// ends at the next pending key, or at the end key if all pending entries are included.
+	Standalone<StringRef> encodeBlock(int count) const {
+		KeyRef end = count < pending.size() ? pending[count].key : endKey.get();
+		BinaryWriter raw(Unversioned());
+		raw << bigEndian32((uint32_t)count);
+		raw << bigEndian32((uint32_t)beginKey.size());
+		raw.serializeBytes(beginKey);
+		KeyRef prev = beginKey;
+		auto writePrefixEncoded = [&](KeyRef k) {
+			int shared = commonPrefixLength(prev, k);
+			raw << bigEndian32((uint32_t)shared) << bigEndian32((uint32_t)(k.size() - shared));
+			raw.serializeBytes(k.substr(shared));
+			prev = k;
+		};
+		for (int i = 0; i < count; i++) {
+			writePrefixEncoded(pending[i].key);
+		}
+		writePrefixEncoded(end);
+		for (int i = 0; i < count; i++) {
+			raw << bigEndian32((uint32_t)pending[i].value.size());
+			raw.serializeBytes(pending[i].value);
+		}
+
+		Arena arena;
+		StringRef compressed = CompressionUtils::compress(filter, raw.toValue(), arena);
+		BinaryWriter block(Unversioned());
+		block << fileVersion << (uint8_t)filter << bigEndian32((uint32_t)raw.getLength())
+		      << bigEndian32((uint32_t)compressed.size());
+		block.serializeBytes(compressed);
+		return block.toValue();
+	}
+
+	bool fits(const Standalone<StringRef>& block) const { return block.size() <= blockSize; }
+
+	// Returns the largest block, holding between 1 and hi - 1 pending entries, that fits.  hi must be known not to
+	// fit, and fittingCount is a lower bound found by earlier attempts.
+	std::pair<int, Standalone<StringRef>> largestFittingBlock(int hi) const {
+		int lo = std::max(fittingCount, 1);
+		Standalone<StringRef> best;
+		while (hi - lo > 1) {
+			int mid = lo + (hi - lo) / 2;
+			Standalone<StringRef> block = encodeBlock(mid);
+			if (fits(block)) {
+				lo = mid;
+				best = block;
+			} else {
+				hi = mid;
+			}
+		}
+		if (best.empty()) {
+			if (lo >= hi) {
+				throw backup_bad_block_size();
+			}
+			best = encodeBlock(lo);
+			if (!fits(best)) {
+				throw backup_bad_block_size();
+			}
+		}
+		return { lo, best };
+	}
+
+	// Writes a block at the current block boundary, padding it to the next boundary unless it is the last one, and
+	// makes the entries following the first count pending entries the start of the next block.
+	static Future<Void> writeBlock(CompressedRangeFileWriter* self, Standalone<StringRef> block, int count, bool pad) {
+		ASSERT(self->file->size() == self->blockEnd);
+		self->blockEnd += self->blockSize;
+		co_await self->file->append(block.begin(), block.size());
+		if (pad) {
+			int bytesLeft = self->blockEnd - self->file->size();
+			if (bytesLeft > 0) {
+				Value paddingFFs = makePadding(bytesLeft);
+				co_await self->file->append(paddingFFs.begin(), bytesLeft);
+			}
+		}
+
+		if (count < self->pending.size()) {
+			Standalone<VectorRef<KeyValueRef>> rest;
+			rest.append_deep(rest.arena(), self->pending.begin() + count, self->pending.size() - count);
+			self->pending = rest;
+			self->beginKey = Key(self->pending.front().key, self->pending.arena());
+		} else {
+			self->pending = Standalone<VectorRef<KeyValueRef>>();
+		}
+		self->pendingBytes = 0;
+		for (const auto& kv : self->pending) {
+			self->pendingBytes += kv.expectedSize();
+		}
+		self->checkBytes = self->pendingBytes + (int64_t)(self->blockSize * blockFillTarget * self->compressionRatio);
+		self->fittingCount = 0;
+	}
+
+	static Future<Void> writeKV_impl(CompressedRangeFileWriter* self, Key k, Value v) {
+		self->pending.push_back_deep(self->pending.arena(), KeyValueRef(k, v));
+		self->pendingBytes += k.expectedSize() + v.expectedSize();
+		if (self->pendingBytes < self->checkBytes || self->pending.size() < 2) {
+			co_return;
+		}
+
+		// Try a block of everything but the new entry, whose key would end the block
+		int count = self->pending.size() - 1;
+		Standalone<StringRef> block = self->encodeBlock(count);
+		self->compressionRatio = (double)(self->pendingBytes - k.expectedSize() - v.expectedSize()) / block.size();
+		if (!self->fits(block)) {
+			auto [fitting, fittingBlock] = self->largestFittingBlock(count);
+			co_await writeBlock(self, fittingBlock, fitting, true);
+		} else if (block.size() >= self->blockSize * blockFillTarget) {
+			co_await writeBlock(self, block, count, true);
+		} else {
+			// Not full yet, estimate how many more raw bytes it takes to fill the block from the ratio so far
+			self->fittingCount = count;
+			self->checkBytes =
+			    std::max<int64_t>(self->pendingBytes + 1, self->blockSize * blockFillTarget * self->compressionRatio);
+		}
+	}
+
+	Future<Void> writeKV(Key k, Value v) override { return writeKV_impl(this, k, v); }
+
+	// The first key written is the begin key, the second one the end key
+	Future<Void> writeKey(Key k) override {
+		if (!beginKeyWritten) {
+			beginKey = k;
+			beginKeyWritten = true;
+		} else {
+			ASSERT(!endKey.present());
+			endKey = k;
+		}
+		return Void();
+	}
+
+	// Writes all pending entries, splitting them over several blocks if needed
+	static Future<Void> flush(CompressedRangeFileWriter* self, bool padLast) {
+		ASSERT(self->endKey.present());
+		if (self->flushed) {
+			co_return;
+		}
+		while (true) {
+			Standalone<StringRef> block = self->encodeBlock(self->pending.size());
+			if (self->fits(block)) {
+				co_await writeBlock(self, block, self->pending.size(), padLast);
+				break;
+			}
+			auto [fitting, fittingBlock] = self->largestFittingBlock(self->pending.size());
+			co_await writeBlock(self, fittingBlock, fitting, true);
+		}
+		self->flushed = true;
+	}
+
+	// Used in simulation only to create backup file sizes which are an integer multiple of the block size
+	Future<Void> padEnd(bool final) override {
+		ASSERT(g_network->isSimulated());
+		return flush(this, true);
+	}
+
+	Future<Void> finish() override { return flush(this, false); }
+
+	Reference<IBackupFile> file;
+	int blockSize;
+
+private:
+	static constexpr uint32_t fileVersion = BACKUP_AGENT_COMPRESSED_SNAPSHOT_FILE_VERSION;
+	int64_t blockEnd;
+	CompressionFilter filter;
+	Key beginKey;
+	bool beginKeyWritten = false;
+	Optional<Key> endKey;
+	// Entries not written yet, following beginKey
+	Standalone<VectorRef<KeyValueRef>> pending;
+	int64_t pendingBytes;
+	// Pending size at which to try sealing a block
+	int64_t checkBytes;
+	// Raw bytes per compressed byte of the last block encoded
+	double compressionRatio;
+	// Number of pending entries known to fit in a block
+	int fittingCount;
+	bool flushed;
+};
+
 void decodeKVPairs(StringRefReader* reader, Standalone<VectorRef<KeyValueRef>>* results) {
 	// Read begin key, if this fails then block was invalid.
 	uint32_t kLen = reader->consumeNetworkUInt32();
@@ -1501,6 +1740,54 @@ void decodeKVPairs(StringRefReader* reader, Standalone<VectorRef<KeyValueRef>>*
 			throw restore_corrupted_data_padding();
 }
 
+// Decodes a BACKUP_AGENT_COMPRESSED_SNAPSHOT_FILE_VERSION block whose version has already been consumed
+void decodeCompressedKVPairs(StringRefReader* reader, Standalone<VectorRef<KeyValueRef>>* results) {
+	uint8_t filter = reader->consume<uint8_t>();
+	if (filter >= (uint8_t)CompressionFilter::LAST)
+		throw restore_corrupted_data();
+	uint32_t rawLen = reader->consumeNetworkUInt32();
+	uint32_t compressedLen = reader->consumeNetworkUInt32();
+	StringRef compressed(reader->consume(compressedLen), compressedLen);
+	StringRef raw = CompressionUtils::decompress((CompressionFilter)filter, compressed, results->arena());
+	if (raw.size() != rawLen)
+		throw restore_corrupted_data();
+
+	StringRefReader payload(raw, restore_corrupted_data());
+	uint32_t count = payload.consumeNetworkUInt32();
+	if (count > raw.size())
+		throw restore_corrupted_data();
+	uint32_t beginKeyLen = payload.consumeNetworkUInt32();
+	KeyRef prev(payload.consume(beginKeyLen), beginKeyLen);
+	results->reserve(results->arena(), count + 2);
+	results->push_back(results->arena(), KeyValueRef(prev, ValueRef()));
+
+	// Keys of the kv pairs followed by the end key, each sharing a prefix with the previous one
+	for (uint32_t i = 0; i <= count; i++) {
+		uint32_t shared = payload.consumeNetworkUInt32();
+		uint32_t suffixLen = payload.consumeNetworkUInt32();
+		const uint8_t* suffix = payload.consume(suffixLen);
+		if (shared > prev.size())
+			throw restore_corrupted_data();
+		uint8_t* k = new (results->arena()) uint8_t[shared + suffixLen];
+		memcpy(k, prev.begin(), shared);
+		memcpy(k + shared, suffix, suffixLen);
+		prev = KeyRef(k, shared + suffixLen);
+		results->push_back(results->arena(), KeyValueRef(prev, ValueRef()));
+	}
+
+	for (uint32_t i = 1; i <= count; i++) {
+		uint32_t vLen = payload.consumeNetworkUInt32();
+		(*results)[i].value = ValueRef(payload.consume(vLen), vLen);
+	}
+	if (!payload.eof())
+		throw restore_corrupted_data();
+
+	// Make sure any remaining bytes in the block are 0xFF
+	for (auto b : reader->remainder())
+		if (b != 0xFF)
+			throw restore_corrupted_data_padding();
+}
+
 static Reference<IBackupContainer> getBackupContainerWithProxy(Reference<IBackupContainer> _bc) {
 	Reference<IBackupContainer> bc = IBackupContainer::openContainer(_bc->getURL(), fileBackupAgentProxy, {});
 	return bc;
@@ -1510,8 +1797,13 @@ Standalone<VectorRef<KeyValueRef>> decodeRangeFileBlock(const Standalone<StringR
 	Standalone<VectorRef<KeyValueRef>> results({}, buf.arena());
 	StringRefReader reader(buf, restore_corrupted_data());
 
-	// Read header, currently only decoding BACKUP_AGENT_SNAPSHOT_FILE_VERSION
-	if (reader.consume<int32_t>() != BACKUP_AGENT_SNAPSHOT_FILE_VERSION)
+	// Read header, currently decoding BACKUP_AGENT_SNAPSHOT_FILE_VERSION and its compressed variant
+	int32_t fileVersion = reader.consume<int32_t>();
+	if (fileVersion == BACKUP_AGENT_COMPRESSED_SNAPSHOT_FILE_VERSION) {
+		decodeCompressedKVPairs(&reader, &results);
+		return results;
+	}
+	if (fileVersion != BACKUP_AGENT_SNAPSHOT_FILE_VERSION)
 		throw restore_unsupported_file_version();
 
 	// Read begin key, if this fails then block was invalid.
@@ -1567,6 +1859,10 @@ Future<Standalone<VectorRef<KeyValueRef>>> decodeRangeFileBlock(Reference<IAsync
 	Arena arena;
 	try {
 		int32_t file_version = reader.consume<int32_t>();
+		if (file_version == BACKUP_AGENT_COMPRESSED_SNAPSHOT_FILE_VERSION) {
+			decodeCompressedKVPairs(&reader, &results);
+			co_return results;
+		}
 		if (file_version != BACKUP_AGENT_SNAPSHOT_FILE_VERSION) {
 			throw restore_unsupported_file_version();
 		}
@@ -1681,6 +1977,199 @@ Future<Standalone<VectorRef<KeyValueRef>>> decodeMutationLogFileBlock(Reference<
 	}
 }
 
+// Compressed partitioned mutation log format, PARTITIONED_MLOG_COMPRESSED_VERSION.
+//
+// Blocks start at block size boundaries like PARTITIONED_MLOG_VERSION blocks, but each one is
+//
+//   int32 version | uint8 compression filter | uint32 raw length | uint32 compressed length | payload | padding
+//
+// where the decompressed payload is the same sequence of (bigEndian64 version, bigEndian32 subsequence,
+// bigEndian32 size, message) entries an uncompressed block holds, only more of them.
+StringRef decodePartitionedLogFileBlock(StringRef buf, Arena& arena) {
+	StringRefReader reader(buf, restore_corrupted_data());
+	int32_t fileVersion = reader.consume<int32_t>();
+	if (fileVersion == PARTITIONED_MLOG_VERSION) {
+		return reader.remainder();
+	}
+	if (fileVersion != PARTITIONED_MLOG_COMPRESSED_VERSION)
+		throw restore_unsupported_file_version();
+
+	uint8_t filter = reader.consume<uint8_t>();
+	if (filter >= (uint8_t)CompressionFilter::LAST)
+		throw restore_corrupted_data();
+	uint32_t rawLen = reader.consumeNetworkUInt32();
+	uint32_t compressedLen = reader.consumeNetworkUInt32();
+	StringRef compressed(reader.consume(compressedLen), compressedLen);
+	for (auto b : reader.remainder())
+		if (b != 0xFF)
+			throw restore_corrupted_data_padding();
+
+	StringRef raw = CompressionUtils::decompress((CompressionFilter)filter, compressed, arena);
+	if (raw.size() != rawLen)
+		throw restore_corrupted_data();
+	return raw;
+}
+
+Optional<Standalone<StringRef>> expandPartitionedLogFileBlock(StringRef buf, int blockSize) {
+	uint32_t fileVersion = 0;
+	if (buf.size() >= sizeof(fileVersion)) {
+		memcpy(&fileVersion, buf.begin(), sizeof(fileVersion));
+	}
+	if (fileVersion != PARTITIONED_MLOG_COMPRESSED_VERSION) {
+		return {};
+	}
+
+	// Lay the messages out the way BackupWorker writes uncompressed blocks
+	Arena arena;
+	StringRef messages = decodePartitionedLogFileBlock(buf, arena);
+	StringRefReader reader(messages, restore_corrupted_data());
+	BinaryWriter wr(Unversioned());
+	int64_t blockEnd = 0;
+	while (!reader.eof()) {
+		const uint8_t* entry = reader.rptr;
+		reader.consume<Version>();
+		reader.consume<uint32_t>();
+		uint32_t size = reader.consumeNetworkUInt32();
+		reader.consume(size);
+		int bytes = reader.rptr - entry;
+		if (bytes > blockSize - (int)sizeof(PARTITIONED_MLOG_VERSION))
+			throw restore_corrupted_data();
+		if (wr.getLength() + bytes > blockEnd) {
+			int bytesLeft = blockEnd - wr.getLength();
+			if (bytesLeft > 0) {
+				wr.serializeBytes(makePadding(bytesLeft).substr(0, bytesLeft));
+			}
+			blockEnd += blockSize;
+			wr << PARTITIONED_MLOG_VERSION;
+		}
+		wr.serializeBytes(entry, bytes);
+	}
+	return wr.toValue();
+}
+
+CompressedMutationLogWriter::CompressedMutationLogWriter(Reference<IBackupFile> file, int blockSize)
+  : file(file), blockSize(blockSize),
+    filter(CompressionUtils::supportedFilters.contains(CompressionFilter::ZSTD) ? CompressionFilter::ZSTD
+                                                                                : CompressionFilter::NONE),
+    checkBytes(blockSize), compressionRatio(1.0), fittingBytes(0), writing(Void()) {}
+
+Standalone<StringRef> CompressedMutationLogWriter::encodeBlock(int bytes) const {
+	Arena arena;
+	StringRef raw((const uint8_t*)pending.data(), bytes);
+	StringRef compressed = CompressionUtils::compress(filter, raw, arena);
+	BinaryWriter block(Unversioned());
+	block << PARTITIONED_MLOG_COMPRESSED_VERSION << (uint8_t)filter << bigEndian32((uint32_t)bytes)
+	      << bigEndian32((uint32_t)compressed.size());
+	block.serializeBytes(compressed);
+	return block.toValue();
+}
+
+std::pair<int, Standalone<StringRef>> CompressedMutationLogWriter::largestFittingBlock(int hiEntries) const {
+	// Binary search over whole entries, between what is known to fit and hiEntries which is known not to
+	int lo = 0;
+	while (lo < entryEnds.size() && entryEnds[lo] <= fittingBytes) {
+		lo++;
+	}
+	lo = std::max(lo, 1);
+	int hi = hiEntries;
+	Standalone<StringRef> best;
+	while (hi - lo > 1) {
+		int mid = lo + (hi - lo) / 2;
+		Standalone<StringRef> block = encodeBlock(entryEnds[mid - 1]);
+		if (block.size() <= blockSize) {
+			lo = mid;
+			best = block;
+		} else {
+			hi = mid;
+		}
+	}
+	if (best.empty()) {
+		if (lo >= hi) {
+			throw backup_bad_block_size();
+		}
+		best = encodeBlock(entryEnds[lo - 1]);
+		if (best.size() > blockSize) {
+			throw backup_bad_block_size();
+		}
+	}
+	return { lo, best };
+}
+
+void CompressedMutationLogWriter::sealBlock(Standalone<StringRef> block, int entries, bool pad) {
+	int bytes = entries == 0 ? 0 : entryEnds[entries - 1];
+	int padding = pad ? blockSize - block.size() : 0;
+	writing = appendBlock(file, writing, block, padding);
+
+	// The remaining entries start the next block
+	pending.erase(0, bytes);
+	entryEnds.erase(entryEnds.begin(), entryEnds.begin() + entries);
+	for (auto& end : entryEnds) {
+		end -= bytes;
+	}
+	fittingBytes = 0;
+	checkBytes = pending.size() + (int64_t)(blockSize * blockFillTarget * compressionRatio);
+}
+
+Future<Void> CompressedMutationLogWriter::appendBlock(Reference<IBackupFile> file,
+                                                      Future<Void> previous,
+                                                      Standalone<StringRef> block,
+                                                      int padding) {
+	co_await previous;
+	co_await file->append(block.begin(), block.size());
+	if (padding > 0) {
+		Value paddingFFs = makePadding(padding);
+		co_await file->append(paddingFFs.begin(), padding);
+	}
+}
+
+Future<Void> CompressedMutationLogWriter::addMessage(Version version, uint32_t subsequence, StringRef message) {
+	int bytes = sizeof(Version) + sizeof(uint32_t) + sizeof(uint32_t) + message.size();
+	if (bytes > blockSize - (int)sizeof(PARTITIONED_MLOG_VERSION)) {
+		// Readers lay the messages of a block out in uncompressed blocks, where this would not fit
+		throw backup_bad_block_size();
+	}
+	BinaryWriter wr(Unversioned());
+	wr << bigEndian64(version) << bigEndian32(subsequence) << bigEndian32((uint32_t)message.size());
+	pending.append((const char*)wr.getData(), wr.getLength());
+	pending.append((const char*)message.begin(), message.size());
+	entryEnds.push_back(pending.size());
+	if (pending.size() < checkBytes) {
+		return writing;
+	}
+
+	Standalone<StringRef> block = encodeBlock(pending.size());
+	compressionRatio = (double)pending.size() / block.size();
+	if (block.size() > blockSize) {
+		auto [entries, fittingBlock] = largestFittingBlock(entryEnds.size());
+		sealBlock(fittingBlock, entries, true);
+	} else if (block.size() >= blockSize * blockFillTarget) {
+		sealBlock(block, entryEnds.size(), true);
+	} else {
+		// Not full yet, estimate how many more raw bytes it takes to fill the block from the ratio so far
+		fittingBytes = pending.size();
+		checkBytes = std::max<int64_t>(pending.size() + 1, blockSize * blockFillTarget * compressionRatio);
+	}
+	return writing;
+}
+
+Future<Void> CompressedMutationLogWriter::finish() {
+	while (!entryEnds.empty()) {
+		Standalone<StringRef> block = encodeBlock(pending.size());
+		if (block.size() <= blockSize) {
+			sealBlock(block, entryEnds.size(), false);
+			break;
+		}
+		auto [entries, fittingBlock] = largestFittingBlock(entryEnds.size());
+		sealBlock(fittingBlock, entries, true);
+	}
+	return finishFile(file, writing);
+}
+
+Future<Void> CompressedMutationLogWriter::finishFile(Reference<IBackupFile> file, Future<Void> previous) {
+	co_await previous;
+	co_await file->finish();
+}
+
 Future<Void> checkTaskVersion(Database cx, Reference<Task> task, StringRef name, uint32_t version) {
 	uint32_t taskVersion = task->getVersion();
 	if (taskVersion > version) {
@@ -2241,7 +2730,11 @@ struct BackupRangeTaskFunc : BackupTaskFuncBase {
 				outFile = f;
 
 				// Initialize range file writer and write begin key
-				rangeFile = std::make_unique<RangeFileWriter>(outFile, blockSize);
+				if (CLIENT_KNOBS->BACKUP_RANGEFILE_COMPRESSION) {
+					rangeFile = std::make_unique<CompressedRangeFileWriter>(outFile, blockSize);
+				} else {
+					rangeFile = std::make_unique<RangeFileWriter>(outFile, blockSize);
+				}
 				co_await rangeFile->writeKey(beginKey);
 			}
 
@@ -2382,6 +2875,204 @@ struct BackupSnapshotDispatchTask : BackupTaskFuncBase {
 
 	enum DispatchState { SKIP = 0, DONE = 1, NOT_DONE_MIN = 2 };
 
+	// Carries range files of the previous snapshot into the current one for ranges that no storage server has modified
+	// since the file's version, and marks those ranges as already dispatched so only modified ranges are read again.
+	// Storage servers report a last modified version per shard, which is an upper bound of the last mutation applied
+	// in it, so a file is only reused if every shard intersecting its range is known to be unchanged. The decision is
+	// recorded in snapshotIncrementalBase so that it is made exactly once per snapshot, before anything is dispatched.
+	//
+	// A restore from the snapshot needs mutation logs from its oldest file, so expireData() cannot expire past it
+	// without force. Only files the previous snapshot wrote itself are carried over, never the ones it carried over in
+	// turn, so a snapshot begins after the snapshot before the previous one ended. This keeps expire working for
+	// policies that retain two snapshot cycles, instead of pinning logs for up to BACKUP_INCREMENTAL_SNAPSHOT_MAX_AGE.
+	static Future<Void> reuseUnmodifiedRangeFiles(Database cx,
+	                                              Reference<TaskBucket> taskBucket,
+	                                              Reference<Task> task,
+	                                              std::vector<KeyRange> backupRanges,
+	                                              Version snapshotBeginVersion,
+	                                              Version previousSnapshotEndVersion) {
+		BackupConfig config(task);
+		Reference<ReadYourWritesTransaction> tr(new ReadYourWritesTransaction(cx));
+		Reference<IBackupContainer> bc;
+
+		while (true) {
+			Error err;
+			try {
+				tr->setOption(FDBTransactionOptions::ACCESS_SYSTEM_KEYS);
+				tr->setOption(FDBTransactionOptions::LOCK_AWARE);
+
+				Optional<std::string> base;
+				co_await (store(base, config.snapshotIncrementalBase().get(tr)) && taskBucket->keepRunning(tr, task));
+				if (base.present()) {
+					co_return;
+				}
+				Reference<IBackupContainer> _bc = co_await config.backupContainer().getOrThrow(tr);
+				bc = getBackupContainerWithProxy(_bc);
+				break;
+			} catch (Error& e) {
+				err = e;
+			}
+			co_await tr->onError(err);
+		}
+
+		// Find the files of the previous snapshot and the ones that are still young enough to be carried forward.
+		// Anything going wrong here only means the snapshot is taken in full.
+		std::string baseSnapshot;
+		std::vector<std::pair<RangeFile, KeyRange>> candidates;
+		{
+			Error err;
+			try {
+				auto* bcfsPtr = dynamic_cast<BackupContainerFileSystem*>(bc.getPtr());
+				if (bcfsPtr != nullptr) {
+					Reference<BackupContainerFileSystem> bcfs = Reference<BackupContainerFileSystem>::addRef(bcfsPtr);
+					std::vector<KeyspaceSnapshotFile> snapshots = co_await bcfs->listKeyspaceSnapshots();
+					Version oldestReusable = snapshotBeginVersion - CLIENT_KNOBS->BACKUP_INCREMENTAL_SNAPSHOT_MAX_AGE *
+					                                                    CLIENT_KNOBS->CORE_VERSIONSPERSECOND;
+					// Files the previous snapshot carried over are no newer than the snapshot before it
+					for (const auto& s : snapshots) {
+						if (s.endVersion < previousSnapshotEndVersion) {
+							oldestReusable = std::max(oldestReusable, s.endVersion + 1);
+						}
+					}
+					for (int i = snapshots.size() - 1; i >= 0 && baseSnapshot.empty(); --i) {
+						if (snapshots[i].endVersion != previousSnapshotEndVersion) {
+							continue;
+						}
+						std::pair<std::vector<RangeFile>, std::map<std::string, KeyRange>> contents =
+						    co_await bcfs->readKeyspaceSnapshot(snapshots[i]);
+						if (contents.second.empty()) {
+							continue;
+						}
+						baseSnapshot = snapshots[i].fileName;
+						for (const auto& f : contents.first) {
+							auto kr = contents.second.find(f.fileName);
+							if (f.version < oldestReusable || kr == contents.second.end()) {
+								continue;
+							}
+							for (const auto& range : backupRanges) {
+								if (range.contains(kr->second)) {
+									candidates.emplace_back(f, kr->second);
+									break;
+								}
+							}
+						}
+					}
+				}
+			} catch (Error& e) {
+				err = e;
+			}
+			if (err.isValid()) {
+				if (err.code() == error_code_actor_cancelled) {
+					throw err;
+				}
+				TraceEvent(SevWarn, "FileBackupIncrementalSnapshotBaseUnavailable")
+				    .errorUnsuppressed(err)
+				    .detail("BackupUID", config.getUid())
+				    .detail("PreviousSnapshotEndVersion", previousSnapshotEndVersion);
+				candidates.clear();
+			}
+		}
+
+		// Ask the storage servers when each shard of the backup ranges was last modified, as of the snapshot begin
+		std::vector<std::pair<RangeFile, KeyRange>> reused;
+		if (!candidates.empty()) {
+			KeyRangeMap<Version> modified(std::numeric_limits<Version>::max());
+			Error err;
+			try {
+				for (const auto& range : backupRanges) {
+					std::vector<std::pair<KeyRange, Version>> shards =
+					    co_await cx->getRangeModifiedVersions(range, snapshotBeginVersion);
+					for (const auto& [shard, v] : shards) {
+						modified.insert(shard, v);
+					}
+				}
+			} catch (Error& e) {
+				err = e;
+			}
+			if (err.isValid()) {
+				if (err.code() == error_code_actor_cancelled) {
+					throw err;
+				}
+				TraceEvent(SevWarn, "FileBackupIncrementalSnapshotModifiedVersionsUnavailable")
+				    .errorUnsuppressed(err)
+				    .detail("BackupUID", config.getUid());
+			} else {
+				for (const auto& [f, kr] : candidates) {
+					bool unchanged = true;
+					for (auto r : modified.intersectingRanges(kr)) {
+						if (r.value() > f.version) {
+							unchanged = false;
+							break;
+						}
+					}
+					if (unchanged) {
+						reused.emplace_back(f, kr);
+					}
+				}
+				std::sort(reused.begin(), reused.end(), [](auto const& a, auto const& b) {
+					return a.second.begin < b.second.begin;
+				});
+			}
+		}
+
+		int64_t reusedBytes = 0;
+		tr->reset();
+		while (true) {
+			Error err;
+			try {
+				tr->setOption(FDBTransactionOptions::ACCESS_SYSTEM_KEYS);
+				tr->setOption(FDBTransactionOptions::LOCK_AWARE);
+
+				Optional<std::string> base;
+				BackupConfig::RangeDispatchMapT::RangeResultType dispatched;
+				co_await (store(base, config.snapshotIncrementalBase().get(tr)) &&
+				          store(dispatched,
+				                config.snapshotRangeDispatchMap().getRange(tr, allKeys.begin, keyAfter(allKeys.end), 1)) &&
+				          taskBucket->keepRunning(tr, task));
+				if (base.present()) {
+					co_return;
+				}
+
+				// Ranges can only be marked as dispatched while nothing else has been
+				reusedBytes = 0;
+				if (dispatched.results.empty() && !reused.empty()) {
+					Key runBegin = reused.front().second.begin;
+					Key runEnd = runBegin;
+					for (const auto& [f, kr] : reused) {
+						config.snapshotRangeFileMap().set(tr, kr.end, { kr.begin, f.version, f.fileName, f.fileSize });
+						reusedBytes += f.fileSize;
+						if (kr.begin != runEnd) {
+							config.snapshotRangeDispatchMap().set(tr, runBegin, true);
+							config.snapshotRangeDispatchMap().set(tr, runEnd, false);
+							runBegin = kr.begin;
+						}
+						runEnd = kr.end;
+					}
+					config.snapshotRangeDispatchMap().set(tr, runBegin, true);
+					config.snapshotRangeDispatchMap().set(tr, runEnd, false);
+					config.snapshotIncrementalBase().set(tr, baseSnapshot);
+				} else {
+					reused.clear();
+					config.snapshotIncrementalBase().set(tr, std::string());
+				}
+
+				co_await tr->commit();
+				break;
+			} catch (Error& e) {
+				err = e;
+			}
+			co_await tr->onError(err);
+		}
+
+		TraceEvent("FileBackupIncrementalSnapshot")
+		    .detail("BackupUID", config.getUid())
+		    .detail("BaseSnapshot", baseSnapshot)
+		    .detail("SnapshotBeginVersion", snapshotBeginVersion)
+		    .detail("CandidateFiles", candidates.size())
+		    .detail("ReusedFiles", reused.size())
+		    .detail("ReusedBytes", reusedBytes);
+	}
+
 	static Future<Void> _execute(Database cx,
 	                             Reference<TaskBucket> taskBucket,
 	                             Reference<FutureBucket> futureBucket,
@@ -2493,6 +3184,13 @@ struct BackupSnapshotDispatchTask : BackupTaskFuncBase {
 			co_await tr->onError(err);
 		}
 
+		// Before dispatching anything for a new snapshot, carry over whatever the previous one wrote for ranges that
+		// have not changed since.
+		if (CLIENT_KNOBS->BACKUP_INCREMENTAL_SNAPSHOTS && latestSnapshotEndVersion.present()) {
+			co_await reuseUnmodifiedRangeFiles(
+			    cx, taskBucket, task, backupRanges, snapshotBeginVersion, latestSnapshotEndVersion.get());
+		}
+
 		// Read all dispatched ranges
 		std::vector<std::pair<Key, bool>> dispatchBoundaries;
 		tr->reset();
@@ -3507,6 +4205,8 @@ struct BackupSnapshotManifest : BackupTaskFuncBase {
 		std::map<Key, BackupConfig::RangeSlice> localmap;
 		Key startKey;
 		int batchSize = BUGGIFY ? 1 : 1000000;
+		Version snapshotBeginVersion = invalidVersion;
+		Optional<std::string> incrementalBase;
 
 		while (true) {
 			Error err;
@@ -3522,6 +4222,10 @@ struct BackupSnapshotManifest : BackupTaskFuncBase {
 					Reference<IBackupContainer> _bc = co_await config.backupContainer().getOrThrow(tr);
 					bc = getBackupContainerWithProxy(_bc);
 				}
+				if (snapshotBeginVersion == invalidVersion) {
+					co_await (store(snapshotBeginVersion, config.snapshotBeginVersion().getOrThrow(tr)) &&
+					          store(incrementalBase, config.snapshotIncrementalBase().get(tr)));
+				}
 
 				BackupConfig::RangeFileMapT::RangeResultType rangeresults =
 				    co_await config.snapshotRangeFileMap().getRange(tr, startKey, {}, batchSize);
@@ -3544,6 +4248,7 @@ struct BackupSnapshotManifest : BackupTaskFuncBase {
 		}
 
 		std::vector<std::string> files;
+		std::vector<std::string> reusedFiles;
 		std::vector<std::pair<Key, Key>> beginEndKeys;
 		Version maxVer = 0;
 		Version minVer = std::numeric_limits<Version>::max();
@@ -3560,6 +4265,10 @@ struct BackupSnapshotManifest : BackupTaskFuncBase {
 				// Add file to final file list
 				files.push_back(r.fileName);
 
+				// Files older than the snapshot were carried over from the previous one
+				if (r.version < snapshotBeginVersion)
+					reusedFiles.push_back(r.fileName);
+
 				// Add (beginKey, endKey) pairs to the list
 				beginEndKeys.emplace_back(i->second.begin, i->first);
 
@@ -3584,16 +4293,25 @@ struct BackupSnapshotManifest : BackupTaskFuncBase {
 			}
 		}
 
+		// Reused ranges are unchanged up to the snapshot begin version, which is where the snapshot ends if all of its
+		// files were reused. The container writes the same end version into the manifest.
+		Optional<SnapshotMetadata> metadata;
+		if (incrementalBase.present() && !incrementalBase.get().empty() && !reusedFiles.empty()) {
+			maxVer = std::max(maxVer, snapshotBeginVersion);
+			metadata = SnapshotMetadata::incremental(incrementalBase.get(), reusedFiles, snapshotBeginVersion);
+		}
+
 		Params.endVersion().set(task, maxVer);
 
 		// Avoid keyRange filtering optimization for 'manifest' files
-		co_await bc->writeKeyspaceSnapshotFile(files, beginEndKeys, totalBytes, IncludeKeyRangeMap::True);
+		co_await bc->writeKeyspaceSnapshotFile(files, beginEndKeys, totalBytes, IncludeKeyRangeMap::True, metadata);
 
 		TraceEvent(SevInfo, "FileBackupWroteSnapshotManifest")
 		    .detail("BackupUID", config.getUid())
 		    .detail("BeginVersion", minVer)
 		    .detail("EndVersion", maxVer)
-		    .detail("TotalBytes", totalBytes);
+		    .detail("TotalBytes", totalBytes)
+		    .detail("ReusedFiles", reusedFiles.size());
 
 		co_return;
 	}
@@ -4212,6 +4930,203 @@ struct BulkLoadRestoreTaskFunc : RestoreTaskFuncBase {
 		return _finish(tr, tb, fb, task);
 	};
 
+	// Check that the restore can load the backup range files as they are, and return the root under which storage
+	// servers address the files of the backup container.
+	static Future<std::string> checkRangeFileBulkLoadRestore(Database cx, RestoreConfig restore) {
+		Reference<ReadYourWritesTransaction> tr(new ReadYourWritesTransaction(cx));
+		Reference<IBackupContainer> bc;
+		Key addPrefix;
+		Key removePrefix;
+		while (true) {
+			Error err;
+			try {
+				tr->setOption(FDBTransactionOptions::ACCESS_SYSTEM_KEYS);
+				tr->setOption(FDBTransactionOptions::LOCK_AWARE);
+				bc = co_await restore.sourceContainer().getOrThrow(tr);
+				addPrefix = co_await restore.addPrefix().getD(tr);
+				removePrefix = co_await restore.removePrefix().getD(tr);
+				break;
+			} catch (Error& e) {
+				err = e;
+			}
+			co_await tr->onError(err);
+		}
+
+		// Storage servers ingest the keys of the range files without translating them, and cannot decrypt files
+		// encrypted by the backup container
+		const std::string url = bc->getURL();
+		const bool localUrl = url.find("file://") == 0;
+		if (!addPrefix.empty() || !removePrefix.empty() || bc->getEncryptionKeyFileName().present() ||
+		    (!localUrl && !isBlobstoreUrl(url))) {
+			TraceEvent(SevWarnAlways, "BulkLoadRestoreRangeFilesUnsupported")
+			    .detail("RestoreUID", restore.getUid())
+			    .detail("BackupUrl", url)
+			    .detail("AddPrefix", addPrefix)
+			    .detail("RemovePrefix", removePrefix)
+			    .detail("Encrypted", bc->getEncryptionKeyFileName().present());
+			throw restore_bulkload_failed();
+		}
+		if (!localUrl) {
+			co_return getBackupDataPath(url, "");
+		}
+		// Same path as the one BackupContainerLocalDirectory writes to
+		std::string path = url.substr(7);
+		path.erase(path.find_last_not_of("\\/") + 1);
+		co_return path;
+	}
+
+	// Write a BulkLoad job which loads range as of restoreVersion from the backup range files. Each range file becomes
+	// a manifest, which the storage server loading it converts to an SST, and the gaps between range files become
+	// empty manifests so that the manifests tile the job range. The manifests and the job manifest are written to
+	// <jobId>/ in the backup container, which is the job root. Return the manifests.
+	static Future<std::vector<BulkLoadManifest>> writeRangeFileBulkLoadJob(Database cx,
+	                                                                       Reference<IBackupContainer> bc,
+	                                                                       Version restoreVersion,
+	                                                                       KeyRange range,
+	                                                                       UID jobId,
+	                                                                       std::string jobRoot,
+	                                                                       BulkLoadTransportMethod transportMethod) {
+		Reference<BackupContainerFileSystem> bcfs = bc.castTo<BackupContainerFileSystem>();
+		ASSERT(bcfs);
+		Standalone<VectorRef<KeyRangeRef>> keyRangesFilter;
+		keyRangesFilter.push_back_deep(keyRangesFilter.arena(), range);
+		Optional<RestorableFileSet> restorable = co_await bc->getRestoreSet(restoreVersion, keyRangesFilter);
+		if (!restorable.present()) {
+			throw restore_missing_data();
+		}
+
+		std::vector<std::pair<KeyRange, RangeFile>> files;
+		for (const RangeFile& file : restorable.get().ranges) {
+			KeyRange fileRange;
+			auto it = restorable.get().keyRanges.find(file.fileName);
+			if (it != restorable.get().keyRanges.end()) {
+				fileRange = it->second;
+			} else {
+				// Backups taken before 6.3 do not record the key ranges of range files
+				fileRange = co_await bc->getSnapshotFileKeyRange(file, cx);
+			}
+			if (fileRange.intersects(range)) {
+				files.emplace_back(KeyRange(fileRange & range), file);
+			}
+		}
+		std::sort(files.begin(), files.end(), [](const auto& a, const auto& b) {
+			return a.first.begin < b.first.begin;
+		});
+
+		// The storage servers sample the SSTs written from the range files with the cluster setting
+		const BulkLoadByteSampleSetting byteSampleSetting(0, "none", 0, 0, 0.0);
+		std::vector<BulkLoadManifest> manifests;
+		auto manifestFileName = [&]() { return std::to_string(manifests.size()) + "-manifest.txt"; };
+		auto addEmptyManifest = [&](KeyRef begin, KeyRef end) {
+			BulkLoadFileSet fileSet(jobRoot, jobId.toString(), manifestFileName(), "", "", BulkLoadChecksum());
+			manifests.emplace_back(fileSet,
+			                       begin,
+			                       end,
+			                       restoreVersion,
+			                       0,
+			                       0,
+			                       byteSampleSetting,
+			                       BulkLoadType::RangeFile,
+			                       transportMethod);
+		};
+		Key cursor = range.begin;
+		for (const auto& [fileRange, file] : files) {
+			if (fileRange.begin < cursor) {
+				TraceEvent(SevWarnAlways, "BulkLoadRestoreRangeFilesOverlap")
+				    .detail("FileName", file.fileName)
+				    .detail("FileRange", fileRange)
+				    .detail("PreviousEnd", cursor);
+				throw restore_corrupted_data();
+			}
+			if (fileRange.begin > cursor) {
+				addEmptyManifest(cursor, fileRange.begin);
+			}
+			size_t slash = file.fileName.find_last_of('/');
+			BulkLoadFileSet fileSet(jobRoot,
+			                        slash == std::string::npos ? "" : file.fileName.substr(0, slash),
+			                        manifestFileName(),
+			                        file.fileName.substr(slash == std::string::npos ? 0 : slash + 1),
+			                        "",
+			                        BulkLoadChecksum());
+			// The key count is unknown until the file is decoded, so the block count stands in for it
+			manifests.emplace_back(fileSet,
+			                       fileRange.begin,
+			                       fileRange.end,
+			                       file.version,
+			                       file.fileSize,
+			                       (file.fileSize + file.blockSize - 1) / file.blockSize,
+			                       byteSampleSetting,
+			                       BulkLoadType::RangeFile,
+			                       transportMethod);
+			cursor = fileRange.end;
+		}
+		if (cursor < range.end) {
+			addEmptyManifest(cursor, range.end);
+		}
+
+		std::vector<std::string> manifestPaths;
+		std::vector<std::string> manifestContents;
+		std::string jobManifest =
+		    BulkLoadJobManifestFileHeader(bulkLoadManifestFormatVersion, manifests.size()).toString() +
+		    bulkLoadJobManifestLineTerminator;
+		for (const auto& manifest : manifests) {
+			manifestPaths.push_back(joinPath(jobId.toString(), manifest.getFileSet().getManifestFileName()));
+			manifestContents.push_back(manifest.toString());
+			jobManifest += BulkLoadJobFileManifestEntry(manifest, manifestPaths.back()).toString() +
+			               bulkLoadJobManifestLineTerminator;
+		}
+		std::vector<Future<Void>> writes;
+		for (int i = 0; i < manifestPaths.size(); i++) {
+			writes.push_back(bcfs->writeEntireFile(manifestPaths[i], manifestContents[i]));
+		}
+		co_await waitForAll(writes);
+		// The job manifest is written last, so a job manifest is only found once all manifests exist
+		co_await bcfs->writeEntireFile(joinPath(jobId.toString(), getBulkLoadJobManifestFileName()), jobManifest);
+
+		TraceEvent("BulkLoadRestoreRangeFileJobWritten")
+		    .detail("BulkLoadJobId", jobId)
+		    .detail("Range", range)
+		    .detail("RangeFileCount", files.size())
+		    .detail("ManifestCount", manifests.size())
+		    .detail("JobRoot", jobRoot);
+		co_return manifests;
+	}
+
+	// Replay mutation logs for each range loaded from a range file from the version of that file, as
+	// RestoreRangeTaskFunc does once it has restored a range file
+	static Future<Void> setRangeFileApplyMutationsVersions(Database cx,
+	                                                       RestoreConfig restore,
+	                                                       std::vector<BulkLoadManifest> manifests) {
+		Reference<ReadYourWritesTransaction> tr(new ReadYourWritesTransaction(cx));
+		int start = 0;
+		while (start < manifests.size()) {
+			Error err;
+			try {
+				tr->setOption(FDBTransactionOptions::ACCESS_SYSTEM_KEYS);
+				tr->setOption(FDBTransactionOptions::LOCK_AWARE);
+				int end = start;
+				std::vector<Future<Void>> updateMap;
+				for (; end < manifests.size() && updateMap.size() < 100; ++end) {
+					if (manifests[end].hasDataFile()) {
+						updateMap.push_back(
+						    krmSetRange(tr,
+						                restore.applyMutationsMapPrefix(),
+						                manifests[end].getRange(),
+						                BinaryWriter::toValue(manifests[end].getVersion(), Unversioned())));
+					}
+				}
+				co_await waitForAll(updateMap);
+				co_await tr->commit();
+				start = end;
+				tr->reset();
+				continue;
+			} catch (Error& e) {
+				err = e;
+			}
+			co_await tr->onError(err);
+		}
+	}
+
 	static Future<Void> _execute(Database cx,
 	                             Reference<TaskBucket> taskBucket,
 	                             Reference<FutureBucket> futureBucket,
@@ -4281,46 +5196,60 @@ struct BulkLoadRestoreTaskFunc : RestoreTaskFuncBase {
 					}
 				}
 
-				// Create BulkLoad job from the BulkDump data
-				// BulkDump stores data under data/<container>/bulkdump_data/ subdirectory.
-				// DD appends the jobId via getBulkLoadJobRoot(jobRoot, jobId) when accessing files.
-				std::string jobRoot = getBackupDataPath(backupUrl, "bulkdump_data");
-				UID dumpJobUid;
+				// Determine transport method from backup URL
+				BulkLoadTransportMethod loadTransportMethod =
+				    isBlobstoreUrl(backupUrl) ? BulkLoadTransportMethod::BLOBSTORE : BulkLoadTransportMethod::CP;
+
+				std::vector<BulkLoadJobState> bulkLoadJobs;
+				std::vector<BulkLoadManifest> rangeFileManifests;
 				if (!bulkDumpJobId.empty()) {
-					dumpJobUid = UID::fromString(bulkDumpJobId);
-				} else {
-					// No BulkDump job ID found - this is an error for BulkLoad restore
-					TraceEvent(SevError, "BulkLoadRestoreNoBulkDumpJobId")
+					// Create BulkLoad job from the BulkDump data
+					// BulkDump stores data under data/<container>/bulkdump_data/ subdirectory.
+					// DD appends the jobId via getBulkLoadJobRoot(jobRoot, jobId) when accessing files.
+					std::string jobRoot = getBackupDataPath(backupUrl, "bulkdump_data");
+					UID dumpJobUid = UID::fromString(bulkDumpJobId);
+
+					// Verify BulkDump dataset completeness before proceeding
+					bool datasetComplete = co_await verifyBulkDumpDatasetCompleteness(bcRef, bulkDumpJobId);
+					if (!datasetComplete) {
+						TraceEvent(SevWarn, "BulkLoadRestoreDatasetIncomplete")
+						    .detail("RestoreUID", restore.getUid())
+						    .detail("BulkDumpJobId", bulkDumpJobId)
+						    .detail("BackupUrl", backupUrl);
+						throw restore_missing_data();
+					}
+					TraceEvent("BulkLoadRestoreDatasetVerified")
 					    .detail("RestoreUID", restore.getUid())
-					    .detail("BackupUrl", backupUrl);
-					throw restore_missing_data();
+					    .detail("BulkDumpJobId", bulkDumpJobId);
+
+					// BulkLoad range must match the BulkDump range (normalKeys)
+					// The actual restore ranges will be applied via mutation log replay
+					bulkLoadJobs.push_back(createBulkLoadJob(dumpJobUid, normalKeys, jobRoot, loadTransportMethod));
+				} else {
+					// No BulkDump snapshot, so load the range files of the backup instead. Each restore range is
+					// loaded by its own job because a job replaces all data within its range. Job IDs are derived
+					// from the restore UID so that a retried task resubmits the same jobs.
+					std::string jobRoot = co_await checkRangeFileBulkLoadRestore(cx, restore);
+					for (int i = 0; i < restoreRanges.size(); i++) {
+						KeyRange jobRange = restoreRanges[i] & normalKeys;
+						if (jobRange.empty()) {
+							continue;
+						}
+						UID jobId(restore.getUid().first(), restore.getUid().second() + i);
+						std::vector<BulkLoadManifest> manifests = co_await writeRangeFileBulkLoadJob(
+						    cx, bcRef, restoreVersion, jobRange, jobId, jobRoot, loadTransportMethod);
+						rangeFileManifests.insert(rangeFileManifests.end(), manifests.begin(), manifests.end());
+						bulkLoadJobs.push_back(createBulkLoadJob(jobId, jobRange, jobRoot, loadTransportMethod));
+					}
 				}
 
-				// Verify BulkDump dataset completeness before proceeding
-				bool datasetComplete = co_await verifyBulkDumpDatasetCompleteness(bcRef, bulkDumpJobId);
-				if (!datasetComplete) {
-					TraceEvent(SevWarn, "BulkLoadRestoreDatasetIncomplete")
+				for (const auto& bulkLoadJob : bulkLoadJobs) {
+					TraceEvent("BulkLoadRestoreJobCreated")
 					    .detail("RestoreUID", restore.getUid())
-					    .detail("BulkDumpJobId", bulkDumpJobId)
-					    .detail("BackupUrl", backupUrl);
-					throw restore_missing_data();
+					    .detail("BulkLoadJobId", bulkLoadJob.getJobId())
+					    .detail("JobRange", bulkLoadJob.getJobRange())
+					    .detail("JobRoot", bulkLoadJob.getJobRoot());
 				}
-				TraceEvent("BulkLoadRestoreDatasetVerified")
-				    .detail("RestoreUID", restore.getUid())
-				    .detail("BulkDumpJobId", bulkDumpJobId);
-
-				// Determine transport method from backup URL
-				BulkLoadTransportMethod loadTransportMethod =
-				    isBlobstoreUrl(backupUrl) ? BulkLoadTransportMethod::BLOBSTORE : BulkLoadTransportMethod::CP;
-
-				// BulkLoad range must match the BulkDump range (normalKeys)
-				// The actual restore ranges will be applied via mutation log replay
-				BulkLoadJobState bulkLoadJob = createBulkLoadJob(dumpJobUid, normalKeys, jobRoot, loadTransportMethod);
-
-				TraceEvent("BulkLoadRestoreJobCreated")
-				    .detail("RestoreUID", restore.getUid())
-				    .detail("BulkLoadJobId", bulkLoadJob.getJobId())
-				    .detail("JobRoot", jobRoot);
 
 				// Register the BulkLoad range lock owner (required for range locking)
 				co_await registerRangeLockOwner(cx, "BulkLoad", "BulkLoad restore operation");
@@ -4340,37 +5269,42 @@ struct BulkLoadRestoreTaskFunc : RestoreTaskFuncBase {
 				// Enable BulkLoad mode at DD level so the job will be processed
 				co_await setBulkLoadMode(cx, 1);
 
-				TraceEvent("BulkLoadRestoreEnabledMode")
-				    .detail("RestoreUID", restore.getUid())
-				    .detail("BulkLoadJobId", bulkLoadJob.getJobId());
-
-				// Submit BulkLoad job (must be lockAware since DB is locked during restore)
-				co_await submitBulkLoadJob(cx, bulkLoadJob, true /* lockAware */);
-
-				TraceEvent("BulkLoadRestoreJobSubmitted")
-				    .detail("RestoreUID", restore.getUid())
-				    .detail("BulkLoadJobId", bulkLoadJob.getJobId());
+				TraceEvent("BulkLoadRestoreEnabledMode").detail("RestoreUID", restore.getUid());
 
-				// Monitor BulkLoad progress - timeout is configurable for large datasets
-				// Must be lockAware since DB is locked during restore
-				bool completed = co_await monitorBulkLoadJobCompletion(cx,
-				                                                       bulkLoadJob.getJobId(),
-				                                                       CLIENT_KNOBS->BULKLOAD_JOB_TIMEOUT,
-				                                                       5.0, // Poll every 5 seconds
-				                                                       true); // lockAware
+				// At most one BulkLoad job runs at a time, so the jobs are submitted one after another
+				for (const auto& bulkLoadJob : bulkLoadJobs) {
+					// Submit BulkLoad job (must be lockAware since DB is locked during restore)
+					co_await submitBulkLoadJob(cx, bulkLoadJob, true /* lockAware */);
 
-				if (!completed) {
-					TraceEvent(SevWarn, "BulkLoadRestoreTimeout")
+					TraceEvent("BulkLoadRestoreJobSubmitted")
 					    .detail("RestoreUID", restore.getUid())
-					    .detail("BulkLoadJobId", bulkLoadJob.getJobId())
-					    .detail("TimeoutDuration", CLIENT_KNOBS->BULKLOAD_JOB_TIMEOUT);
-					// Restore original BulkLoad mode before throwing
-					if (originalBulkLoadMode != 1) {
-						co_await setBulkLoadMode(cx, originalBulkLoadMode);
+					    .detail("BulkLoadJobId", bulkLoadJob.getJobId());
+
+					// Monitor BulkLoad progress - timeout is configurable for large datasets
+					// Must be lockAware since DB is locked during restore
+					bool completed = co_await monitorBulkLoadJobCompletion(cx,
+					                                                       bulkLoadJob.getJobId(),
+					                                                       CLIENT_KNOBS->BULKLOAD_JOB_TIMEOUT,
+					                                                       5.0, // Poll every 5 seconds
+					                                                       true); // lockAware
+
+					if (!completed) {
+						TraceEvent(SevWarn, "BulkLoadRestoreTimeout")
+						    .detail("RestoreUID", restore.getUid())
+						    .detail("BulkLoadJobId", bulkLoadJob.getJobId())
+						    .detail("TimeoutDuration", CLIENT_KNOBS->BULKLOAD_JOB_TIMEOUT);
+						// Restore original BulkLoad mode before throwing
+						if (originalBulkLoadMode != 1) {
+							co_await setBulkLoadMode(cx, originalBulkLoadMode);
+						}
+						throw timed_out();
 					}
-					throw timed_out();
 				}
 
+				// Range files of a snapshot are taken at different versions, so mutation logs are replayed for each
+				// range from the version of the range file that covers it.
+				co_await setRangeFileApplyMutationsVersions(cx, restore, rangeFileManifests);
+
 				// Restore original BulkLoad mode now that the job is complete
 				if (originalBulkLoadMode != 1) {
 					co_await setBulkLoadMode(cx, originalBulkLoadMode);
@@ -4378,7 +5312,8 @@ struct BulkLoadRestoreTaskFunc : RestoreTaskFuncBase {
 
 				TraceEvent("BulkLoadRestoreTaskComplete")
 				    .detail("RestoreUID", restore.getUid())
-				    .detail("BulkLoadJobId", bulkLoadJob.getJobId())
+				    .detail("BulkLoadJobCount", bulkLoadJobs.size())
+				    .detail("RangeFileManifestCount", rangeFileManifests.size())
 				    .detail("RestoreVersion", restoreVersion);
 
 				// Increment counter for test assertions
@@ -5540,6 +6475,10 @@ struct RestoreLogDataPartitionedTaskFunc : RestoreFileTaskFuncBase {
 		PromiseStream<Standalone<VectorRef<KeyValueRef>>> mutationStream;
 		Future<Void> reader = readLogData(mutationStream, iterators, begin, end);
 
+		// Each batch is written to disjoint alog keys (hash/version/part) with blind sets, and nothing is applied
+		// until the dispatch task advances the apply end version past this task's range, so batches can be
+		// committed concurrently and in any order.
+		std::deque<Future<Void>> writes;
 		std::vector<Standalone<VectorRef<KeyValueRef>>> mutations;
 		int64_t totalBytes = 0;
 		Standalone<VectorRef<KeyValueRef>> oneVersionData;
@@ -5552,9 +6491,13 @@ struct RestoreLogDataPartitionedTaskFunc : RestoreFileTaskFuncBase {
 				// batching mutations from multiple versions together before writing to the database
 				int64_t bytes = oneVersionData.expectedSize();
 				if (totalBytes + bytes > CLIENT_KNOBS->RESTORE_WRITE_TX_SIZE) {
-					co_await writeMutations(cx, mutations, restore.mutationLogPrefix(), task, taskBucket);
+					writes.push_back(writeMutations(cx, mutations, restore.mutationLogPrefix(), task, taskBucket));
 					mutations.clear();
 					totalBytes = 0;
+					while (writes.size() >= std::max(1, CLIENT_KNOBS->RESTORE_LOG_WRITES_IN_FLIGHT)) {
+						co_await writes.front();
+						writes.pop_front();
+					}
 				}
 				mutations.push_back(oneVersionData);
 				totalBytes += bytes;
@@ -5564,7 +6507,10 @@ struct RestoreLogDataPartitionedTaskFunc : RestoreFileTaskFuncBase {
 			}
 			if (err.code() == error_code_end_of_stream) {
 				if (mutations.size() > 0) {
-					co_await writeMutations(cx, mutations, restore.mutationLogPrefix(), task, taskBucket);
+					writes.push_back(writeMutations(cx, mutations, restore.mutationLogPrefix(), task, taskBucket));
+				}
+				for (auto& w : writes) {
+					co_await w;
 				}
 				break;
 			} else {
@@ -5823,8 +6769,31 @@ struct RestoreDispatchPartitionedTaskFunc : RestoreTaskFuncBase {
 				                                                       TaskCompletionKey::joinWith(allPartsDone)));
 			}
 		}
-		addTaskFutures.push_back(RestoreLogDataPartitionedTaskFunc::addTask(
-		    tr, taskBucket, task, maxTagID, logs, beginVersion, endVersion, TaskCompletionKey::joinWith(allPartsDone)));
+		// Log replay for the batch is split into disjoint version slices, each its own task so that several restore
+		// agents can replay the batch in parallel. A slice writes every alog key of its versions, so slices never
+		// overwrite each other, and allPartsDone is the barrier: the next dispatch only advances the apply end
+		// version once every slice of this batch has been written.
+		int64_t slices = std::min<int64_t>(std::max(1, CLIENT_KNOBS->RESTORE_LOG_APPLIER_STREAMS),
+		                                   std::max<int64_t>(1, endVersion - beginVersion));
+		for (int64_t slice = 0; slice < slices; slice++) {
+			Version sliceBegin = beginVersion + (endVersion - beginVersion) * slice / slices;
+			Version sliceEnd = slice == slices - 1 ? endVersion
+			                                       : beginVersion + (endVersion - beginVersion) * (slice + 1) / slices;
+			std::vector<RestoreConfig::RestoreFile> sliceLogs;
+			for (auto& f : logs) {
+				if (f.endVersion > sliceBegin && f.version < sliceEnd) {
+					sliceLogs.push_back(f);
+				}
+			}
+			addTaskFutures.push_back(RestoreLogDataPartitionedTaskFunc::addTask(tr,
+			                                                                    taskBucket,
+			                                                                    task,
+			                                                                    maxTagID,
+			                                                                    sliceLogs,
+			                                                                    sliceBegin,
+			                                                                    sliceEnd,
+			                                                                    TaskCompletionKey::joinWith(allPartsDone)));
+		}
 		// even if file exsists, but they are empty, in this case just start the next batch
 
 		addTaskFutures.push_back(RestoreDispatchPartitionedTaskFunc::addTask(tr,
@@ -8501,3 +9470,119 @@ void simulateBlobFailure() {
 		}
 	}
 }
+
+namespace {
+// Backup file kept in memory, for exercising the range file writers
+class MemoryBackupFile : public IBackupFile, ReferenceCounted<MemoryBackupFile> {
+public:
+	MemoryBackupFile() : IBackupFile("memory") {}
+
+	Future<Void> append(const void* data, int len) override {
+		contents.append((const char*)data, len);
+		return Void();
+	}
+	Future<Void> finish() override { return Void(); }
+	int64_t size() const override { return contents.size(); }
+	void addref() override { return ReferenceCounted<MemoryBackupFile>::addref(); }
+	void delref() override { return ReferenceCounted<MemoryBackupFile>::delref(); }
+
+	std::string contents;
+};
+} // namespace
+
+TEST_CASE("/backup/rangefile/compressed") {
+	int blockSize = deterministicRandom()->randomInt(16e3, 128e3);
+	int count = deterministicRandom()->randomInt(0, 20000);
+	Key begin = "key/"_sr;
+	Key end = "key0"_sr;
+	Standalone<VectorRef<KeyValueRef>> kvs;
+	for (int i = 0; i < count; i++) {
+		Key k(format("key/%08d", i * 3));
+		// Mix compressible and incompressible values
+		Value v(deterministicRandom()->coinflip()
+		            ? std::string(deterministicRandom()->randomInt(0, 500), 'v')
+		            : deterministicRandom()->randomAlphaNumeric(deterministicRandom()->randomInt(0, 200)));
+		kvs.push_back_deep(kvs.arena(), KeyValueRef(k, v));
+	}
+
+	Reference<MemoryBackupFile> file = makeReference<MemoryBackupFile>();
+	fileBackup::CompressedRangeFileWriter writer(file, blockSize);
+	co_await writer.writeKey(begin);
+	for (const auto& kv : kvs) {
+		co_await writer.writeKV(kv.key, kv.value);
+	}
+	co_await writer.writeKey(end);
+	co_await writer.finish();
+
+	// Every block must decode on its own, each one starting where the previous one ended
+	Standalone<StringRef> contents(file->contents);
+	int decoded = 0;
+	Key blockBegin = begin;
+	for (int64_t offset = 0; offset < contents.size(); offset += blockSize) {
+		int len = std::min<int64_t>(blockSize, contents.size() - offset);
+		Standalone<VectorRef<KeyValueRef>> block = fileBackup::decodeRangeFileBlock(contents.substr(offset, len));
+		ASSERT_GE(block.size(), 2);
+		ASSERT(block.front().key == blockBegin);
+		for (int i = 1; i < block.size() - 1; i++) {
+			ASSERT_LT(decoded, kvs.size());
+			ASSERT(block[i] == kvs[decoded]);
+			decoded++;
+		}
+		blockBegin = block.back().key;
+	}
+	ASSERT_EQ(decoded, kvs.size());
+	ASSERT(blockBegin == end);
+	printf("Compressed %d kv pairs into %d bytes with %d byte blocks\n", count, (int)contents.size(), blockSize);
+}
+
+TEST_CASE("/backup/logfile/compressed") {
+	int blockSize = deterministicRandom()->randomInt(16e3, 128e3);
+	int count = deterministicRandom()->randomInt(0, 5000);
+	std::vector<std::tuple<Version, uint32_t, Standalone<StringRef>>> messages;
+	Version version = deterministicRandom()->randomInt64(1, 1e9);
+	for (int i = 0; i < count; i++) {
+		version += deterministicRandom()->randomInt(0, 3);
+		int size = deterministicRandom()->randomInt(0, 2000);
+		Standalone<StringRef> message(deterministicRandom()->coinflip()
+		                                  ? std::string(size, 'm')
+		                                  : deterministicRandom()->randomAlphaNumeric(size / 4));
+		messages.emplace_back(version, i, message);
+	}
+
+	Reference<MemoryBackupFile> file = makeReference<MemoryBackupFile>();
+	auto writer = makeReference<fileBackup::CompressedMutationLogWriter>(file, blockSize);
+	for (const auto& [v, sub, message] : messages) {
+		co_await writer->addMessage(v, sub, message);
+	}
+	co_await writer->finish();
+
+	// Every block must decode on its own, and expand into uncompressed blocks holding the same entries
+	Standalone<StringRef> contents(file->contents);
+	int decoded = 0;
+	for (int64_t offset = 0; offset < contents.size(); offset += blockSize) {
+		int len = std::min<int64_t>(blockSize, contents.size() - offset);
+		StringRef block = contents.substr(offset, len);
+		Arena arena;
+		StringRef raw = fileBackup::decodePartitionedLogFileBlock(block, arena);
+		Optional<Standalone<StringRef>> expanded = fileBackup::expandPartitionedLogFileBlock(block, blockSize);
+		ASSERT(expanded.present());
+		ASSERT(!fileBackup::expandPartitionedLogFileBlock(expanded.get(), blockSize).present());
+
+		for (int64_t e = 0; e < expanded.get().size(); e += blockSize) {
+			StringRef sub = expanded.get().substr(e, std::min<int64_t>(blockSize, expanded.get().size() - e));
+			StringRefReader reader(fileBackup::decodePartitionedLogFileBlock(sub, arena), restore_corrupted_data());
+			while (!reader.eof() && *reader.rptr != 0xFF) {
+				ASSERT_LT(decoded, messages.size());
+				const auto& [v, subsequence, message] = messages[decoded];
+				ASSERT_EQ((Version)reader.consumeNetworkUInt64(), v);
+				ASSERT_EQ(reader.consumeNetworkUInt32(), subsequence);
+				uint32_t size = reader.consumeNetworkUInt32();
+				ASSERT(StringRef(reader.consume(size), size) == message);
+				decoded++;
+			}
+		}
+		ASSERT_GT(raw.size(), 0);
+	}
+	ASSERT_EQ(decoded, messages.size());
+	printf("Compressed %d log messages into %d bytes with %d byte blocks\n", count, (int)contents.size(), blockSize);
+}
@@ -100,6 +100,53 @@ ThreadFuture<Optional<Value>> DLTransaction::get(const KeyRef& key, bool snapsho
 	});
 }
 
+// Appends the present values of gets[index...] to result in key order as each of the reads becomes ready
+static ThreadFuture<RangeResult> collectGets(std::shared_ptr<std::vector<ThreadFuture<Optional<Value>>>> gets,
+                                             Standalone<VectorRef<KeyRef>> keys,
+                                             int index,
+                                             RangeResult result) {
+	if (index == (int)gets->size()) {
+		return result;
+	}
+
+	return flatMapThreadFuture<Optional<Value>, RangeResult>(
+	    (*gets)[index], [gets, keys, index, result](ErrorOr<Optional<Value>> value) mutable {
+		    if (value.isError()) {
+			    return ErrorOr<ThreadFuture<RangeResult>>(value.getError());
+		    }
+		    if (value.get().present()) {
+			    result.push_back_deep(result.arena(), KeyValueRef(keys[index], value.get().get()));
+		    }
+		    return ErrorOr<ThreadFuture<RangeResult>>(collectGets(gets, keys, index + 1, result));
+	    });
+}
+
+ThreadFuture<RangeResult> DLTransaction::getMultiple(const VectorRef<KeyRef>& keys, bool snapshot) {
+	if (!api->transactionGetMultiple) {
+		// Older client libraries take the reads one at a time, so issue them all before collecting the results
+		auto gets = std::make_shared<std::vector<ThreadFuture<Optional<Value>>>>();
+		gets->reserve(keys.size());
+		for (const auto& key : keys) {
+			gets->push_back(get(key, snapshot));
+		}
+		return collectGets(gets, Standalone<VectorRef<KeyRef>>(keys), 0, RangeResult());
+	}
+
+	FdbCApi::FDBFuture* f =
+	    api->transactionGetMultiple(tr, (const FdbCApi::FDBKey*)keys.begin(), keys.size(), snapshot);
+
+	return toThreadFuture<RangeResult>(api, f, [](FdbCApi::FDBFuture* f, FdbCApi* api) {
+		const FdbCApi::FDBKeyValue* kvs;
+		int count;
+		FdbCApi::fdb_bool_t more;
+		FdbCApi::fdb_error_t error = api->futureGetKeyValueArray(f, &kvs, &count, &more);
+		ASSERT(!error);
+
+		// The memory for this is stored in the FDBFuture and is released when the future gets destroyed
+		return RangeResult(RangeResultRef(VectorRef<KeyValueRef>((KeyValueRef*)kvs, count), more), Arena());
+	});
+}
+
 ThreadFuture<Key> DLTransaction::getKey(const KeySelectorRef& key, bool snapshot) {
 	FdbCApi::FDBFuture* f =
 	    api->transactionGetKey(tr, key.getKey().begin(), key.getKey().size(), key.orEqual, key.offset, snapshot);
@@ -139,7 +186,8 @@ ThreadFuture<RangeResult> DLTransaction::getRange(const KeySelectorRef& begin,
 	                                                 end.offset,
 	                                                 limits.rows,
 	                                                 limits.bytes,
-	                                                 FDB_STREAMING_MODE_EXACT,
+	                                                 limits.parallel ? FDB_STREAMING_MODE_PARALLEL
+	                                                                 : FDB_STREAMING_MODE_EXACT,
 	                                                 0,
 	                                                 snapshot,
 	                                                 reverse);
@@ -282,6 +330,18 @@ void DLTransaction::set(const KeyRef& key, const ValueRef& value) {
 	api->transactionSet(tr, key.begin(), key.size(), value.begin(), value.size());
 }
 
+void DLTransaction::setMultiple(const VectorRef<KeyValueRef>& keyValues) {
+	if (!api->transactionSetMultiple) {
+		// Older client libraries take the writes one at a time
+		for (const auto& kv : keyValues) {
+			set(kv.key, kv.value);
+		}
+		return;
+	}
+
+	api->transactionSetMultiple(tr, (const FdbCApi::FDBKeyValue*)keyValues.begin(), keyValues.size());
+}
+
 void DLTransaction::clear(const KeyRef& begin, const KeyRef& end) {
 	api->transactionClearRange(tr, begin.begin(), begin.size(), end.begin(), end.size());
 }
@@ -514,6 +574,16 @@ ThreadFuture<Standalone<StringRef>> DLDatabase::getClientStatus() {
 	});
 }
 
+ThreadFuture<Void> DLDatabase::warmLocationCache(const KeyRangeRef& keys) {
+	if (!api->databaseWarmLocationCache) {
+		return unsupported_operation();
+	}
+
+	FdbCApi::FDBFuture* f =
+	    api->databaseWarmLocationCache(db, keys.begin.begin(), keys.begin.size(), keys.end.begin(), keys.end.size());
+	return toThreadFuture<Void>(api, f, [](FdbCApi::FDBFuture* f, FdbCApi* api) { return Void(); });
+}
+
 // DLApi
 
 // Loads the specified function from a dynamic library
@@ -601,6 +671,11 @@ void DLApi::init() {
 	                   fdbCPath,
 	                   "fdb_database_get_client_status",
 	                   headerVersion >= ApiVersion::withGetClientStatus().version());
+	loadClientFunction(&api->databaseWarmLocationCache,
+	                   lib,
+	                   fdbCPath,
+	                   "fdb_database_warm_location_cache",
+	                   headerVersion >= ApiVersion::withWarmLocationCache().version());
 
 	loadClientFunction(&api->transactionSetOption, lib, fdbCPath, "fdb_transaction_set_option", headerVersion >= 0);
 	loadClientFunction(&api->transactionDestroy, lib, fdbCPath, "fdb_transaction_destroy", headerVersion >= 0);
@@ -609,6 +684,11 @@ void DLApi::init() {
 	loadClientFunction(
 	    &api->transactionGetReadVersion, lib, fdbCPath, "fdb_transaction_get_read_version", headerVersion >= 0);
 	loadClientFunction(&api->transactionGet, lib, fdbCPath, "fdb_transaction_get", headerVersion >= 0);
+	loadClientFunction(&api->transactionGetMultiple,
+	                   lib,
+	                   fdbCPath,
+	                   "fdb_transaction_get_multiple",
+	                   headerVersion >= ApiVersion::withMultipleKeyOperations().version());
 	loadClientFunction(&api->transactionGetKey, lib, fdbCPath, "fdb_transaction_get_key", headerVersion >= 0);
 	loadClientFunction(&api->transactionGetAddressesForKey,
 	                   lib,
@@ -621,6 +701,11 @@ void DLApi::init() {
 	loadClientFunction(
 	    &api->transactionGetVersionstamp, lib, fdbCPath, "fdb_transaction_get_versionstamp", headerVersion >= 410);
 	loadClientFunction(&api->transactionSet, lib, fdbCPath, "fdb_transaction_set", headerVersion >= 0);
+	loadClientFunction(&api->transactionSetMultiple,
+	                   lib,
+	                   fdbCPath,
+	                   "fdb_transaction_set_multiple",
+	                   headerVersion >= ApiVersion::withMultipleKeyOperations().version());
 	loadClientFunction(&api->transactionClear, lib, fdbCPath, "fdb_transaction_clear", headerVersion >= 0);
 	loadClientFunction(&api->transactionClearRange, lib, fdbCPath, "fdb_transaction_clear_range", headerVersion >= 0);
 	loadClientFunction(&api->transactionAtomicOp, lib, fdbCPath, "fdb_transaction_atomic_op", headerVersion >= 0);
@@ -933,6 +1018,10 @@ ThreadFuture<Optional<Value>> MultiVersionTransaction::get(const KeyRef& key, bo
 	return executeOperation(&ITransaction::get, key, std::forward<bool>(snapshot));
 }
 
+ThreadFuture<RangeResult> MultiVersionTransaction::getMultiple(const VectorRef<KeyRef>& keys, bool snapshot) {
+	return executeOperation(&ITransaction::getMultiple, keys, std::forward<bool>(snapshot));
+}
+
 ThreadFuture<Key> MultiVersionTransaction::getKey(const KeySelectorRef& key, bool snapshot) {
 	return executeOperation(&ITransaction::getKey, key, std::forward<bool>(snapshot));
 }
@@ -1038,6 +1127,13 @@ void MultiVersionTransaction::set(const KeyRef& key, const ValueRef& value) {
 	}
 }
 
+void MultiVersionTransaction::setMultiple(const VectorRef<KeyValueRef>& keyValues) {
+	auto tr = getTransaction();
+	if (tr.transaction) {
+		tr.transaction->setMultiple(keyValues);
+	}
+}
+
 void MultiVersionTransaction::clear(const KeyRef& begin, const KeyRef& end) {
 	auto tr = getTransaction();
 	if (tr.transaction) {
@@ -1437,6 +1533,10 @@ ThreadFuture<Void> MultiVersionDatabase::createSnapshot(const StringRef& uid, co
 	return executeOperation(&IDatabase::createSnapshot, uid, snapshot_command);
 }
 
+ThreadFuture<Void> MultiVersionDatabase::warmLocationCache(const KeyRangeRef& keys) {
+	return executeOperation(&IDatabase::warmLocationCache, keys);
+}
+
 ThreadFuture<DatabaseSharedState*> MultiVersionDatabase::createSharedState() {
 	return executeOperation(&IDatabase::createSharedState);
 }
@@ -68,6 +68,7 @@
 #include "fdbclient/TransactionLineage.h"
 #include "fdbclient/versions.h"
 #include "fdbrpc/WellKnownEndpoints.h"
+#include "fdbrpc/IAsyncFile.h"
 #include "fdbrpc/LoadBalance.h"
 #include "fdbrpc/Net2FileSystem.h"
 #include "fdbrpc/simulator.h"
@@ -321,6 +322,10 @@ void DatabaseContext::setOption(FDBDatabaseOptions::Option option, Optional<Stri
 		case FDBDatabaseOptions::LOCATION_CACHE_SIZE:
 			locationCacheSize = (int)extractIntOption(value, 0, std::numeric_limits<int>::max());
 			break;
+		case FDBDatabaseOptions::LOCATION_CACHE_SNAPSHOT_FILE:
+			validateOptionValuePresent(value);
+			locationCacheSnapshotter = maintainLocationCacheSnapshot(value.get().toString());
+			break;
 		case FDBDatabaseOptions::MACHINE_ID:
 			clientLocality =
 			    LocalityData(clientLocality.processId(),
@@ -1285,8 +1290,10 @@ Future<KeyRangeLocationInfo> getKeyLocation(Database const& cx,
 	// we first check whether this range is cached
 	Optional<KeyRangeLocationInfo> locationInfo = cx->getCachedLocation(key, isBackward);
 	if (!locationInfo.present()) {
+		++cx->locationCacheMisses;
 		return getKeyLocation_internal(cx, key, spanContext, debugID, useProvisionalProxies, isBackward, version);
 	}
+	++cx->locationCacheHits;
 
 	bool onlyEndpointFailedAndNeedRefresh = false;
 	for (int i = 0; i < locationInfo.get().locations->size(); i++) {
@@ -1429,9 +1436,11 @@ Future<std::vector<KeyRangeLocationInfo>> getKeyRangeLocations(Database const& c
 
 	std::vector<KeyRangeLocationInfo> locations;
 	if (!cx->getCachedLocations(keys, locations, limit, reverse)) {
+		++cx->locationCacheMisses;
 		return getKeyRangeLocations_internal(
 		    cx, keys, limit, reverse, spanContext, debugID, useProvisionalProxies, version);
 	}
+	++cx->locationCacheHits;
 
 	bool foundFailed = false;
 	for (const auto& locationInfo : locations) {
@@ -1483,6 +1492,18 @@ ACTOR Future<Void> warmRange_impl(Reference<TransactionState> trState, KeyRange
 	wait(trState->startTransaction());
 
 	loop {
+		// Skip over the shards at the start of the range that are already cached
+		loop {
+			Optional<KeyRangeLocationInfo> cached = trState->cx->getCachedLocation(keys.begin);
+			if (!cached.present()) {
+				break;
+			}
+			if (cached.get().range.end >= keys.end) {
+				return Void();
+			}
+			keys = KeyRangeRef(cached.get().range.end, keys.end);
+		}
+
 		std::vector<KeyRangeLocationInfo> locations = wait(getKeyRangeLocations_internal(
 		    trState->cx,
 		    keys,
@@ -1492,7 +1513,7 @@ ACTOR Future<Void> warmRange_impl(Reference<TransactionState> trState, KeyRange
 		    trState->readOptions.present() ? trState->readOptions.get().debugID : Optional<UID>(),
 		    trState->useProvisionalProxies,
 		    trState->readVersion()));
-		totalRanges += CLIENT_KNOBS->WARM_RANGE_SHARD_LIMIT;
+		totalRanges += locations.size();
 		totalRequests++;
 		if (locations.size() == 0 || totalRanges >= trState->cx->locationCacheSize ||
 		    locations[locations.size() - 1].range.end >= keys.end)
@@ -3044,6 +3065,7 @@ ACTOR Future<Void> getRangeStreamImpl(Reference<TransactionState> trState,
 			req.limit = reverse ? -CLIENT_KNOBS->REPLY_BYTE_LIMIT : CLIENT_KNOBS->REPLY_BYTE_LIMIT;
 			req.limitBytes = std::numeric_limits<int>::max();
 			req.options = trState->readOptions;
+			req.exportWindowBytes = trState->options.rangeStreamExportWindow;
 
 			trState->cx->getLatestCommitVersions(locations[shard].locations, trState, req.ssLatestCommitVersions);
 
@@ -3122,6 +3144,9 @@ ACTOR Future<Void> getRangeStreamImpl(Reference<TransactionState> trState,
 				    &locations[shard].locations->get(useIdx, &StorageServerInterface::getKeyValuesStream));
 
 				state bool breakAgain = false;
+				// Set while the last reply from this stream had more data in the shard
+				state bool replyMore = false;
+				state bool restartShard = false;
 				loop {
 					wait(results.onEmpty());
 					try {
@@ -3153,8 +3178,18 @@ ACTOR Future<Void> getRangeStreamImpl(Reference<TransactionState> trState,
 							}
 							throw;
 						}
+						// The storage server ends the stream once the request's row limit is used up, even if the
+						// shard has more data. Continue with a new request from the last key returned.
+						restartShard = replyMore;
 						rep = GetKeyValuesStreamReply();
 					}
+					if (restartShard) {
+						CODE_PROBE(true, "getRangeStream restarts a shard after the row limit");
+						if (tssDuplicateStream.present() && !tssDuplicateStream.get().done()) {
+							tssDuplicateStream.get().stream.sendError(end_of_stream());
+						}
+						break;
+					}
 					if (trState->readOptions.present() && trState->readOptions.get().debugID.present())
 						g_traceBatch.addEvent("TransactionDebug",
 						                      trState->readOptions.get().debugID.get().first(),
@@ -3256,6 +3291,7 @@ ACTOR Future<Void> getRangeStreamImpl(Reference<TransactionState> trState,
 					if (keys.end == allKeys.end && reverse) {
 						output.readThroughEnd = true;
 					}
+					replyMore = true;
 					results.send(std::move(output));
 				}
 				if (breakAgain) {
@@ -3647,6 +3683,162 @@ Future<Key> Transaction::getKey(const KeySelector& key, Snapshot snapshot) {
 	return getKeyAndConflictRange(trState, key, conflictRange);
 }
 
+static Future<GetKeyValuesReply> getRangeParallelShard(Reference<TransactionState> trState,
+                                                       Reference<LocationInfo> locations,
+                                                       GetKeyValuesRequest req) {
+	++trState->cx->transactionPhysicalReads;
+	try {
+		GetKeyValuesReply rep =
+		    co_await loadBalance(trState->cx.getPtr(),
+		                         locations,
+		                         &StorageServerInterface::getKeyValues,
+		                         req,
+		                         TaskPriority::DefaultPromiseEndpoint,
+		                         AtMostOnce::False,
+		                         trState->cx->enableLocalityLoadBalance ? &trState->cx->queueModel : nullptr,
+		                         trState->options.enableReplicaConsistencyCheck,
+		                         trState->options.requiredReplicas);
+		++trState->cx->transactionPhysicalReadsCompleted;
+		co_return rep;
+	} catch (Error&) {
+		++trState->cx->transactionPhysicalReadsCompleted;
+		throw;
+	}
+}
+
+static GetKeyValuesRequest getRangeParallelRequest(Reference<TransactionState> const& trState,
+                                                   SpanContext spanContext,
+                                                   KeyRangeLocationInfo const& location,
+                                                   KeyRef begin,
+                                                   KeyRef end,
+                                                   GetRangeLimits limits) {
+	GetKeyValuesRequest req;
+	req.version = trState->readVersion();
+	req.begin = firstGreaterOrEqual(KeyRef(req.arena, begin));
+	req.end = firstGreaterOrEqual(KeyRef(req.arena, end));
+	transformRangeLimits(limits, Reverse::False, req);
+	req.tags = trState->cx->sampleReadTags() ? trState->options.readTags : Optional<TagSet>();
+	req.options = trState->readOptions;
+	req.taskID = trState->taskID;
+	req.spanContext = spanContext;
+	trState->cx->getLatestCommitVersions(location.locations, trState, req.ssLatestCommitVersions);
+	return req;
+}
+
+// getRange for FDB_STREAMING_MODE_PARALLEL: requests up to GET_RANGE_PARALLEL_SHARDS shards of keys at once and
+// consumes the replies in key order. A shard whose reply hit the per-reply byte limit is continued while the replies
+// of the following shards wait, so they are used rather than re-read. Each reply holds at most REPLY_BYTE_LIMIT bytes,
+// which bounds the memory of a batch. Callers that cap the byte limit of a request, like ReadYourWrites, leave room
+// for a full batch in parallel mode.
+static Future<RangeResult> getRangeParallel(Reference<TransactionState> trState,
+                                            KeyRange keys,
+                                            GetRangeLimits limits,
+                                            Promise<std::pair<Key, Key>> conflictRange,
+                                            Snapshot snapshot) {
+	KeySelector originalBegin(firstGreaterOrEqual(keys.begin), keys.arena());
+	KeySelector originalEnd(firstGreaterOrEqual(keys.end), keys.arena());
+	RangeResult output;
+	Span span("NAPI:getRangeParallel"_loc, trState->spanContext);
+
+	co_await trState->startTransaction();
+	trState->cx->validateVersion(trState->readVersion());
+	double startTime = now();
+	output.readToBegin = keys.begin == allKeys.begin;
+
+	while (true) {
+		std::vector<KeyRangeLocationInfo> locations =
+		    co_await getKeyRangeLocations(trState,
+		                                  keys,
+		                                  CLIENT_KNOBS->GET_RANGE_PARALLEL_SHARDS,
+		                                  Reverse::False,
+		                                  &StorageServerInterface::getKeyValues);
+		ASSERT(locations.size());
+		++trState->cx->transactionGetRangeParallelBatches;
+		trState->cx->transactionGetRangeParallelShardRequests += locations.size();
+
+		std::vector<Future<GetKeyValuesReply>> replies;
+		for (const auto& location : locations) {
+			GetKeyValuesRequest req = getRangeParallelRequest(trState,
+			                                                  span.context,
+			                                                  location,
+			                                                  std::max(location.range.begin, keys.begin),
+			                                                  std::min(location.range.end, keys.end),
+			                                                  limits);
+			replies.push_back(getRangeParallelShard(trState, location.locations, req));
+		}
+
+		bool finished = false;
+		bool batchComplete = true;
+		for (int i = 0; i < replies.size() && !finished && batchComplete; i++) {
+			Key shardEnd = std::min(locations[i].range.end, keys.end);
+			while (true) {
+				GetKeyValuesReply rep;
+				Error err;
+				try {
+					GetKeyValuesReply _rep = co_await replies[i];
+					rep = _rep;
+				} catch (Error& e) {
+					if (e.code() != error_code_wrong_shard_server && e.code() != error_code_all_alternatives_failed) {
+						throw;
+					}
+					err = e;
+				}
+				if (err.isValid()) {
+					// keys.begin is the first unread key of this shard; the following replies are dropped and
+					// re-requested
+					CODE_PROBE(true, "Parallel getRange shard moved");
+					trState->cx->invalidateCache(keys);
+					co_await delay(CLIENT_KNOBS->WRONG_SHARD_SERVER_DELAY, trState->taskID);
+					batchComplete = false;
+					break;
+				}
+
+				ASSERT(!rep.more || rep.data.size());
+				int rows = limits.hasRowLimit() ? std::min(rep.data.size(), limits.rows) : rep.data.size();
+				VectorRef<KeyValueRef> data(rep.data.begin(), rows);
+				output.arena().dependsOn(rep.arena);
+				output.append(output.arena(), data.begin(), data.size());
+				limits.decrement(data);
+
+				if (limits.isReached() || rows < rep.data.size()) {
+					output.more = true;
+					finished = true;
+				} else if (rep.more) {
+					// The reply stopped at the byte limit of a single reply, so continue this shard
+					CODE_PROBE(true, "Parallel getRange continues a shard");
+					keys = KeyRange(KeyRangeRef(keyAfter(rep.data.back().key), keys.end));
+					replies[i] = getRangeParallelShard(
+					    trState,
+					    locations[i].locations,
+					    getRangeParallelRequest(trState, span.context, locations[i], keys.begin, shardEnd, limits));
+					continue;
+				} else if (shardEnd == keys.end) {
+					output.more = false;
+					finished = true;
+				} else {
+					keys = KeyRange(KeyRangeRef(shardEnd, keys.end));
+				}
+				break;
+			}
+		}
+
+		// Soft byte limit - once a complete batch satisfies the caller's minimum, return it and read through the
+		// last shard boundary
+		if (!finished && batchComplete && limits.hasSatisfiedMinRows() && output.size() > 0) {
+			output.more = true;
+			output.arena().dependsOn(keys.arena());
+			output.setReadThrough(keys.begin);
+			finished = true;
+		}
+
+		if (finished) {
+			getRangeFinished(
+			    trState, startTime, originalBegin, originalEnd, snapshot, conflictRange, Reverse::False, output);
+			co_return output;
+		}
+	}
+}
+
 template <class GetKeyValuesFamilyRequest>
 void increaseCounterForRequest(Database cx) {
 	if constexpr (std::is_same<GetKeyValuesFamilyRequest, GetKeyValuesRequest>::value) {
@@ -3704,6 +3896,12 @@ Future<RangeResultFamily> Transaction::getRangeInternal(const KeySelector& begin
 		extraConflictRanges.push_back(conflictRange.getFuture());
 	}
 
+	if constexpr (std::is_same_v<GetKeyValuesFamilyRequest, GetKeyValuesRequest>) {
+		if (limits.parallel && !reverse && b.isFirstGreaterOrEqual() && e.isFirstGreaterOrEqual()) {
+			return getRangeParallel(trState, KeyRangeRef(b.getKey(), e.getKey()), limits, conflictRange, snapshot);
+		}
+	}
+
 	return ::getRange<GetKeyValuesFamilyRequest, GetKeyValuesFamilyReply, RangeResultFamily>(
 	    trState, b, e, mapper, limits, conflictRange, snapshot, reverse);
 }
@@ -4019,6 +4217,7 @@ void TransactionOptions::clear() {
 	bypassStorageQuota = false;
 	enableReplicaConsistencyCheck = false;
 	requiredReplicas = 0;
+	rangeStreamExportWindow = 0;
 }
 
 TransactionOptions::TransactionOptions() {
@@ -5014,6 +5213,12 @@ void Transaction::setOption(FDBTransactionOptions::Option option, Optional<Strin
 	case FDBTransactionOptions::CONSISTENCY_CHECK_REQUIRED_REPLICAS:
 		validateOptionValuePresent(value);
 		trState->options.requiredReplicas = extractIntOption(value, -2, std::numeric_limits<int64_t>::max());
+		break;
+
+	case FDBTransactionOptions::RANGE_STREAM_EXPORT_WINDOW:
+		validateOptionValuePresent(value);
+		trState->options.rangeStreamExportWindow = extractIntOption(value, 0, std::numeric_limits<int64_t>::max());
+		break;
 
 	default:
 		break;
@@ -5833,6 +6038,57 @@ Future<Standalone<VectorRef<ReadHotRangeWithMetrics>>> getReadHotRanges(Database
 	}
 }
 
+Future<std::vector<std::pair<KeyRange, Version>>> getRangeModifiedVersions(Database cx,
+                                                                          KeyRange keys,
+                                                                          Version version) {
+	Span span("NAPI:GetRangeModifiedVersions"_loc);
+	std::vector<std::pair<KeyRange, Version>> results;
+	Key begin = keys.begin;
+	while (begin < keys.end) {
+		KeyRange remaining(KeyRangeRef(begin, keys.end));
+		std::vector<KeyRangeLocationInfo> locations =
+		    co_await getKeyRangeLocations(cx,
+		                                  remaining,
+		                                  CLIENT_KNOBS->STORAGE_METRICS_SHARD_LIMIT,
+		                                  Reverse::False,
+		                                  &StorageServerInterface::getRangeModifiedVersions,
+		                                  span.context,
+		                                  Optional<UID>(),
+		                                  UseProvisionalProxies::False,
+		                                  latestVersion);
+		Error err;
+		try {
+			int nLocs = locations.size();
+			std::vector<Future<RangeModifiedVersionsReply>> fReplies(nLocs);
+			for (int i = 0; i < nLocs; i++) {
+				RangeModifiedVersionsRequest req(locations[i].range & remaining, version);
+				fReplies[i] = loadBalance(locations[i].locations->locations(),
+				                          &StorageServerInterface::getRangeModifiedVersions,
+				                          req,
+				                          TaskPriority::DefaultPromiseEndpoint);
+			}
+
+			co_await waitForAll(fReplies);
+
+			for (int i = 0; i < nLocs; i++) {
+				const auto& shards = fReplies[i].get().shards;
+				results.insert(results.end(), shards.begin(), shards.end());
+			}
+			begin = std::min(keys.end, locations.back().range.end);
+			continue;
+		} catch (Error& e) {
+			err = e;
+		}
+		if (err.code() != error_code_wrong_shard_server && err.code() != error_code_all_alternatives_failed) {
+			TraceEvent(SevWarn, "GetRangeModifiedVersionsError").error(err);
+			throw err;
+		}
+		cx->invalidateCache(remaining);
+		co_await delay(CLIENT_KNOBS->WRONG_SHARD_SERVER_DELAY, TaskPriority::DataDistribution);
+	}
+	co_return results;
+}
+
 Future<Optional<StorageMetrics>> waitStorageMetricsWithLocation(Version version,
                                                                 KeyRange keys,
                                                                 std::vector<KeyRangeLocationInfo> locations,
@@ -5970,6 +6226,11 @@ Future<Standalone<VectorRef<ReadHotRangeWithMetrics>>> DatabaseContext::getReadH
 	return ::getReadHotRanges(Database(Reference<DatabaseContext>::addRef(this)), keys);
 }
 
+Future<std::vector<std::pair<KeyRange, Version>>> DatabaseContext::getRangeModifiedVersions(KeyRange const& keys,
+                                                                                          Version version) {
+	return ::getRangeModifiedVersions(Database(Reference<DatabaseContext>::addRef(this)), keys, version);
+}
+
 ACTOR Future<Standalone<VectorRef<KeyRef>>> getRangeSplitPoints(Reference<TransactionState> trState,
                                                                 KeyRange keys,
                                                                 int64_t chunkSize) {
@@ -6723,6 +6984,287 @@ Future<Void> DatabaseContext::createSnapshot(StringRef uid, StringRef snapshot_c
 	return createSnapshotActor(this, UID::fromString(uid_str), snapshot_command);
 }
 
+static Future<Void> warmLocationCacheActor(Database cx, KeyRange keys) {
+	Transaction tr(cx);
+	while (true) {
+		Error err;
+		try {
+			tr.setOption(FDBTransactionOptions::LOCK_AWARE);
+			co_await tr.warmRange(keys);
+			co_return;
+		} catch (Error& e) {
+			err = e;
+		}
+		co_await tr.onError(err);
+	}
+}
+
+Future<Void> DatabaseContext::warmLocationCache(KeyRange keys) {
+	return warmLocationCacheActor(Database(Reference<DatabaseContext>::addRef(this)), keys);
+}
+
+// Contents of the location_cache_snapshot_file database option
+struct LocationCacheSnapshot {
+	constexpr static FileIdentifier file_identifier = 4120887;
+
+	Key clusterKey;
+	std::vector<StorageServerInterface> servers;
+	std::vector<KeyRange> ranges;
+	// For each range, the number of servers holding it followed by their indexes in servers
+	std::vector<int> teams;
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, clusterKey, servers, ranges, teams);
+	}
+};
+
+// Adds the ranges of snapshot to the location cache, unless it was saved for another cluster. Returns the number of
+// ranges restored.
+static Future<int> applyLocationCacheSnapshot(DatabaseContext* cx, LocationCacheSnapshot snapshot, Key clusterKey) {
+	if (snapshot.clusterKey != clusterKey) {
+		TraceEvent("LocationCacheSnapshotClusterMismatch");
+		co_return 0;
+	}
+
+	// Entries that are stale by now are refreshed by the usual wrong_shard_server and failed endpoint handling
+	int team = 0;
+	int restored = 0;
+	std::vector<StorageServerInterface> servers;
+	for (int i = 0; i < snapshot.ranges.size() && cx->locationCache.size() < cx->locationCacheSize; i++) {
+		if (team >= snapshot.teams.size() || team + snapshot.teams[team] >= snapshot.teams.size()) {
+			throw io_error();
+		}
+		servers.clear();
+		for (int s = 0; s < snapshot.teams[team]; s++) {
+			int index = snapshot.teams[team + 1 + s];
+			if (index < 0 || index >= snapshot.servers.size()) {
+				throw io_error();
+			}
+			servers.push_back(snapshot.servers[index]);
+		}
+		team += 1 + snapshot.teams[team];
+
+		// Locations fetched since startup are newer than the snapshot
+		bool cached = false;
+		for (auto r : cx->locationCache.intersectingRanges(snapshot.ranges[i])) {
+			cached = cached || r.value();
+		}
+		if (!cached && !servers.empty()) {
+			cx->setCachedLocation(snapshot.ranges[i], servers);
+			restored++;
+		}
+		if (i % 100 == 99) {
+			co_await yield();
+		}
+	}
+	co_return restored;
+}
+
+static Future<Void> restoreLocationCacheSnapshot(DatabaseContext* cx, std::string path, Key clusterKey) {
+	if (!fileExists(path)) {
+		co_return;
+	}
+
+	Reference<IAsyncFile> f = co_await IAsyncFileSystem::filesystem()->open(
+	    path, IAsyncFile::OPEN_NO_AIO | IAsyncFile::OPEN_READONLY | IAsyncFile::OPEN_UNCACHED, 0);
+	int64_t size = co_await f->size();
+	Standalone<StringRef> buf = makeString(size);
+	int bytesRead = co_await uncancellable(holdWhile(buf, f->read(mutateString(buf), size, 0)));
+	if (bytesRead != size) {
+		throw io_error();
+	}
+
+	LocationCacheSnapshot snapshot = ObjectReader::fromStringRef<LocationCacheSnapshot>(buf, IncludeVersion());
+	int restored = co_await applyLocationCacheSnapshot(cx, snapshot, clusterKey);
+	TraceEvent("LocationCacheSnapshotRestored")
+	    .detail("Path", path)
+	    .detail("Ranges", restored)
+	    .detail("Servers", snapshot.servers.size());
+}
+
+static LocationCacheSnapshot getLocationCacheSnapshot(DatabaseContext* cx, Key clusterKey) {
+	LocationCacheSnapshot snapshot;
+	snapshot.clusterKey = clusterKey;
+	std::unordered_map<UID, int> serverIndex;
+	for (auto r : cx->locationCache.ranges()) {
+		if (!r.value()) {
+			continue;
+		}
+		snapshot.ranges.push_back(r.range());
+		snapshot.teams.push_back(r.value()->size());
+		for (int i = 0; i < r.value()->size(); i++) {
+			const StorageServerInterface& interf = r.value()->getInterface(i);
+			auto [it, inserted] = serverIndex.try_emplace(interf.id(), snapshot.servers.size());
+			if (inserted) {
+				snapshot.servers.push_back(interf);
+			}
+			snapshot.teams.push_back(it->second);
+		}
+	}
+	return snapshot;
+}
+
+static Future<Void> saveLocationCacheSnapshot(DatabaseContext* cx, std::string path, Key clusterKey) {
+	LocationCacheSnapshot snapshot = getLocationCacheSnapshot(cx, clusterKey);
+	Standalone<StringRef> data = ObjectWriter::toValue(snapshot, IncludeVersion());
+	Reference<IAsyncFile> f = co_await IAsyncFileSystem::filesystem()->open(
+	    path, IAsyncFile::OPEN_ATOMIC_WRITE_AND_CREATE | IAsyncFile::OPEN_READWRITE | IAsyncFile::OPEN_CREATE, 0600);
+	co_await uncancellable(holdWhile(data, f->write(data.begin(), data.size(), 0)));
+	co_await f->sync();
+	TraceEvent("LocationCacheSnapshotSaved")
+	    .detail("Path", path)
+	    .detail("Ranges", snapshot.ranges.size())
+	    .detail("Bytes", data.size());
+}
+
+Future<Void> DatabaseContext::maintainLocationCacheSnapshot(std::string path) {
+	if (!getConnectionRecord()) {
+		co_return;
+	}
+	try {
+		co_await restoreLocationCacheSnapshot(this, path, getConnectionRecord()->getConnectionString().clusterKey());
+	} catch (Error& e) {
+		if (e.code() == error_code_actor_cancelled) {
+			throw;
+		}
+		TraceEvent(SevWarn, "LocationCacheSnapshotRestoreFailed").error(e).detail("Path", path);
+	}
+
+	while (true) {
+		co_await delay(CLIENT_KNOBS->LOCATION_CACHE_SNAPSHOT_INTERVAL);
+		try {
+			co_await saveLocationCacheSnapshot(this, path, getConnectionRecord()->getConnectionString().clusterKey());
+		} catch (Error& e) {
+			if (e.code() == error_code_actor_cancelled) {
+				throw;
+			}
+			TraceEvent(SevWarn, "LocationCacheSnapshotSaveFailed").suppressFor(60).error(e).detail("Path", path);
+		}
+	}
+}
+
+namespace {
+
+Database createLocationCacheTestDatabase() {
+	return DatabaseContext::create(
+	    makeReference<AsyncVar<ClientDBInfo>>(), Never(), LocalityData(), EnableLocalityLoadBalance::False);
+}
+
+// Ids of the servers cached for key, or an empty set if it is not cached
+std::set<UID> cachedServers(Database cx, KeyRef key) {
+	std::set<UID> ids;
+	Optional<KeyRangeLocationInfo> cached = cx->getCachedLocation(key);
+	if (cached.present()) {
+		for (int i = 0; i < cached.get().locations->size(); i++) {
+			ids.insert(cached.get().locations->getInterface(i).id());
+		}
+	}
+	return ids;
+}
+
+} // namespace
+
+TEST_CASE("/fdbclient/NativeAPI/locationCacheSnapshot/saveAndRestore") {
+	state Key clusterKey = "test:0123abcd"_sr;
+	state std::string path = joinPath(params.getDataDir(), "locationCacheSnapshot");
+	state std::vector<StorageServerInterface> servers;
+	for (int i = 0; i < 3; i++) {
+		servers.push_back(StorageServerInterface(UID(i + 1, 0)));
+	}
+	state Database source = createLocationCacheTestDatabase();
+	source->setCachedLocation(KeyRangeRef("a"_sr, "m"_sr), { servers[0], servers[1] });
+	source->setCachedLocation(KeyRangeRef("m"_sr, "t"_sr), { servers[1], servers[2] });
+
+	// The file format round trips, with each server stored once
+	LocationCacheSnapshot snapshot = getLocationCacheSnapshot(source.getPtr(), clusterKey);
+	LocationCacheSnapshot decoded = ObjectReader::fromStringRef<LocationCacheSnapshot>(
+	    ObjectWriter::toValue(snapshot, IncludeVersion()), IncludeVersion());
+	ASSERT(decoded.clusterKey == clusterKey);
+	ASSERT(decoded.ranges == snapshot.ranges);
+	ASSERT(decoded.teams == snapshot.teams);
+	ASSERT_EQ(decoded.ranges.size(), 2);
+	ASSERT_EQ(decoded.servers.size(), 3);
+	ASSERT_EQ(decoded.teams.size(), 6);
+
+	wait(saveLocationCacheSnapshot(source.getPtr(), path, clusterKey));
+	state Database restored = createLocationCacheTestDatabase();
+	wait(restoreLocationCacheSnapshot(restored.getPtr(), path, clusterKey));
+	ASSERT(cachedServers(restored, "b"_sr) == std::set<UID>({ servers[0].id(), servers[1].id() }));
+	ASSERT(cachedServers(restored, "n"_sr) == std::set<UID>({ servers[1].id(), servers[2].id() }));
+	ASSERT(cachedServers(restored, "u"_sr).empty());
+
+	// A snapshot of another cluster is ignored
+	state Database otherCluster = createLocationCacheTestDatabase();
+	wait(restoreLocationCacheSnapshot(otherCluster.getPtr(), path, "other:0123abcd"_sr));
+	ASSERT(cachedServers(otherCluster, "b"_sr).empty());
+	ASSERT(cachedServers(otherCluster, "n"_sr).empty());
+
+	// Locations cached since startup are newer than the stale interfaces in the snapshot, which only fills the rest
+	state Database fresh = createLocationCacheTestDatabase();
+	fresh->setCachedLocation(KeyRangeRef("c"_sr, "e"_sr), { servers[2] });
+	wait(restoreLocationCacheSnapshot(fresh.getPtr(), path, clusterKey));
+	ASSERT(cachedServers(fresh, "d"_sr) == std::set<UID>({ servers[2].id() }));
+	ASSERT(cachedServers(fresh, "b"_sr).empty());
+	ASSERT(cachedServers(fresh, "n"_sr) == std::set<UID>({ servers[1].id(), servers[2].id() }));
+
+	// A missing file restores nothing
+	deleteFile(path);
+	state Database empty = createLocationCacheTestDatabase();
+	wait(restoreLocationCacheSnapshot(empty.getPtr(), path, clusterKey));
+	ASSERT(cachedServers(empty, "b"_sr).empty());
+	return Void();
+}
+
+TEST_CASE("/fdbclient/NativeAPI/locationCacheSnapshot/teamBounds") {
+	state Key clusterKey = "test:0123abcd"_sr;
+	state Database cx = createLocationCacheTestDatabase();
+	state LocationCacheSnapshot snapshot;
+	snapshot.clusterKey = clusterKey;
+	snapshot.servers.push_back(StorageServerInterface(UID(1, 0)));
+	snapshot.ranges = { KeyRangeRef("a"_sr, "b"_sr), KeyRangeRef("b"_sr, "c"_sr) };
+	state std::vector<std::vector<int>> corrupt = {
+		{ 1, 0, 1, 1 }, // Server index past the end
+		{ 1, 0, 1, -1 }, // Negative server index
+		{ 1, 0, 2, 0 }, // Team longer than the rest of the list
+		{ 1, 0 }, // Range without a team
+	};
+	state int i = 0;
+	for (; i < corrupt.size(); i++) {
+		snapshot.teams = corrupt[i];
+		try {
+			wait(success(applyLocationCacheSnapshot(cx.getPtr(), snapshot, clusterKey)));
+			ASSERT(false);
+		} catch (Error& e) {
+			ASSERT_EQ(e.code(), error_code_io_error);
+		}
+	}
+
+	snapshot.teams = { 1, 0, 1, 0 };
+	int restored = wait(applyLocationCacheSnapshot(createLocationCacheTestDatabase().getPtr(), snapshot, clusterKey));
+	ASSERT_EQ(restored, 2);
+	return Void();
+}
+
+TEST_CASE("/fdbclient/NativeAPI/warmRange/skipCached") {
+	state Database cx = createLocationCacheTestDatabase();
+	cx->setCachedLocation(KeyRangeRef("a"_sr, "m"_sr), { StorageServerInterface(UID(1, 0)) });
+	cx->setCachedLocation(KeyRangeRef("m"_sr, "z"_sr), { StorageServerInterface(UID(2, 0)) });
+
+	// Every shard of the range is cached, so nothing is requested from the commit proxies, which this database lacks
+	state Transaction tr(cx);
+	tr.setVersion(1);
+	wait(tr.warmRange(KeyRangeRef("b"_sr, "z"_sr)));
+
+	// Past the cached shards the locations have to be requested
+	state Transaction uncached(cx);
+	uncached.setVersion(1);
+	state Future<Void> warm = uncached.warmRange(KeyRangeRef("b"_sr, "zz"_sr));
+	wait(delay(0.1));
+	ASSERT(!warm.isReady());
+	return Void();
+}
+
 void sharedStateDelRef(DatabaseSharedState* ssPtr) {
 	if (--ssPtr->refCount == 0) {
 		delete ssPtr;
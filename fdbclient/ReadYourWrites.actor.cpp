@@ -584,8 +584,10 @@ public:
 				                  (int64_t)std::numeric_limits<int>::max());
 			}
 		} else if (requestLimit.hasByteLimit()) {
-			requestLimit.bytes = std::min(int64_t(requestLimit.bytes) << std::min(requestCount, 20),
-			                              (int64_t)CLIENT_KNOBS->REPLY_BYTE_LIMIT);
+			// A parallel read fills one reply per shard it reads at once
+			int64_t maxBytes = (int64_t)CLIENT_KNOBS->REPLY_BYTE_LIMIT *
+			                   (requestLimit.parallel ? CLIENT_KNOBS->GET_RANGE_PARALLEL_SHARDS : 1);
+			requestLimit.bytes = std::min(int64_t(requestLimit.bytes) << std::min(requestCount, 20), maxBytes);
 		}
 	}
 
@@ -1684,6 +1686,33 @@ Future<Optional<Value>> ReadYourWritesTransaction::get(const Key& key, Snapshot
 	return result;
 }
 
+static Future<RangeResult> getMultipleValues(Standalone<VectorRef<KeyRef>> keys,
+                                             std::vector<Future<Optional<Value>>> values) {
+	co_await waitForAll(values);
+	RangeResult result;
+	result.arena().dependsOn(keys.arena());
+	for (int i = 0; i < keys.size(); i++) {
+		const Optional<Value>& value = values[i].get();
+		if (value.present()) {
+			result.arena().dependsOn(value.get().arena());
+			result.push_back(result.arena(), KeyValueRef(keys[i], value.get()));
+		}
+	}
+	co_return result;
+}
+
+// All of the reads are issued before waiting on any of them, so keys that are not in the cache are read from the
+// storage servers concurrently
+Future<RangeResult> ReadYourWritesTransaction::getMultiple(const Standalone<VectorRef<KeyRef>>& keys,
+                                                           Snapshot snapshot) {
+	std::vector<Future<Optional<Value>>> values;
+	values.reserve(keys.size());
+	for (const auto& key : keys) {
+		values.push_back(get(Key(key, keys.arena()), snapshot));
+	}
+	return getMultipleValues(keys, std::move(values));
+}
+
 Future<Key> ReadYourWritesTransaction::getKey(const KeySelector& key, Snapshot snapshot) {
 	if (checkUsedDuringCommit()) {
 		return used_during_commit();
@@ -2280,6 +2309,12 @@ void ReadYourWritesTransaction::set(const KeyRef& key, const ValueRef& value) {
 	RYWImpl::triggerWatches(this, key, value);
 }
 
+void ReadYourWritesTransaction::setMultiple(const VectorRef<KeyValueRef>& keyValues) {
+	for (const auto& kv : keyValues) {
+		set(kv.key, kv.value);
+	}
+}
+
 void ReadYourWritesTransaction::clear(const KeyRangeRef& range) {
 	AddConflictRange addWriteConflict{ !options.getAndResetWriteConflictDisabled() };
 
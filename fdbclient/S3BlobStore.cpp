@@ -123,6 +123,9 @@ S3BlobStoreEndpoint::BlobKnobs::BlobKnobs() {
 	sdk_auth = false;
 	enable_object_integrity_check = CLIENT_KNOBS->BLOBSTORE_ENABLE_OBJECT_INTEGRITY_CHECK;
 	global_connection_pool = CLIENT_KNOBS->BLOBSTORE_GLOBAL_CONNECTION_POOL;
+	max_idle_connection_time = CLIENT_KNOBS->BLOBSTORE_MAX_IDLE_CONNECTION_TIME;
+	prewarm_connections = CLIENT_KNOBS->BLOBSTORE_PREWARM_CONNECTIONS;
+	adaptive_concurrency = CLIENT_KNOBS->BLOBSTORE_ADAPTIVE_CONCURRENCY;
 }
 
 bool S3BlobStoreEndpoint::BlobKnobs::set(StringRef name, int value) {
@@ -166,6 +169,9 @@ bool S3BlobStoreEndpoint::BlobKnobs::set(StringRef name, int value) {
 	TRY_PARAM(sdk_auth, sa);
 	TRY_PARAM(enable_object_integrity_check, eoic);
 	TRY_PARAM(global_connection_pool, gcp);
+	TRY_PARAM(max_idle_connection_time, mict);
+	TRY_PARAM(prewarm_connections, pwc);
+	TRY_PARAM(adaptive_concurrency, acc);
 #undef TRY_PARAM
 	return false;
 }
@@ -208,6 +214,9 @@ std::string S3BlobStoreEndpoint::BlobKnobs::getURLParameters() const {
 	_CHECK_PARAM(global_connection_pool, gcp);
 	_CHECK_PARAM(max_delay_retryable_error, dre);
 	_CHECK_PARAM(max_delay_connection_failed, dcf);
+	_CHECK_PARAM(max_idle_connection_time, mict);
+	_CHECK_PARAM(prewarm_connections, pwc);
+	_CHECK_PARAM(adaptive_concurrency, acc);
 #undef _CHECK_PARAM
 	return r;
 }
@@ -815,6 +824,9 @@ Future<Void> S3BlobStoreEndpoint::updateSecret() {
 	return updateSecret_impl(Reference<S3BlobStoreEndpoint>::addRef(this));
 }
 
+Future<S3BlobStoreEndpoint::ReusableConnection> newConnection_impl(Reference<S3BlobStoreEndpoint> b);
+Future<S3BlobStoreEndpoint::ReusableConnection> openConnection(S3BlobStoreEndpoint* b);
+
 Future<S3BlobStoreEndpoint::ReusableConnection> connect_impl(Reference<S3BlobStoreEndpoint> b, bool* reusingConn) {
 	// First try to get a connection from the pool
 	*reusingConn = false;
@@ -822,6 +834,16 @@ Future<S3BlobStoreEndpoint::ReusableConnection> connect_impl(Reference<S3BlobSto
 		S3BlobStoreEndpoint::ReusableConnection rconn = b->connectionPool->pool.front();
 		b->connectionPool->pool.pop();
 
+		// Servers drop connections that sit idle for too long, and a request on such a connection fails
+		if (b->knobs.max_idle_connection_time > 0 && rconn.expirationTime > now() &&
+		    now() - rconn.idleSince > b->knobs.max_idle_connection_time) {
+			++b->blobStats->idleClosedConnections;
+			if (rconn.conn.isValid()) {
+				rconn.conn->close();
+			}
+			continue;
+		}
+
 		// If the connection expires in the future then return it
 		if (rconn.expirationTime > now()) {
 			*reusingConn = true;
@@ -835,6 +857,22 @@ Future<S3BlobStoreEndpoint::ReusableConnection> connect_impl(Reference<S3BlobSto
 		}
 		++b->blobStats->expiredConnections;
 	}
+	b->maybePrewarmConnections();
+	S3BlobStoreEndpoint::ReusableConnection rconn = co_await newConnection_impl(b);
+	co_return rconn;
+}
+
+Future<S3BlobStoreEndpoint::ReusableConnection> newConnection_impl(Reference<S3BlobStoreEndpoint> b) {
+	S3BlobStoreEndpoint::ReusableConnection rconn = co_await openConnection(b.getPtr());
+
+	if (b->lookupKey || b->lookupSecret || b->knobs.sdk_auth)
+		co_await b->updateSecret();
+
+	co_return rconn;
+}
+
+// Opens a connection to the endpoint without refreshing its credentials. The caller must keep b alive.
+Future<S3BlobStoreEndpoint::ReusableConnection> openConnection(S3BlobStoreEndpoint* b) {
 	++b->blobStats->newConnections;
 	std::string host = b->host, service = b->service;
 	TraceEvent(SevDebug, "S3BlobStoreEndpointBuildingNewConnection")
@@ -878,9 +916,6 @@ Future<S3BlobStoreEndpoint::ReusableConnection> connect_impl(Reference<S3BlobSto
 	    .detail("ExpiresIn", b->knobs.max_connection_life)
 	    .detail("Proxy", b->proxyHost.orDefault(""));
 
-	if (b->lookupKey || b->lookupSecret || b->knobs.sdk_auth)
-		co_await b->updateSecret();
-
 	co_return S3BlobStoreEndpoint::ReusableConnection({ conn, now() + b->knobs.max_connection_life });
 }
 
@@ -888,9 +923,45 @@ Future<S3BlobStoreEndpoint::ReusableConnection> S3BlobStoreEndpoint::connect(boo
 	return connect_impl(Reference<S3BlobStoreEndpoint>::addRef(this), reusing);
 }
 
+// b owns the returned future and cancels it when destroyed, so a raw pointer does not keep b alive. The request that
+// triggered prewarming refreshes the credentials, so the prewarmed connections do not.
+Future<Void> prewarmConnections_impl(S3BlobStoreEndpoint* b, int count) {
+	std::vector<Future<S3BlobStoreEndpoint::ReusableConnection>> connecting;
+	for (int i = 0; i < count; i++) {
+		connecting.push_back(timeoutError(openConnection(b), b->knobs.connect_timeout));
+	}
+	for (auto& f : connecting) {
+		Error err;
+		try {
+			S3BlobStoreEndpoint::ReusableConnection rconn = co_await f;
+			++b->blobStats->prewarmedConnections;
+			b->returnConnection(rconn);
+		} catch (Error& e) {
+			err = e;
+		}
+		if (err.isValid()) {
+			if (err.code() == error_code_actor_cancelled) {
+				throw err;
+			}
+			TraceEvent(SevWarn, "S3BlobStoreEndpointPrewarmConnectionFailed")
+			    .suppressFor(60)
+			    .errorUnsuppressed(err)
+			    .detail("Host", b->host);
+		}
+	}
+}
+
+void S3BlobStoreEndpoint::maybePrewarmConnections() {
+	// The request that found the pool empty opens its own connection, so open one fewer
+	if (knobs.prewarm_connections > 1 && (!prewarming.isValid() || prewarming.isReady())) {
+		prewarming = prewarmConnections_impl(this, knobs.prewarm_connections - 1);
+	}
+}
+
 void S3BlobStoreEndpoint::returnConnection(ReusableConnection& rconn) {
 	// If it expires in the future then add it to the pool in the front
 	if (rconn.expirationTime > now()) {
+		rconn.idleSince = now();
 		connectionPool->pool.push(rconn);
 	} else {
 		++blobStats->expiredConnections;
@@ -898,6 +969,53 @@ void S3BlobStoreEndpoint::returnConnection(ReusableConnection& rconn) {
 	rconn.conn = Reference<IConnection>();
 }
 
+S3BlobStoreEndpoint::AdaptiveConcurrency::AdaptiveConcurrency(BlobKnobs const& knobs)
+  : enabled(knobs.adaptive_concurrency != 0), slowStart(true),
+    limit(std::min(CLIENT_KNOBS->BLOBSTORE_ADAPTIVE_CONCURRENCY_MIN, knobs.concurrent_requests)),
+    maxLimit(knobs.concurrent_requests), inFlight(0), successes(0), recentLatency(0), longTermLatency(0),
+    lastDecrease(0) {}
+
+Future<Void> S3BlobStoreEndpoint::AdaptiveConcurrency::take() {
+	while (enabled && inFlight >= std::max<int>(1, limit)) {
+		co_await released.onTrigger();
+	}
+	++inFlight;
+}
+
+void S3BlobStoreEndpoint::AdaptiveConcurrency::release() {
+	--inFlight;
+	released.trigger();
+}
+
+void S3BlobStoreEndpoint::AdaptiveConcurrency::onResponse(double latency, bool throttled) {
+	if (!enabled) {
+		return;
+	}
+	recentLatency = recentLatency == 0 ? latency : 0.8 * recentLatency + 0.2 * latency;
+	longTermLatency = longTermLatency == 0 ? latency : 0.99 * longTermLatency + 0.01 * latency;
+	bool congested =
+	    throttled || recentLatency > CLIENT_KNOBS->BLOBSTORE_ADAPTIVE_CONCURRENCY_LATENCY_RATIO * longTermLatency;
+	if (congested) {
+		slowStart = false;
+		successes = 0;
+		// Responses to requests sent before the last decrease do not reflect it yet
+		if (now() - lastDecrease > recentLatency) {
+			limit = std::max<double>(CLIENT_KNOBS->BLOBSTORE_ADAPTIVE_CONCURRENCY_MIN, limit / 2);
+			lastDecrease = now();
+			TraceEvent("S3BlobStoreEndpointConcurrencyDecreased")
+			    .suppressFor(60)
+			    .detail("Limit", limit)
+			    .detail("Throttled", throttled)
+			    .detail("RecentLatency", recentLatency)
+			    .detail("LongTermLatency", longTermLatency);
+		}
+	} else if (slowStart || ++successes >= limit) {
+		successes = 0;
+		limit = std::min(maxLimit, limit + 1);
+		released.trigger();
+	}
+}
+
 std::string awsCanonicalURI(const std::string& resource, std::vector<std::string>& queryParameters, bool isV4) {
 	StringRef resourceRef(resource);
 	resourceRef.eat("/");
@@ -1112,6 +1230,9 @@ Future<Reference<HTTP::IncomingResponse>> doRequest_impl(Reference<S3BlobStoreEn
 			fieldValue.append(v);
 		}
 
+		co_await bstore->adaptiveConcurrency.take();
+		S3BlobStoreEndpoint::AdaptiveConcurrency::Releaser attemptReleaser(bstore->adaptiveConcurrency);
+
 		UID connID = UID();
 		double reqStartTimer{ 0 };
 		double connectStartTimer = g_network->timer();
@@ -1282,6 +1403,15 @@ Future<Reference<HTTP::IncomingResponse>> doRequest_impl(Reference<S3BlobStoreEn
 		double connectDuration = reqStartTimer - connectStartTimer;
 		double reqDuration = end - reqStartTimer;
 		bstore->blobStats->requestLatency.addMeasurement(reqDuration);
+		bool throttled = !err.present() && (r->code == 429 || r->code == 503);
+		if (throttled) {
+			++bstore->blobStats->throttledResponses;
+		}
+		if (connectionEstablished) {
+			bstore->adaptiveConcurrency.onResponse(reqDuration, throttled);
+		}
+		// Do not hold the slot while waiting to retry
+		attemptReleaser.release();
 
 		// If err is not present then r is valid.
 		// If r->code is in successCodes then record the successful request and return r.
@@ -19,6 +19,7 @@
  */
 
 #include <string>
+#include <map>
 #include <vector>
 #include <unordered_set>
 #include <algorithm>
@@ -81,48 +82,6 @@ struct PartConfig {
 	bool enableChecksumValidation = true; // Default: enable checksum validation
 };
 
-// Calculate hash of a file.
-// Uses xxhash library because it's fast (supposedly) and used elsewhere in fdb.
-// If size is -1, the function will determine the file size automatically.
-// Returns a hex string representation of the xxhash64 checksum.
-AsyncResult<std::string> calculateFileChecksum(Reference<IAsyncFile> file, int64_t size) {
-	int64_t pos = 0;
-	XXH64_state_t* hashState = XXH64_createState();
-	std::shared_ptr<std::vector<uint8_t>> buffer = std::make_shared<std::vector<uint8_t>>(65536);
-	int readSize{ 0 };
-
-	XXH64_reset(hashState, 0);
-
-	try {
-		if (size == -1) {
-			int64_t s = co_await file->size();
-			size = s;
-		}
-
-		while (pos < size) {
-			readSize = std::min<int64_t>(buffer->size(), size - pos);
-			int bytesRead = co_await uncancellable(holdWhile(buffer, file->read(buffer->data(), readSize, pos)));
-			if (bytesRead != readSize) {
-				XXH64_freeState(hashState);
-				TraceEvent(SevError, "S3ClientCalculateChecksumReadError")
-				    .detail("Expected", readSize)
-				    .detail("Actual", bytesRead)
-				    .detail("Position", pos);
-				throw io_error();
-			}
-			XXH64_update(hashState, buffer->data(), bytesRead);
-			pos += bytesRead;
-		}
-
-		uint64_t hash = XXH64_digest(hashState);
-		XXH64_freeState(hashState);
-		co_return format("%016llx", hash);
-	} catch (Error& e) {
-		XXH64_freeState(hashState);
-		throw;
-	}
-}
-
 // Get the endpoint for the given s3url.
 // Populates parameters and resource with parse of s3url.
 Reference<S3BlobStoreEndpoint> getEndpoint(const std::string& s3url,
@@ -690,12 +649,15 @@ Future<Void> copyUpBulkDumpFileSet(std::string s3url,
 	    .detail("BytesDeleted", pBytesDeleted);
 }
 
+// Download one part of the object with a ranged GET and write it at its offset in file.
+// The part data is left in buffer so the caller can feed it to the object checksum.
 static Future<PartState> downloadPart(Reference<S3BlobStoreEndpoint> endpoint,
                                       std::string bucket,
                                       std::string objectName,
                                       Reference<IAsyncFile> file,
                                       PartState part,
-                                      PartConfig config) {
+                                      PartConfig config,
+                                      std::shared_ptr<std::vector<uint8_t>> buffer) {
 	PartState resultPart = part;
 	int attempt = 0;
 	int maxRetries = config.maxPartRetries;
@@ -711,9 +673,8 @@ static Future<PartState> downloadPart(Reference<S3BlobStoreEndpoint> endpoint,
 	while (true) {
 		Error err;
 		try {
-			std::vector<uint8_t> buffer;
 			int64_t totalBytesRead = 0;
-			buffer.resize(resultPart.size);
+			buffer->resize(resultPart.size);
 
 			// Add range validation
 			if (resultPart.offset < 0 || resultPart.size <= 0) {
@@ -726,7 +687,7 @@ static Future<PartState> downloadPart(Reference<S3BlobStoreEndpoint> endpoint,
 			while (totalBytesRead < resultPart.size) {
 				int bytesRead = co_await endpoint->readObject(bucket,
 				                                              objectName,
-				                                              buffer.data() + totalBytesRead,
+				                                              buffer->data() + totalBytesRead,
 				                                              resultPart.size - totalBytesRead,
 				                                              resultPart.offset + totalBytesRead);
 				if (bytesRead == 0) {
@@ -750,7 +711,7 @@ static Future<PartState> downloadPart(Reference<S3BlobStoreEndpoint> endpoint,
 
 			// Verify checksum if provided (currently only MD5 is used for download verification)
 			if (!resultPart.checksum.empty()) {
-				std::string calculatedMD5 = HTTP::computeMD5Sum(std::string((char*)buffer.data(), totalBytesRead));
+				std::string calculatedMD5 = HTTP::computeMD5Sum(std::string((char*)buffer->data(), totalBytesRead));
 				if (resultPart.checksum != calculatedMD5) {
 					TraceEvent(SevWarnAlways, "S3ClientDownloadPartChecksumMismatch")
 					    .detail("Expected", resultPart.checksum)
@@ -759,7 +720,7 @@ static Future<PartState> downloadPart(Reference<S3BlobStoreEndpoint> endpoint,
 				}
 			}
 
-			co_await file->write(buffer.data(), totalBytesRead, resultPart.offset);
+			co_await file->write(buffer->data(), totalBytesRead, resultPart.offset);
 
 			resultPart.completed = true;
 			TraceEvent(SevDebug, "S3ClientDownloadPartEnd")
@@ -807,6 +768,65 @@ static AsyncResult<Optional<std::string>> getExpectedChecksum(Reference<S3BlobSt
 	co_return result;
 }
 
+// Shared state of the parts download of one object.
+// Parts are fetched by a fixed number of workers, each picking the next part as soon as its previous one landed, so a
+// slow part does not hold back the others. The object checksum is computed as the contiguous prefix of downloaded
+// parts grows, so the file does not have to be read back after the download.
+struct PartsDownload {
+	std::vector<PartState> parts;
+	int nextPart = 0; // Index of the next part to download
+	int hashedParts = 0; // Number of leading parts fed to hashState
+	int maxPartsAhead = 0; // Max number of parts downloaded past the hashed prefix, bounding buffered memory
+	std::map<int, std::shared_ptr<std::vector<uint8_t>>> unhashed; // Downloaded parts past the hashed prefix
+	AsyncTrigger hashAdvanced;
+	XXH64_state_t* hashState;
+
+	PartsDownload(int64_t fileSize, int64_t partSizeBytes, int maxPartsAhead)
+	  : maxPartsAhead(maxPartsAhead), hashState(XXH64_createState()) {
+		XXH64_reset(hashState, 0);
+		int partNumber = 1;
+		for (int64_t offset = 0; offset < fileSize; offset += partSizeBytes) {
+			parts.emplace_back(partNumber++, offset, std::min(partSizeBytes, fileSize - offset), "");
+		}
+	}
+	~PartsDownload() { XXH64_freeState(hashState); }
+
+	void partDownloaded(int index, std::shared_ptr<std::vector<uint8_t>> data) {
+		unhashed[index] = std::move(data);
+		while (!unhashed.empty() && unhashed.begin()->first == hashedParts) {
+			XXH64_update(hashState, unhashed.begin()->second->data(), unhashed.begin()->second->size());
+			unhashed.erase(unhashed.begin());
+			hashedParts++;
+		}
+		hashAdvanced.trigger();
+	}
+
+	std::string checksum() const {
+		ASSERT(hashedParts == (int)parts.size());
+		return format("%016llx", XXH64_digest(hashState));
+	}
+};
+
+static Future<Void> downloadPartsWorker(Reference<S3BlobStoreEndpoint> endpoint,
+                                        std::string bucket,
+                                        std::string objectName,
+                                        Reference<IAsyncFile> file,
+                                        std::shared_ptr<PartsDownload> download,
+                                        PartConfig config) {
+	while (download->nextPart < (int)download->parts.size()) {
+		int index = download->nextPart++;
+		// The part at the hashed prefix is always owned by a worker that is not waiting here, so this cannot stall
+		while (index >= download->hashedParts + download->maxPartsAhead) {
+			co_await download->hashAdvanced.onTrigger();
+		}
+		auto buffer = std::make_shared<std::vector<uint8_t>>();
+		PartState part =
+		    co_await downloadPart(endpoint, bucket, objectName, file, download->parts[index], config, buffer);
+		download->parts[index] = part;
+		download->partDownloaded(index, std::move(buffer));
+	}
+}
+
 // Copy down file from s3 to filepath.
 static Future<Void> copyDownFile(Reference<S3BlobStoreEndpoint> endpoint,
                                  std::string bucket,
@@ -814,16 +834,12 @@ static Future<Void> copyDownFile(Reference<S3BlobStoreEndpoint> endpoint,
                                  std::string filepath,
                                  PartConfig config = PartConfig()) {
 	Reference<IAsyncFile> file;
-	std::vector<PartState> parts;
+	std::shared_ptr<PartsDownload> download;
 	int64_t fileSize = 0;
-	int64_t offset = 0;
-	int partNumber = 1;
-	int64_t partSize{ 0 };
 	std::string expectedChecksum;
 	int retries = 0;
 	int maxConcurrentDownloads{ 0 };
-	std::vector<Future<PartState>> activeDownloadFutures;
-	std::vector<int> activePartIndices;
+	std::vector<Future<Void>> workers;
 
 	while (true) {
 		Error err;
@@ -855,8 +871,6 @@ static Future<Void> copyDownFile(Reference<S3BlobStoreEndpoint> endpoint,
 				platform::createDirectory(dirPath);
 			}
 
-			int numParts = (fileSize + config.partSizeBytes - 1) / config.partSizeBytes;
-			parts.reserve(numParts);
 			Reference<IAsyncFile> f = co_await IAsyncFileSystem::filesystem()->open(
 			    filepath,
 			    IAsyncFile::OPEN_CREATE | IAsyncFile::OPEN_READWRITE | IAsyncFile::OPEN_UNCACHED |
@@ -864,43 +878,20 @@ static Future<Void> copyDownFile(Reference<S3BlobStoreEndpoint> endpoint,
 			    0644);
 			file = f;
 
-			co_await file->truncate(fileSize);
+			// Preallocate the file so parts can be written at their offsets in any order
 			co_await file->truncate(fileSize);
 
-			offset = 0;
-			partNumber = 1;
-			maxConcurrentDownloads = CLIENT_KNOBS->BLOBSTORE_CONCURRENT_READS_PER_FILE;
-			activeDownloadFutures.clear();
-			activePartIndices.clear();
-
-			// Process parts in batches with concurrency limit
-			while (offset < fileSize) {
-				// Fill up to maxConcurrentDownloads active downloads
-				while (activeDownloadFutures.size() < maxConcurrentDownloads && offset < fileSize) {
-					partSize = std::min(config.partSizeBytes, fileSize - offset);
-					parts.emplace_back(partNumber, offset, partSize, "");
-					activeDownloadFutures.push_back(
-					    downloadPart(endpoint, bucket, objectName, file, parts.back(), config));
-					activePartIndices.push_back(partNumber - 1); // Store index into parts array
-					offset += partSize;
-					partNumber++;
-				}
-
-				// Wait for all active downloads to complete
-				if (!activeDownloadFutures.empty()) {
-					std::vector<PartState> completedParts = co_await getAll(activeDownloadFutures);
-					// Update parts with completion status
-					for (int i = 0; i < completedParts.size(); i++) {
-						parts[activePartIndices[i]] = completedParts[i];
-					}
-					// Memory is automatically freed when downloadPart actors complete
-					activeDownloadFutures.clear();
-					activePartIndices.clear();
-				}
+			maxConcurrentDownloads = std::max(1, CLIENT_KNOBS->BLOBSTORE_CONCURRENT_READS_PER_FILE);
+			download = std::make_shared<PartsDownload>(fileSize, config.partSizeBytes, 2 * maxConcurrentDownloads);
+			workers.clear();
+			for (int i = 0; i < std::min<int>(maxConcurrentDownloads, download->parts.size()); i++) {
+				workers.push_back(downloadPartsWorker(endpoint, bucket, objectName, file, download, config));
 			}
+			co_await waitForAll(workers);
+			workers.clear();
 
 			// Verify all parts completed
-			for (const auto& part : parts) {
+			for (const auto& part : download->parts) {
 				if (!part.completed) {
 					TraceEvent(SevError, "S3ClientCopyDownFilePartNotCompleted").detail("PartNumber", part.partNumber);
 					throw http_bad_response();
@@ -915,7 +906,7 @@ static Future<Void> copyDownFile(Reference<S3BlobStoreEndpoint> endpoint,
 
 			if (cs.present()) {
 				expectedChecksum = cs.get();
-				std::string actualChecksum = co_await calculateFileChecksum(file, fileSize);
+				std::string actualChecksum = download->checksum();
 				if (actualChecksum != expectedChecksum) {
 					TraceEvent(SevWarnAlways, "S3ClientCopyDownFileChecksumMismatch")
 					    .detail("Expected", expectedChecksum)
@@ -931,12 +922,14 @@ static Future<Void> copyDownFile(Reference<S3BlobStoreEndpoint> endpoint,
 			    .detail("ObjectName", objectName)
 			    .detail("FileSize", fileSize)
 			    .detail("Checksum", expectedChecksum)
-			    .detail("Parts", parts.size());
+			    .detail("Parts", download->parts.size())
+			    .detail("Concurrency", maxConcurrentDownloads);
 
 			break; // Success
 		} catch (Error& e) {
 			err = e;
 		}
+		workers.clear(); // Cancel the part downloads still in flight
 
 		if ((err.code() == error_code_file_not_found || err.code() == error_code_http_request_failed ||
 		     err.code() == error_code_io_error) &&
@@ -950,9 +943,7 @@ static Future<Void> copyDownFile(Reference<S3BlobStoreEndpoint> endpoint,
 			retries++;
 
 			// Cleanup state for retry
-			parts.clear();
-			activeDownloadFutures.clear();
-			activePartIndices.clear();
+			download.reset();
 
 			if (file) {
 				try {
@@ -64,6 +64,8 @@ void StorageServerInterface::initEndpointsFromGetValue() {
 	getHotShards = RequestStream<struct GetHotShardsRequest>(getValue.getEndpoint().getAdjustedEndpoint(24));
 	getCheckSum = RequestStream<struct GetStorageCheckSumRequest>(getValue.getEndpoint().getAdjustedEndpoint(25));
 	bulkdump = RequestStream<struct BulkDumpRequest>(getValue.getEndpoint().getAdjustedEndpoint(26));
+	getRangeModifiedVersions =
+	    RequestStream<struct RangeModifiedVersionsRequest>(getValue.getEndpoint().getAdjustedEndpoint(27));
 }
 
 void StorageServerInterface::initEndpoints() {
@@ -95,6 +97,7 @@ void StorageServerInterface::initEndpoints() {
 	streams.push_back(getHotShards.getReceiver());
 	streams.push_back(getCheckSum.getReceiver());
 	streams.push_back(bulkdump.getReceiver());
+	streams.push_back(getRangeModifiedVersions.getReceiver());
 	FlowTransport::transport().addEndpoints(streams);
 }
 
@@ -417,6 +420,27 @@ void TSS_traceMismatch(TraceEvent& event,
 	ASSERT(false);
 }
 
+template <>
+bool TSS_doCompare(const RangeModifiedVersionsReply& src, const RangeModifiedVersionsReply& tss) {
+	// Modified versions depend on when each server was assigned its shards, no need to validate replies.
+	return true;
+}
+
+template <>
+const char* LB_mismatchTraceName(const RangeModifiedVersionsRequest& req, const ComparisonType& type) {
+	ASSERT(false);
+	return "";
+}
+
+template <>
+void TSS_traceMismatch(TraceEvent& event,
+                       const RangeModifiedVersionsRequest& req,
+                       const RangeModifiedVersionsReply& src,
+                       const RangeModifiedVersionsReply& tss,
+                       const ComparisonType& type) {
+	ASSERT(false);
+}
+
 template <>
 bool TSS_doCompare(const SplitRangeReply& src, const SplitRangeReply& tss) {
 	// We duplicate read hot sub range metrics just for load, no need to validate replies.
@@ -525,6 +549,9 @@ void TSSMetrics::recordLatency(const ReadHotSubRangeRequest& req, double ssLaten
 template <>
 void TSSMetrics::recordLatency(const SplitRangeRequest& req, double ssLatency, double tssLatency) {}
 
+template <>
+void TSSMetrics::recordLatency(const RangeModifiedVersionsRequest& req, double ssLatency, double tssLatency) {}
+
 template <>
 void TSSMetrics::recordLatency(const GetKeyValuesStreamRequest& req, double ssLatency, double tssLatency) {}
 
@@ -159,6 +159,15 @@ ThreadFuture<Standalone<StringRef>> ThreadSafeDatabase::getClientStatus() {
 	return onMainThread([db] { return Future<Standalone<StringRef>>(db->getClientStatus()); });
 }
 
+ThreadFuture<Void> ThreadSafeDatabase::warmLocationCache(const KeyRangeRef& keys) {
+	DatabaseContext* db = this->db;
+	KeyRange range = keys;
+	return onMainThread([db, range]() -> Future<Void> {
+		db->checkDeferredError();
+		return db->warmLocationCache(range);
+	});
+}
+
 ThreadSafeDatabase::~ThreadSafeDatabase() {
 	DatabaseContext* db = this->db;
 	onMainThreadVoid([db]() { db->delref(); });
@@ -226,6 +235,16 @@ ThreadFuture<Optional<Value>> ThreadSafeTransaction::get(const KeyRef& key, bool
 	});
 }
 
+ThreadFuture<RangeResult> ThreadSafeTransaction::getMultiple(const VectorRef<KeyRef>& keys, bool snapshot) {
+	Standalone<VectorRef<KeyRef>> k = keys;
+
+	ReadYourWritesTransaction* tr = this->tr;
+	return onMainThread([tr, k, snapshot]() -> Future<RangeResult> {
+		tr->checkDeferredError();
+		return tr->getMultiple(k, Snapshot{ snapshot });
+	});
+}
+
 ThreadFuture<Key> ThreadSafeTransaction::getKey(const KeySelectorRef& key, bool snapshot) {
 	KeySelector k = key;
 
@@ -344,6 +363,13 @@ void ThreadSafeTransaction::set(const KeyRef& key, const ValueRef& value) {
 	onMainThreadVoid([tr, k, v]() { tr->set(k, v); }, tr, &ReadYourWritesTransaction::deferredError);
 }
 
+void ThreadSafeTransaction::setMultiple(const VectorRef<KeyValueRef>& keyValues) {
+	Standalone<VectorRef<KeyValueRef>> kvs = keyValues;
+
+	ReadYourWritesTransaction* tr = this->tr;
+	onMainThreadVoid([tr, kvs]() { tr->setMultiple(kvs); }, tr, &ReadYourWritesTransaction::deferredError);
+}
+
 void ThreadSafeTransaction::clear(const KeyRangeRef& range) {
 	KeyRange r = range;
 
@@ -19,12 +19,13 @@
  */
 
 #include "fdbclient/VersionedMap.h"
+#include "fdbclient/BTreeVersionedMap.h"
 #include "flow/TreeBenchmark.h"
 #include "flow/UnitTest.h"
 
-template <typename K>
+template <typename K, template <class, class> class Map = VersionedMap>
 struct VersionedMapHarness {
-	using map = VersionedMap<K, int>;
+	using map = Map<K, int>;
 	using key_type = K;
 
 	struct result {
@@ -74,4 +75,204 @@ TEST_CASE("performance/map/StringRef/VersionedMap") {
 	return Void();
 }
 
+TEST_CASE("performance/map/int/BTreeVersionedMap") {
+	VersionedMapHarness<int, BTreeVersionedMap> tree;
+
+	treeBenchmark(tree, *randomInt);
+
+	return Void();
+}
+
+TEST_CASE("performance/map/StringRef/BTreeVersionedMap") {
+	Arena arena;
+	VersionedMapHarness<StringRef, BTreeVersionedMap> tree;
+
+	treeBenchmark(tree, [&arena]() { return randomStr(arena); });
+
+	return Void();
+}
+
+// Compares two versioned maps after the same operations, at the given version
+template <class A, class B>
+static void compareVersionedMaps(A const& a, B const& b, Version v) {
+	auto ia = a.at(v).begin();
+	auto ib = b.at(v).begin();
+	for (; ia && ib; ++ia, ++ib) {
+		ASSERT(ia.key() == ib.key());
+		ASSERT(*ia == *ib);
+		ASSERT(ia.insertVersion() == ib.insertVersion());
+	}
+	ASSERT(!ia && !ib);
+}
+
+// Applies the same random operations to a PTree VersionedMap and to map, and checks that they match at every version
+// still retained. eraseFraction is the share of operations that erase keys or ranges.
+template <class Map>
+static Future<Void> checkMatchesVersionedMap(Map& map, int steps, double eraseFraction) {
+	VersionedMap<int, int> ptree;
+	std::vector<Version> versions = { 0 };
+	Version v = 0;
+	const int keySpace = deterministicRandom()->coinflip() ? 200 : 5000;
+
+	for (int step = 0; step < steps; step++) {
+		if (deterministicRandom()->random01() < 0.1) {
+			v += deterministicRandom()->randomInt(1, 4);
+			ptree.createNewVersion(v);
+			map.createNewVersion(v);
+			versions.push_back(v);
+		}
+		double op = deterministicRandom()->random01();
+		int k = deterministicRandom()->randomInt(0, keySpace);
+		if (op < eraseFraction * 0.8) {
+			// Erase through an iterator, like changeDurableVersion() does
+			auto i = map.atLatest().find(k);
+			ASSERT(bool(i) == bool(ptree.atLatest().find(k)));
+			if (i) {
+				ptree.erase(k);
+				map.erase(i);
+			}
+		} else if (op < eraseFraction) {
+			int end = k + deterministicRandom()->randomInt(1, keySpace / 4);
+			ptree.erase(k, end);
+			map.erase(k, end);
+		} else if (op < 0.8) {
+			int value = deterministicRandom()->randomInt(0, 1000000);
+			// Clears split by a set keep the insert version of the clear
+			Version insertAt = deterministicRandom()->coinflip() ? v : std::max<Version>(versions.front(), v - 3);
+			ptree.insert(k, value, insertAt);
+			map.insert(k, value, insertAt);
+		} else {
+			auto ip = ptree.atLatest().lastLessOrEqual(k);
+			auto ib = map.atLatest().lastLessOrEqual(k);
+			ASSERT(bool(ip) == bool(ib));
+			if (ip) {
+				ASSERT(ip.key() == ib.key());
+			}
+			auto lp = ptree.atLatest().lastLess(k);
+			auto lb = map.atLatest().lastLess(k);
+			ASSERT(bool(lp) == bool(lb));
+			if (lp) {
+				ASSERT(lp.key() == lb.key());
+			}
+			auto up = ptree.atLatest().upper_bound(k);
+			auto ub = map.atLatest().upper_bound(k);
+			ASSERT(bool(up) == bool(ub));
+			if (up) {
+				ASSERT(up.key() == ub.key());
+			}
+		}
+		if (versions.size() > 20 && deterministicRandom()->random01() < 0.001) {
+			Version oldest = versions[versions.size() / 2];
+			ptree.forgetVersionsBefore(oldest);
+			if (deterministicRandom()->coinflip()) {
+				map.forgetVersionsBefore(oldest);
+			} else {
+				// The forgotten versions must be gone right away, even though their nodes are freed later
+				Future<Void> forgotten = map.forgetVersionsBeforeAsync(oldest);
+				ASSERT(map.getOldestVersion() == oldest);
+				co_await forgotten;
+			}
+			versions.erase(versions.begin(), versions.begin() + versions.size() / 2);
+			for (Version version : versions) {
+				map.at(version).validate();
+				compareVersionedMaps(ptree, map, version);
+			}
+		}
+	}
+
+	for (Version version : versions) {
+		map.at(version).validate();
+		compareVersionedMaps(ptree, map, version);
+	}
+}
+
+TEST_CASE("/fdbclient/BTreeVersionedMap/MatchesVersionedMap") {
+	BTreeVersionedMap<int, int> btree;
+	co_await checkMatchesVersionedMap(btree, 20000, 0.2);
+}
+
+// Mostly erases, so nodes keep falling below MinFill and are merged with or refilled from their neighbours.
+// validate() checks the fill of every node.
+TEST_CASE("/fdbclient/BTreeVersionedMap/EraseHeavy") {
+	BTreeVersionedMap<int, int> btree;
+	co_await checkMatchesVersionedMap(btree, 20000, 0.6);
+
+	// Dense keys and ranges that cut through many leaves and internal nodes
+	BTreeVersionedMap<int, int> dense;
+	for (int i = 0; i < 100000; i++) {
+		if (i % 100 == 0) {
+			dense.createNewVersion(i / 100 + 1);
+		}
+		dense.insert(i, i);
+	}
+	dense.createNewVersion(dense.getLatestVersion() + 1);
+	for (int i = 0; i < 100000; i += 1000) {
+		dense.erase(i + 3, i + 997);
+	}
+	dense.atLatest().validate();
+	dense.at(1000).validate();
+	dense.erase(0, 100000);
+	ASSERT(!dense.atLatest().begin());
+	co_await dense.forgetVersionsBeforeAsync(dense.getLatestVersion());
+}
+
+TEST_CASE("/fdbclient/BTreeVersionedMap/SelectableVersionedMap") {
+	for (int i = 0; i < 2; i++) {
+		bool useBTree = i == 1;
+		SelectableVersionedMap<int, int> map(useBTree);
+		ASSERT(map.isBTree() == useBTree);
+		co_await checkMatchesVersionedMap(map, 5000, 0.3);
+	}
+}
+
+// Storage server style workload: keys are inserted in batches, one version per batch, and range reads of a few
+// hundred keys are served from the latest version.
+template <class Map>
+static void versionedMapStorageBenchmark(const char* name, std::vector<StringRef> const& keys) {
+	Map map;
+	Version v = 0;
+	{
+		std::string opName = std::string(name) + " versioned insert";
+		opTimer t(opName.c_str(), keys.size());
+		for (int i = 0; i < keys.size(); i++) {
+			if (i % 100 == 0) {
+				map.createNewVersion(++v);
+			}
+			map.insert(keys[i], i);
+			if (i % 10000 == 0 && v > 100) {
+				map.forgetVersionsBefore(v - 100);
+			}
+		}
+	}
+
+	const int scans = 10000;
+	const int rowsPerScan = 200;
+	int64_t rows = 0;
+	{
+		std::string opName = std::string(name) + " range scan rows";
+		opTimer t(opName.c_str(), scans * rowsPerScan);
+		auto view = map.atLatest();
+		for (int s = 0; s < scans; s++) {
+			auto it = view.lower_bound(keys[deterministicRandom()->randomInt(0, keys.size())]);
+			for (int r = 0; r < rowsPerScan && it; r++, ++it) {
+				rows += it.key().size();
+			}
+		}
+	}
+	ASSERT(rows > 0);
+}
+
+TEST_CASE("performance/map/StringRef/VersionedMapVsBTreeVersionedMap") {
+	Arena arena;
+	std::vector<StringRef> keys;
+	for (int i = 0; i < 1000000; i++) {
+		keys.push_back(randomStr(arena));
+	}
+
+	versionedMapStorageBenchmark<VersionedMap<StringRef, int>>("PTree", keys);
+	versionedMapStorageBenchmark<BTreeVersionedMap<StringRef, int>>("BTree", keys);
+
+	return Void();
+}
+
 void forceLinkVersionedMapTests() {}
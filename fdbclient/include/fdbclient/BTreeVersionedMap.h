@@ -0,0 +1,926 @@
+/*
+ * BTreeVersionedMap.h
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2026 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FDBCLIENT_BTREEVERSIONEDMAP_H
+#define FDBCLIENT_BTREEVERSIONEDMAP_H
+#pragma once
+
+#include <cstring>
+#include <type_traits>
+#include <variant>
+
+#include "flow/flow.h"
+#include "fdbclient/FDBTypes.h"
+#include "fdbclient/VersionedMap.h"
+
+// BTreeVersionedMap is a drop-in alternative to VersionedMap (same public interface as used by
+// StorageServer::VersionedData) built on a persistent B+tree instead of a treap.
+//
+// Each node holds up to Fanout entries (leaves) or children (internal nodes) in contiguous arrays, so lookups and scans
+// touch a handful of cache lines per level rather than one node per key. Persistence uses copy-on-write at node
+// granularity: a node created at the latest version is modified in place, and any other node on the path being
+// modified is copied first, so older versions keep seeing the nodes they were built from.
+//
+// Keys and values are stored by value and must be trivially copyable (e.g. KeyRef and ValueOrClearToRef, whose bytes
+// live in the caller's arenas), which lets nodes move entries with memmove. Internal nodes only hold copies of keys
+// that are in the leaves below them at the same version, so they never outlive the arenas of the entries themselves.
+namespace BTreeVersionedMapImpl {
+
+constexpr int Fanout = 32;
+// Every node except the root has at least this many entries or children. An underfull node is merged with a neighbour
+// if the result fits in a node, and otherwise takes entries from it.
+constexpr int MinFill = Fanout / 4;
+// Bounds the height of any tree. With MinFill entries per leaf and MinFill children per internal node below the root, a
+// tree of height h holds at least 2 * MinFill^(h-1) entries, so 16 levels are enough for 2^46 entries.
+constexpr int MaxDepth = 16;
+
+template <class K, class T>
+struct Node : ReferenceCounted<Node<K, T>>, NonCopyable {
+	static_assert(std::is_trivially_copyable_v<K> && std::is_trivially_copyable_v<T>);
+
+	// The version at which this node was created. Only nodes created at the latest version may be modified.
+	const Version version;
+	const bool leaf;
+	int count = 0;
+
+	// For leaves, the keys of the entries. For internal nodes, keys[i] is the first key below child i, so keys[0] is
+	// always the first key in the subtree.
+	std::aligned_storage_t<sizeof(K), alignof(K)> keyStorage[Fanout];
+
+	Node(bool leaf, Version version) : version(version), leaf(leaf) {}
+	virtual ~Node() = default;
+
+	K& key(int i) { return reinterpret_cast<K*>(keyStorage)[i]; }
+	K const& key(int i) const { return reinterpret_cast<K const*>(keyStorage)[i]; }
+
+	// Index of the first key >= k in [from, count)
+	template <class X>
+	int lowerBound(const X& k, int from = 0) const {
+		int lo = from, hi = count;
+		while (lo < hi) {
+			int mid = (lo + hi) / 2;
+			if (key(mid) < k)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		return lo;
+	}
+
+	// Index of the first key > k in [from, count)
+	template <class X>
+	int upperBound(const X& k, int from = 0) const {
+		int lo = from, hi = count;
+		while (lo < hi) {
+			int mid = (lo + hi) / 2;
+			if (k < key(mid))
+				hi = mid;
+			else
+				lo = mid + 1;
+		}
+		return lo;
+	}
+
+	// Index of the child of an internal node whose key range contains k
+	template <class X>
+	int childFor(const X& k) const {
+		return std::max(upperBound(k, 1) - 1, 0);
+	}
+};
+
+template <class K, class T>
+struct Leaf final : Node<K, T>, FastAllocated<Leaf<K, T>> {
+	std::aligned_storage_t<sizeof(T), alignof(T)> valueStorage[Fanout];
+	Version insertVersions[Fanout];
+
+	explicit Leaf(Version version) : Node<K, T>(true, version) {}
+	Leaf(Leaf const& from, Version version) : Node<K, T>(true, version) {
+		this->count = from.count;
+		memcpy(this->keyStorage, from.keyStorage, sizeof(K) * from.count);
+		memcpy(valueStorage, from.valueStorage, sizeof(T) * from.count);
+		memcpy(insertVersions, from.insertVersions, sizeof(Version) * from.count);
+	}
+
+	T& value(int i) { return reinterpret_cast<T*>(valueStorage)[i]; }
+	T const& value(int i) const { return reinterpret_cast<T const*>(valueStorage)[i]; }
+
+	void set(int i, const K& k, const T& t, Version insertVersion) {
+		new (&this->key(i)) K(k);
+		new (&value(i)) T(t);
+		insertVersions[i] = insertVersion;
+	}
+
+	// Moves entries [from, count) to start at index to. Does not change count.
+	void shift(int from, int to) {
+		int n = this->count - from;
+		memmove(&this->key(to), &this->key(from), sizeof(K) * n);
+		memmove(&value(to), &value(from), sizeof(T) * n);
+		memmove(&insertVersions[to], &insertVersions[from], sizeof(Version) * n);
+	}
+
+	// Appends entries [from, from + n) of other
+	void append(Leaf const& other, int from, int n) {
+		ASSERT(this->count + n <= Fanout);
+		memcpy(&this->key(this->count), &other.key(from), sizeof(K) * n);
+		memcpy(&value(this->count), &other.value(from), sizeof(T) * n);
+		memcpy(&insertVersions[this->count], &other.insertVersions[from], sizeof(Version) * n);
+		this->count += n;
+	}
+
+	// Inserts entries [from, from + n) of other before the first entry
+	void prepend(Leaf const& other, int from, int n) {
+		ASSERT(this->count + n <= Fanout);
+		shift(0, n);
+		memcpy(&this->key(0), &other.key(from), sizeof(K) * n);
+		memcpy(&value(0), &other.value(from), sizeof(T) * n);
+		memcpy(&insertVersions[0], &other.insertVersions[from], sizeof(Version) * n);
+		this->count += n;
+	}
+};
+
+template <class K, class T>
+struct Internal final : Node<K, T>, FastAllocated<Internal<K, T>> {
+	Reference<Node<K, T>> children[Fanout];
+
+	explicit Internal(Version version) : Node<K, T>(false, version) {}
+	Internal(Internal const& from, Version version) : Node<K, T>(false, version) {
+		this->count = from.count;
+		memcpy(this->keyStorage, from.keyStorage, sizeof(K) * from.count);
+		for (int i = 0; i < from.count; i++) {
+			children[i] = from.children[i];
+		}
+	}
+
+	void insertChild(int i, const K& lowerBound, Reference<Node<K, T>> child) {
+		ASSERT(this->count < Fanout);
+		memmove(&this->key(i + 1), &this->key(i), sizeof(K) * (this->count - i));
+		for (int j = this->count; j > i; j--) {
+			children[j] = std::move(children[j - 1]);
+		}
+		new (&this->key(i)) K(lowerBound);
+		children[i] = std::move(child);
+		this->count++;
+	}
+
+	void removeChild(int i) {
+		memmove(&this->key(i), &this->key(i + 1), sizeof(K) * (this->count - i - 1));
+		for (int j = i; j < this->count - 1; j++) {
+			children[j] = std::move(children[j + 1]);
+		}
+		this->count--;
+		children[this->count].clear();
+	}
+};
+
+template <class K, class T>
+Future<Void> deferredNodeCleanupActor(std::vector<Reference<Node<K, T>>> toFree,
+                                      TaskPriority taskID = TaskPriority::DefaultYield) {
+	int freeCount = 0;
+	while (!toFree.empty()) {
+		Reference<Node<K, T>> a = std::move(toFree.back());
+		toFree.pop_back();
+
+		if (!a->leaf) {
+			auto* internal = static_cast<Internal<K, T>*>(a.getPtr());
+			for (int c = 0; c < internal->count; c++) {
+				if (internal->children[c]->isSoleOwner())
+					toFree.push_back(std::move(internal->children[c]));
+			}
+		}
+
+		if (++freeCount % 100 == 0)
+			co_await yield(taskID);
+	}
+}
+
+} // namespace BTreeVersionedMapImpl
+
+template <class K, class T>
+class BTreeVersionedMap : NonCopyable {
+public:
+	using NodeT = BTreeVersionedMapImpl::Node<K, T>;
+	using LeafT = BTreeVersionedMapImpl::Leaf<K, T>;
+	using InternalT = BTreeVersionedMapImpl::Internal<K, T>;
+	typedef Reference<NodeT> Tree;
+
+	Version oldestVersion, latestVersion;
+
+	// Roots of the tree at each version, sorted by version (see VersionedMap::roots)
+	std::deque<std::pair<Version, Tree>> roots;
+
+	struct rootsComparator {
+		bool operator()(const std::pair<Version, Tree>& value, const Version& key) { return (value.first < key); }
+		bool operator()(const Version& key, const std::pair<Version, Tree>& value) { return (key < value.first); }
+	};
+
+	Tree const& getRoot(Version v) const {
+		auto r = upper_bound(roots.begin(), roots.end(), v, rootsComparator());
+		--r;
+		return r->second;
+	}
+
+	// Each item costs its share of a half full leaf, and a modified leaf is usually copied once more while older
+	// versions still reference it.
+	static const int overheadPerItem = nextFastAllocatedSize(sizeof(LeafT)) / (BTreeVersionedMapImpl::Fanout / 2) * 2;
+	struct iterator;
+
+	BTreeVersionedMap() : oldestVersion(0), latestVersion(0) { roots.emplace_back(0, Tree()); }
+	BTreeVersionedMap(BTreeVersionedMap&& v) noexcept
+	  : oldestVersion(v.oldestVersion), latestVersion(v.latestVersion), roots(std::move(v.roots)) {}
+	void operator=(BTreeVersionedMap&& v) noexcept {
+		oldestVersion = v.oldestVersion;
+		latestVersion = v.latestVersion;
+		roots = std::move(v.roots);
+	}
+
+	Version getLatestVersion() const { return latestVersion; }
+	Version getOldestVersion() const { return oldestVersion; }
+	Version getNextOldestVersion() const { return roots[1].first; }
+
+	void forgetVersionsBefore(Version newOldestVersion) {
+		ASSERT(newOldestVersion <= latestVersion);
+		auto r = upper_bound(roots.begin(), roots.end(), newOldestVersion, rootsComparator());
+		auto upper = r;
+		--r;
+		if (r->first != newOldestVersion) {
+			r = roots.emplace(upper, newOldestVersion, getRoot(newOldestVersion));
+		}
+
+		UNSTOPPABLE_ASSERT(r->first == newOldestVersion);
+		roots.erase(roots.begin(), r);
+		oldestVersion = newOldestVersion;
+	}
+
+	Future<Void> forgetVersionsBeforeAsync(Version newOldestVersion, TaskPriority taskID = TaskPriority::DefaultYield) {
+		ASSERT_LE(newOldestVersion, latestVersion);
+		auto r = upper_bound(roots.begin(), roots.end(), newOldestVersion, rootsComparator());
+		auto upper = r;
+		--r;
+		if (r->first != newOldestVersion) {
+			r = roots.emplace(upper, newOldestVersion, getRoot(newOldestVersion));
+		}
+
+		UNSTOPPABLE_ASSERT(r->first == newOldestVersion);
+
+		std::vector<Tree> toFree;
+		auto newBegin = r;
+		Tree* lastRoot = nullptr;
+		for (auto root = roots.begin(); root != newBegin; ++root) {
+			if (root->second) {
+				// Consecutive versions often share a root; drop the earlier reference so the last one is the owner
+				if (lastRoot != nullptr && root->second == *lastRoot) {
+					(*lastRoot).clear();
+				}
+				if (root->second->isSoleOwner()) {
+					toFree.push_back(root->second);
+				}
+				lastRoot = &root->second;
+			}
+		}
+
+		roots.erase(roots.begin(), newBegin);
+		oldestVersion = newOldestVersion;
+		return BTreeVersionedMapImpl::deferredNodeCleanupActor(std::move(toFree), taskID);
+	}
+
+	// Following sets and erases are into the given version, which may now be passed to at(). Must be called in
+	// monotonically increasing order.
+	void createNewVersion(Version version) {
+		if (version > latestVersion) {
+			latestVersion = version;
+			Tree r = getRoot(version);
+			roots.emplace_back(version, r);
+		} else
+			ASSERT(version == latestVersion);
+	}
+
+	// insert() and erase() invalidate atLatest() and all iterators into it. Their arguments are copied first, since they
+	// may refer to an entry of a node that the operation moves or frees (e.g. iterator::key()).
+	void insert(const K& k, const T& t) { insert(k, t, latestVersion); }
+	void insert(const K& k, const T& t, Version insertAt) {
+		const K key = k;
+		const T value = t;
+		Tree& root = roots.back().second;
+		if (!root) {
+			root = makeReference<LeafT>(latestVersion);
+		}
+		Tree split = insert(writable(root), key, value, insertAt);
+		if (split) {
+			auto newRoot = makeReference<InternalT>(latestVersion);
+			newRoot->insertChild(0, root->key(0), root);
+			newRoot->insertChild(1, split->key(0), split);
+			root = newRoot;
+		}
+	}
+	void erase(const K& begin, const K& end) {
+		const K b = begin, e = end;
+		if (b < e) {
+			erase(b, e, false);
+		}
+	}
+	void erase(const K& key) {
+		const K k = key;
+		erase(k, k, true);
+	}
+	void erase(iterator const& item) { // iterator must be in latest version!
+		ASSERT_EQ(item.at, latestVersion);
+		erase(item.key());
+	}
+
+	// Nodes never point to newer versions of themselves, so there is nothing to compact
+	void compact(Version newOldestVersion) { ASSERT(newOldestVersion <= latestVersion); }
+
+	struct iterator {
+		explicit iterator(Tree const& root, Version at) : root(root), at(at), depth(0) {}
+
+		K const& key() const { return leaf()->key(pos[depth - 1]); }
+		// Returns the version at which the current item was inserted
+		Version insertVersion() const { return leaf()->insertVersions[pos[depth - 1]]; }
+		operator bool() const { return depth != 0; }
+		bool operator<(const K& key) const { return this->key() < key; }
+
+		T const& operator*() { return leaf()->value(pos[depth - 1]); }
+		T const* operator->() { return &leaf()->value(pos[depth - 1]); }
+		void operator++() {
+			if (depth)
+				next();
+			else
+				first();
+		}
+		void operator--() {
+			if (depth)
+				previous();
+			else
+				last();
+		}
+		bool operator==(const iterator& r) const {
+			if (depth && r.depth)
+				return leaf() == r.leaf() && pos[depth - 1] == r.pos[r.depth - 1];
+			else
+				return depth == r.depth;
+		}
+		bool operator!=(const iterator& r) const { return !(*this == r); }
+
+	private:
+		friend class BTreeVersionedMap<K, T>;
+		Tree root;
+		Version at;
+		// path[i] is the node at level i (the root is level 0) and pos[i] the index taken in it
+		NodeT* path[BTreeVersionedMapImpl::MaxDepth];
+		int pos[BTreeVersionedMapImpl::MaxDepth];
+		int depth;
+
+		LeafT const* leaf() const { return static_cast<LeafT const*>(path[depth - 1]); }
+
+		void push(NodeT* n, int i) {
+			ASSERT(depth < BTreeVersionedMapImpl::MaxDepth);
+			path[depth] = n;
+			pos[depth] = i;
+			depth++;
+		}
+
+		// Descends from the child at the current position of the deepest node to its leftmost or rightmost leaf
+		void descend(bool leftmost) {
+			while (!path[depth - 1]->leaf) {
+				auto* n = static_cast<InternalT*>(path[depth - 1])->children[pos[depth - 1]].getPtr();
+				push(n, leftmost ? 0 : n->count - 1);
+			}
+		}
+
+		void first() {
+			depth = 0;
+			if (root && root->count) {
+				push(root.getPtr(), 0);
+				descend(true);
+			}
+		}
+
+		void last() {
+			depth = 0;
+			if (root && root->count) {
+				push(root.getPtr(), root->count - 1);
+				descend(false);
+			}
+		}
+
+		void next() {
+			while (depth && ++pos[depth - 1] == path[depth - 1]->count) {
+				depth--;
+			}
+			if (depth)
+				descend(true);
+		}
+
+		void previous() {
+			while (depth && pos[depth - 1]-- == 0) {
+				depth--;
+			}
+			if (depth)
+				descend(false);
+		}
+
+		// Positions the iterator at the first item >= key (or > key if upper), or at end()
+		template <class X>
+		void seek(const X& key, bool upper) {
+			depth = 0;
+			if (!root || !root->count)
+				return;
+			NodeT* n = root.getPtr();
+			while (!n->leaf) {
+				int i = n->childFor(key);
+				push(n, i);
+				n = static_cast<InternalT*>(n)->children[i].getPtr();
+			}
+			int i = upper ? n->upperBound(key) : n->lowerBound(key);
+			if (i < n->count) {
+				push(n, i);
+			} else {
+				push(n, n->count - 1);
+				next();
+			}
+		}
+	};
+
+	class ViewAtVersion {
+	public:
+		ViewAtVersion(Tree const& root, Version at) : root(root), at(at) {}
+
+		iterator begin() const {
+			iterator i(root, at);
+			i.first();
+			return i;
+		}
+		iterator end() const { return iterator(root, at); }
+
+		// Returns x such that key==*x, or end()
+		template <class X>
+		iterator find(const X& key) const {
+			iterator i = lower_bound(key);
+			if (i && i.key() == key)
+				return i;
+			else
+				return end();
+		}
+
+		// Returns the smallest x such that *x>=key, or end()
+		template <class X>
+		iterator lower_bound(const X& key) const {
+			iterator i(root, at);
+			i.seek(key, false);
+			return i;
+		}
+
+		// Returns the smallest x such that *x>key, or end()
+		template <class X>
+		iterator upper_bound(const X& key) const {
+			iterator i(root, at);
+			i.seek(key, true);
+			return i;
+		}
+
+		// Returns the largest x such that *x<=key, or end()
+		template <class X>
+		iterator lastLessOrEqual(const X& key) const {
+			iterator i = upper_bound(key);
+			--i;
+			return i;
+		}
+
+		// Returns the largest x such that *x<key, or end()
+		template <class X>
+		iterator lastLess(const X& key) const {
+			iterator i = lower_bound(key);
+			--i;
+			return i;
+		}
+
+		void validate() {
+			int count = 0, height = 0;
+			if (root) {
+				BTreeVersionedMap::validate(root.getPtr(), at, nullptr, nullptr, count, height, true);
+			}
+		}
+
+	private:
+		Tree root;
+		Version at;
+	};
+
+	ViewAtVersion at(Version v) const {
+		if (v == ::latestVersion) {
+			return atLatest();
+		}
+
+		return ViewAtVersion(getRoot(v), v);
+	}
+	ViewAtVersion atLatest() const { return ViewAtVersion(roots.back().second, latestVersion); }
+
+	bool isClearContaining(ViewAtVersion const& view, KeyRef key) {
+		auto i = view.lastLessOrEqual(key);
+		return i && i->isClearTo() && i->getEndKey() > key;
+	}
+
+private:
+	// Returns the node in slot, first replacing it with a copy if it was not created at the latest version
+	NodeT* writable(Tree& slot) {
+		if (slot->version != latestVersion) {
+			if (slot->leaf) {
+				slot = makeReference<LeafT>(*static_cast<LeafT*>(slot.getPtr()), latestVersion);
+			} else {
+				slot = makeReference<InternalT>(*static_cast<InternalT*>(slot.getPtr()), latestVersion);
+			}
+		}
+		return slot.getPtr();
+	}
+
+	// Inserts below n, which must be writable. If n has to be split, returns the new right sibling, whose key(0) is
+	// the key to store for it in the parent.
+	Tree insert(NodeT* n, const K& k, const T& t, Version insertAt) {
+		using namespace BTreeVersionedMapImpl;
+		if (n->leaf) {
+			auto* leaf = static_cast<LeafT*>(n);
+			int i = leaf->lowerBound(k);
+			if (i < leaf->count && !(k < leaf->key(i))) {
+				leaf->set(i, k, t, insertAt);
+				return Tree();
+			}
+			Reference<LeafT> right;
+			if (leaf->count == Fanout) {
+				right = makeReference<LeafT>(latestVersion);
+				// Appending to the last leaf is common (e.g. increasing keys), so keep that leaf nearly full instead of
+				// leaving a trail of half empty ones.
+				int m = (i == Fanout) ? Fanout - MinFill : Fanout / 2;
+				right->append(*leaf, m, Fanout - m);
+				leaf->count = m;
+				if (i >= m) {
+					leaf = right.getPtr();
+					i -= m;
+				}
+			}
+			leaf->shift(i, i + 1);
+			leaf->set(i, k, t, insertAt);
+			leaf->count++;
+			return right;
+		}
+
+		auto* internal = static_cast<InternalT*>(n);
+		int ci = internal->childFor(k);
+		Tree split = insert(writable(internal->children[ci]), k, t, insertAt);
+		// The first key of the child changes when k goes before it, or replaces it with a KeyRef into a newer arena
+		internal->key(ci) = internal->children[ci]->key(0);
+		if (!split) {
+			return Tree();
+		}
+		int p = ci + 1;
+		Reference<InternalT> right;
+		if (internal->count == Fanout) {
+			right = makeReference<InternalT>(latestVersion);
+			int m = Fanout / 2;
+			memcpy(right->keyStorage, &internal->key(m), sizeof(K) * (Fanout - m));
+			for (int j = m; j < Fanout; j++) {
+				right->children[j - m] = std::move(internal->children[j]);
+			}
+			right->count = Fanout - m;
+			internal->count = m;
+			if (p > m) {
+				internal = right.getPtr();
+				p -= m;
+			}
+		}
+		internal->insertChild(p, split->key(0), split);
+		return right;
+	}
+
+	// Removes the keys in [begin, end), or [begin, end] if endInclusive, and shrinks the tree if possible
+	void erase(const K& begin, const K& end, bool endInclusive) {
+		Tree& root = roots.back().second;
+		if (!root) {
+			return;
+		}
+		erase(writable(root), begin, end, endInclusive);
+		while (root && !root->leaf && root->count <= 1) {
+			root = root->count ? Tree(static_cast<InternalT*>(root.getPtr())->children[0]) : Tree();
+		}
+		if (root && root->count == 0) {
+			root = Tree();
+		}
+	}
+
+	void erase(NodeT* n, const K& begin, const K& end, bool endInclusive) {
+		using namespace BTreeVersionedMapImpl;
+		if (n->leaf) {
+			auto* leaf = static_cast<LeafT*>(n);
+			int i = leaf->lowerBound(begin);
+			int j = endInclusive ? leaf->upperBound(end, i) : leaf->lowerBound(end, i);
+			if (i < j) {
+				leaf->shift(j, i);
+				leaf->count -= j - i;
+			}
+			return;
+		}
+
+		auto* internal = static_cast<InternalT*>(n);
+		int first = internal->childFor(begin);
+		// The last child whose first key is before (or at, if inclusive) end
+		int last = std::max((endInclusive ? internal->upperBound(end, 1) : internal->lowerBound(end, 1)) - 1, 0);
+		if (first < last) {
+			// Children strictly between first and last are entirely inside the range
+			for (int c = last - 1; c > first; c--) {
+				internal->removeChild(c);
+			}
+			last = first + 1;
+			eraseInChild(internal, last, begin, end, endInclusive);
+		}
+		eraseInChild(internal, first, begin, end, endInclusive);
+		rebalanceChildren(internal, first, last);
+	}
+
+	void eraseInChild(InternalT* n, int c, const K& begin, const K& end, bool endInclusive) {
+		NodeT* child = writable(n->children[c]);
+		erase(child, begin, end, endInclusive);
+		if (child->count) {
+			n->key(c) = child->key(0);
+		}
+	}
+
+	// Removes the empty children among children [from, to] of n and brings the others back to MinFill by merging them
+	// with, or taking entries from, a neighbour. An only child is left as it is; n is then underfull itself, and its
+	// parent fixes it the same way, rebalancing the children it ends up next to.
+	void rebalanceChildren(InternalT* n, int from, int to) {
+		using namespace BTreeVersionedMapImpl;
+		int c = std::max(from, 0);
+		while (c <= to && c < n->count) {
+			int size = n->children[c]->count;
+			if (size == 0) {
+				n->removeChild(c);
+				to--;
+			} else if (size >= MinFill || n->count == 1) {
+				c++;
+			} else {
+				int left = c + 1 < n->count ? c : c - 1;
+				if (rebalancePair(n, left)) {
+					// The merged child may still be underfull, so look at it again
+					to = std::max(to - 1, left);
+				}
+				c = left;
+			}
+		}
+	}
+
+	// Merges children c and c + 1 of n if the result fits in a node, and otherwise splits their entries evenly between
+	// them. Returns true if they were merged.
+	bool rebalancePair(InternalT* n, int c) {
+		using namespace BTreeVersionedMapImpl;
+		NodeT* left = writable(n->children[c]);
+		int total = left->count + n->children[c + 1]->count;
+		bool merge = total <= Fanout;
+		// The right node is only read when merging, so it is copied only if entries are taken from it
+		NodeT* right = merge ? n->children[c + 1].getPtr() : writable(n->children[c + 1]);
+		// Entries to move from right to left, or from left to right if negative
+		int move = merge ? right->count : total / 2 - left->count;
+		if (left->leaf) {
+			auto* l = static_cast<LeafT*>(left);
+			auto* r = static_cast<LeafT*>(right);
+			if (move > 0) {
+				l->append(*r, 0, move);
+				if (!merge) {
+					r->shift(move, 0);
+					r->count -= move;
+				}
+			} else {
+				r->prepend(*l, l->count + move, -move);
+				l->count += move;
+			}
+		} else {
+			auto* l = static_cast<InternalT*>(left);
+			auto* r = static_cast<InternalT*>(right);
+			if (merge) {
+				for (int j = 0; j < r->count; j++) {
+					l->insertChild(l->count, r->key(j), r->children[j]);
+				}
+			} else {
+				for (; move > 0; move--) {
+					l->insertChild(l->count, r->key(0), r->children[0]);
+					r->removeChild(0);
+				}
+				for (; move < 0; move++) {
+					r->insertChild(0, l->key(l->count - 1), l->children[l->count - 1]);
+					l->removeChild(l->count - 1);
+				}
+			}
+		}
+
+		if (merge) {
+			n->removeChild(c + 1);
+		}
+		// The children that moved may include an underfull only child of left or right (see rebalanceChildren), which
+		// now has neighbours to be rebalanced with
+		if (!left->leaf) {
+			rebalanceChildren(static_cast<InternalT*>(left), 0, left->count - 1);
+			if (!merge) {
+				rebalanceChildren(static_cast<InternalT*>(right), 0, right->count - 1);
+			}
+		}
+		n->key(c) = left->key(0);
+		if (!merge) {
+			n->key(c + 1) = right->key(0);
+		}
+		return merge;
+	}
+
+	static void validate(NodeT* n, Version at, const K* lower, const K* upper, int& count, int& height, bool isRoot) {
+		using namespace BTreeVersionedMapImpl;
+		ASSERT(n->version <= at);
+		ASSERT(n->count >= MinFill || (isRoot && (n->leaf || n->count > 1)));
+		ASSERT(n->count <= Fanout);
+		int childHeight = 0;
+		for (int i = 0; i < n->count; i++) {
+			ASSERT(!lower || !(n->key(i) < *lower));
+			ASSERT(!upper || n->key(i) < *upper);
+			if (i > 0) {
+				ASSERT(n->key(i - 1) < n->key(i));
+			}
+			if (!n->leaf) {
+				NodeT* child = static_cast<InternalT*>(n)->children[i].getPtr();
+				ASSERT(n->key(i) == child->key(0));
+				int h = 0;
+				validate(child, at, &n->key(i), i + 1 < n->count ? &n->key(i + 1) : upper, count, h, false);
+				ASSERT(i == 0 || h == childHeight);
+				childHeight = h;
+			}
+		}
+		if (n->leaf) {
+			count += n->count;
+		}
+		height = childHeight + 1;
+	}
+};
+
+// SelectableVersionedMap is either a VersionedMap or a BTreeVersionedMap, chosen when it is constructed, with the
+// interface of both. It lets the storage server pick the structure of its MVCC window with a knob.
+template <class K, class T>
+class SelectableVersionedMap : NonCopyable {
+public:
+	using PTreeMap = VersionedMap<K, T>;
+	using BTreeMap = BTreeVersionedMap<K, T>;
+
+	struct iterator {
+		explicit iterator(typename PTreeMap::iterator const& i) : impl(i) {}
+		explicit iterator(typename BTreeMap::iterator const& i) : impl(i) {}
+
+		K const& key() const {
+			return std::visit([](auto const& i) -> K const& { return i.key(); }, impl);
+		}
+		Version insertVersion() const {
+			return std::visit([](auto const& i) { return i.insertVersion(); }, impl);
+		}
+		operator bool() const {
+			return std::visit([](auto const& i) { return bool(i); }, impl);
+		}
+		bool operator<(const K& key) const { return this->key() < key; }
+
+		T const& operator*() {
+			return std::visit([](auto& i) -> T const& { return *i; }, impl);
+		}
+		T const* operator->() { return &**this; }
+		void operator++() {
+			std::visit([](auto& i) { ++i; }, impl);
+		}
+		void operator--() {
+			std::visit([](auto& i) { --i; }, impl);
+		}
+		bool operator==(const iterator& r) const {
+			return std::visit(
+			    [](auto const& a, auto const& b) {
+				    if constexpr (std::is_same_v<decltype(a), decltype(b)>) {
+					    return a == b;
+				    } else {
+					    return false;
+				    }
+			    },
+			    impl,
+			    r.impl);
+		}
+		bool operator!=(const iterator& r) const { return !(*this == r); }
+
+	private:
+		friend class SelectableVersionedMap<K, T>;
+		std::variant<typename PTreeMap::iterator, typename BTreeMap::iterator> impl;
+	};
+
+	class ViewAtVersion {
+	public:
+		explicit ViewAtVersion(typename PTreeMap::ViewAtVersion const& v) : impl(v) {}
+		explicit ViewAtVersion(typename BTreeMap::ViewAtVersion const& v) : impl(v) {}
+
+		iterator begin() const {
+			return std::visit([](auto const& v) { return iterator(v.begin()); }, impl);
+		}
+		iterator end() const {
+			return std::visit([](auto const& v) { return iterator(v.end()); }, impl);
+		}
+		template <class X>
+		iterator find(const X& key) const {
+			return std::visit([&key](auto const& v) { return iterator(v.find(key)); }, impl);
+		}
+		template <class X>
+		iterator lower_bound(const X& key) const {
+			return std::visit([&key](auto const& v) { return iterator(v.lower_bound(key)); }, impl);
+		}
+		template <class X>
+		iterator upper_bound(const X& key) const {
+			return std::visit([&key](auto const& v) { return iterator(v.upper_bound(key)); }, impl);
+		}
+		template <class X>
+		iterator lastLessOrEqual(const X& key) const {
+			return std::visit([&key](auto const& v) { return iterator(v.lastLessOrEqual(key)); }, impl);
+		}
+		template <class X>
+		iterator lastLess(const X& key) const {
+			return std::visit([&key](auto const& v) { return iterator(v.lastLess(key)); }, impl);
+		}
+		void validate() {
+			std::visit([](auto& v) { v.validate(); }, impl);
+		}
+
+	private:
+		std::variant<typename PTreeMap::ViewAtVersion, typename BTreeMap::ViewAtVersion> impl;
+	};
+
+	explicit SelectableVersionedMap(bool useBTree = false) {
+		if (useBTree) {
+			impl.template emplace<BTreeMap>();
+		}
+	}
+
+	bool isBTree() const { return std::holds_alternative<BTreeMap>(impl); }
+
+	Version getLatestVersion() const {
+		return std::visit([](auto const& m) { return m.getLatestVersion(); }, impl);
+	}
+	Version getOldestVersion() const {
+		return std::visit([](auto const& m) { return m.getOldestVersion(); }, impl);
+	}
+
+	void forgetVersionsBefore(Version newOldestVersion) {
+		std::visit([=](auto& m) { m.forgetVersionsBefore(newOldestVersion); }, impl);
+	}
+	Future<Void> forgetVersionsBeforeAsync(Version newOldestVersion, TaskPriority taskID = TaskPriority::DefaultYield) {
+		return std::visit([=](auto& m) { return m.forgetVersionsBeforeAsync(newOldestVersion, taskID); }, impl);
+	}
+	void createNewVersion(Version version) {
+		std::visit([=](auto& m) { m.createNewVersion(version); }, impl);
+	}
+
+	// insert() and erase() invalidate atLatest() and all iterators into it
+	void insert(const K& k, const T& t) {
+		std::visit([&](auto& m) { m.insert(k, t); }, impl);
+	}
+	void insert(const K& k, const T& t, Version insertAt) {
+		std::visit([&](auto& m) { m.insert(k, t, insertAt); }, impl);
+	}
+	void erase(const K& begin, const K& end) {
+		std::visit([&](auto& m) { m.erase(begin, end); }, impl);
+	}
+	void erase(const K& key) {
+		std::visit([&](auto& m) { m.erase(key); }, impl);
+	}
+	void erase(iterator const& item) { // iterator must be in latest version!
+		std::visit([&item](auto& m) { m.erase(std::get<typename std::decay_t<decltype(m)>::iterator>(item.impl)); },
+		           impl);
+	}
+
+	ViewAtVersion at(Version v) const {
+		return std::visit([v](auto const& m) { return ViewAtVersion(m.at(v)); }, impl);
+	}
+	ViewAtVersion atLatest() const {
+		return std::visit([](auto const& m) { return ViewAtVersion(m.atLatest()); }, impl);
+	}
+
+	bool isClearContaining(ViewAtVersion const& view, KeyRef key) {
+		auto i = view.lastLessOrEqual(key);
+		return i && i->isClearTo() && i->getEndKey() > key;
+	}
+
+private:
+	std::variant<PTreeMap, BTreeMap> impl;
+};
+
+#endif
@@ -30,6 +30,7 @@
 #include "flow/IAsyncFile.h"
 #include "fdbclient/KeyBackedTypes.actor.h"
 #include "fdbclient/BackupContainer.h"
+#include "flow/CompressionUtils.h"
 
 FDB_BOOLEAN_PARAM(LockDB);
 FDB_BOOLEAN_PARAM(UnlockDB);
@@ -846,6 +847,10 @@ public:
 
 	KeyBackedProperty<Version> snapshotDispatchLastVersion() { return configSpace.pack(__FUNCTION__sr); }
 
+	// Name of the keyspace snapshot whose unmodified range files were carried into the current snapshot, or an empty
+	// string if none were. Set once the current snapshot has checked for reusable files.
+	KeyBackedProperty<std::string> snapshotIncrementalBase() { return configSpace.pack(__FUNCTION__sr); }
+
 	Future<Void> initNewSnapshot(Reference<ReadYourWritesTransaction> tr, int64_t intervalSeconds = -1) {
 		BackupConfig& copy = *this; // Capture this by value instead of this ptr
 
@@ -873,6 +878,7 @@ public:
 			copy.snapshotRangeFileCount().set(tr, 0);
 			copy.snapshotDispatchLastVersion().clear(tr);
 			copy.snapshotDispatchLastShardsBehind().clear(tr);
+			copy.snapshotIncrementalBase().clear(tr);
 
 			return Void();
 		});
@@ -1041,6 +1047,58 @@ Future<Standalone<VectorRef<KeyValueRef>>> decodeMutationLogFileBlock(Reference<
                                                                       int64_t offset,
                                                                       int len);
 
+// Returns the messages of a block of a partitioned mutation log file, i.e. the (version, subsequence, size, message)
+// entries following the block header.  The entries of a PARTITIONED_MLOG_VERSION block are followed by 0xFF padding,
+// those of a PARTITIONED_MLOG_COMPRESSED_VERSION block are decompressed into arena and end with the returned string.
+StringRef decodePartitionedLogFileBlock(StringRef buf, Arena& arena);
+
+// Returns the messages of a PARTITIONED_MLOG_COMPRESSED_VERSION block laid out in PARTITIONED_MLOG_VERSION blocks of
+// blockSize bytes, as many as needed, or nothing if buf is not a compressed block.
+Optional<Standalone<StringRef>> expandPartitionedLogFileBlock(StringRef buf, int blockSize);
+
+// Writes a partitioned mutation log file in PARTITIONED_MLOG_COMPRESSED_VERSION blocks.  Messages are buffered until
+// enough of them have been seen to fill a block once compressed; the block is then sealed with the largest prefix of
+// the buffered messages that fits, and the remaining messages start the next block.
+class CompressedMutationLogWriter : public ReferenceCounted<CompressedMutationLogWriter>, NonCopyable {
+public:
+	CompressedMutationLogWriter(Reference<IBackupFile> file, int blockSize);
+
+	// Adds a message, the returned future is ready once all sealed blocks have been appended to the file
+	Future<Void> addMessage(Version version, uint32_t subsequence, StringRef message);
+
+	// Writes the remaining messages and finishes the file
+	Future<Void> finish();
+
+	Reference<IBackupFile> file;
+	int blockSize;
+
+private:
+	// Seal a block as soon as its compressed size reaches this fraction of the block size
+	static constexpr double blockFillTarget = 0.9;
+
+	Standalone<StringRef> encodeBlock(int bytes) const;
+	std::pair<int, Standalone<StringRef>> largestFittingBlock(int hiEntries) const;
+	void sealBlock(Standalone<StringRef> block, int entries, bool pad);
+	static Future<Void> appendBlock(Reference<IBackupFile> file,
+	                                Future<Void> previous,
+	                                Standalone<StringRef> block,
+	                                int padding);
+	static Future<Void> finishFile(Reference<IBackupFile> file, Future<Void> previous);
+
+	CompressionFilter filter;
+	// Encoded messages not written yet, and the end offset of each of them
+	std::string pending;
+	std::vector<int> entryEnds;
+	// Pending size at which to try sealing a block
+	int64_t checkBytes;
+	// Raw bytes per compressed byte of the last block encoded
+	double compressionRatio;
+	// Pending bytes known to fit in a block
+	int64_t fittingBytes;
+	// Appends of sealed blocks, in order
+	Future<Void> writing;
+};
+
 // Return a block of contiguous padding bytes "\0xff" for backup files, growing if needed.
 Value makePadding(int size);
 } // namespace fileBackup
@@ -69,6 +69,9 @@ static const uint32_t BACKUP_AGENT_MLOG_VERSION = 2001;
 // Mutation log version written by BackupWorker
 static const uint32_t PARTITIONED_MLOG_VERSION = 4110;
 
+// Compressed mutation log version written by BackupWorker
+static const uint32_t PARTITIONED_MLOG_COMPRESSED_VERSION = 4111;
+
 // Mutation log version written by BackupWorker for range partitioned logs
 static const uint32_t RANGE_PARTITIONED_MLOG_VERSION = 5001;
 
@@ -78,6 +81,9 @@ static const uint32_t BACKUP_AGENT_SNAPSHOT_FILE_VERSION = 1001;
 // Encrypted Snapshot file version written by FileBackupAgent
 static const uint32_t BACKUP_AGENT_ENCRYPTED_SNAPSHOT_FILE_VERSION = 1002;
 
+// Snapshot file version with compressed, prefix-encoded blocks written by FileBackupAgent
+static const uint32_t BACKUP_AGENT_COMPRESSED_SNAPSHOT_FILE_VERSION = 1003;
+
 struct LogFile {
 	Version beginVersion;
 	Version endVersion;
@@ -157,13 +163,20 @@ struct KeyspaceSnapshotFile {
 
 // Extended metadata for snapshot files, supporting both traditional range files and BulkDump
 struct SnapshotMetadata {
-	std::string snapshotType = "rangefile"; // "rangefile" or "bulkdump"
+	std::string snapshotType = "rangefile"; // "rangefile", "bulkdump" or "incremental"
 	std::string bulkDumpJobId; // Only used for bulkdump snapshots
 	int64_t totalKeys = 0; // Key count (primarily for bulkdump)
 	Version snapshotVersion = invalidVersion; // For bulkdump: the snapshot version (beginVersion == endVersion)
 	                                          // For rangefile: ignored (derived from files)
+	                                          // For incremental: the version the snapshot is consistent at, which
+	                                          // can be later than all of its files when they were all reused
+	// Only used for incremental snapshots: the snapshot file whose unmodified range files were carried over, and which
+	// of the listed files came from it. The file list of an incremental snapshot is still complete.
+	std::string baseSnapshot;
+	std::vector<std::string> reusedFiles;
 
 	bool isBulkDump() const { return snapshotType == "bulkdump"; }
+	bool isIncremental() const { return snapshotType == "incremental"; }
 
 	// Factory for creating BulkDump metadata
 	static SnapshotMetadata bulkDump(const std::string& jobId, Version version, int64_t totalBytes, int64_t keys) {
@@ -174,6 +187,18 @@ struct SnapshotMetadata {
 		m.totalKeys = keys;
 		return m;
 	}
+
+	// Factory for creating incremental range file snapshot metadata
+	static SnapshotMetadata incremental(const std::string& baseSnapshot,
+	                                    const std::vector<std::string>& reusedFiles,
+	                                    Version version) {
+		SnapshotMetadata m;
+		m.snapshotType = "incremental";
+		m.snapshotVersion = version;
+		m.baseSnapshot = baseSnapshot;
+		m.reusedFiles = reusedFiles;
+		return m;
+	}
 };
 
 struct BackupFileList {
@@ -282,6 +307,7 @@ public:
 	// snapshot of the key ranges this backup is targeting.
 	// For BulkDump snapshots, pass SnapshotMetadata with snapshotType="bulkdump" and the job ID.
 	// For traditional range file snapshots, metadata can be omitted.
+	// For incremental snapshots, pass SnapshotMetadata::incremental(); fileNames must still list every file, reused or not.
 	virtual Future<Void> writeKeyspaceSnapshotFile(
 	    const std::vector<std::string>& fileNames,
 	    const std::vector<std::pair<Key, Key>>& beginEndKeys,
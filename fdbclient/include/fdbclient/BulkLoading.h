@@ -54,6 +54,7 @@ Key getKeyFromHexString(const std::string& hexRawString);
 enum class BulkLoadType : uint8_t {
 	Invalid = 0,
 	SST = 1,
+	RangeFile = 2, // Backup range file, converted to SST by the storage server that loads it
 };
 
 enum class BulkLoadTransportMethod : uint8_t {
@@ -414,7 +415,7 @@ public:
 			byteSampleSetting = BulkLoadByteSampleSetting(version, method, factor, overhead, minimalProbability);
 			int tmpLoadType = std::stoi(stringRemovePrefix(parts[18], "[loadType]: "));
 			int tmpTransportMethod = std::stoi(stringRemovePrefix(parts[19], "[TransportMethod]: "));
-			ASSERT(tmpLoadType == 0 || tmpLoadType == 1);
+			ASSERT(tmpLoadType == 0 || tmpLoadType == 1 || tmpLoadType == 2);
 			ASSERT(tmpTransportMethod == 0 || tmpTransportMethod == 1 || tmpTransportMethod == 2);
 			loadType = static_cast<BulkLoadType>(tmpLoadType);
 			transportMethod = static_cast<BulkLoadTransportMethod>(tmpTransportMethod);
@@ -448,7 +449,7 @@ public:
 		}
 		if (loadType == BulkLoadType::Invalid) {
 			return false;
-		} else if (loadType != BulkLoadType::SST) {
+		} else if (loadType != BulkLoadType::SST && loadType != BulkLoadType::RangeFile) {
 			ASSERT(false);
 		}
 		return true;
@@ -1050,6 +1051,13 @@ public:
 		ASSERT(isValid());
 	}
 
+	// Used when the manifest file is not stored along with the data file, e.g. when loading backup range files
+	BulkLoadJobFileManifestEntry(const BulkLoadManifest& manifest, const std::string& manifestRelativePath)
+	  : beginKey(manifest.getBeginKey()), endKey(manifest.getEndKey()), manifestRelativePath(manifestRelativePath),
+	    version(manifest.getVersion()), bytes(manifest.getTotalBytes()) {
+		ASSERT(isValid());
+	}
+
 	std::string toString() const {
 		ASSERT(isValid());
 		return "[BeginKey]: " + beginKey.toFullHexStringPlain() + ", [EndKey]: " + endKey.toFullHexStringPlain() +
@@ -99,9 +99,11 @@ public:
 	int LOCATION_CACHE_EVICTION_SIZE_SIM;
 	double LOCATION_CACHE_ENDPOINT_FAILURE_GRACE_PERIOD;
 	double LOCATION_CACHE_FAILED_ENDPOINT_RETRY_INTERVAL;
+	double LOCATION_CACHE_SNAPSHOT_INTERVAL; // Seconds between writes of the location_cache_snapshot_file
 
 	int GET_RANGE_SHARD_LIMIT;
 	int WARM_RANGE_SHARD_LIMIT;
+	int GET_RANGE_PARALLEL_SHARDS; // Shards read concurrently by a getRange in FDB_STREAMING_MODE_PARALLEL
 	int STORAGE_METRICS_SHARD_LIMIT;
 	int SHARD_COUNT_LIMIT;
 	double STORAGE_METRICS_UNFAIR_SPLIT_LIMIT;
@@ -186,6 +188,9 @@ public:
 	int BACKUP_POLL_PROGRESS_SECONDS;
 	int SIM_BACKUP_TASKS_PER_AGENT;
 	int BACKUP_RANGEFILE_BLOCK_SIZE;
+	bool BACKUP_RANGEFILE_COMPRESSION; // Write range files in the compressed block format, which older restores can't read
+	bool BACKUP_INCREMENTAL_SNAPSHOTS; // Reuse the previous snapshot's range files for shards that haven't changed since
+	int BACKUP_INCREMENTAL_SNAPSHOT_MAX_AGE; // Seconds; range files older than this are rewritten even if unchanged
 	int BACKUP_LOGFILE_BLOCK_SIZE;
 	int BACKUP_DISPATCH_ADDTASK_SIZE;
 	bool BACKUP_ALLOW_DRYRUN;
@@ -193,6 +198,8 @@ public:
 	int RESTORE_DISPATCH_BATCH_SIZE;
 	int RESTORE_WRITE_TX_SIZE;
 	int RESTORE_PARTITIONED_BATCH_VERSION_SIZE;
+	int RESTORE_LOG_APPLIER_STREAMS; // Version slices each partitioned restore batch's log replay is split into
+	int RESTORE_LOG_WRITES_IN_FLIGHT; // Concurrent mutation log write transactions per log replay task
 	int APPLY_MAX_LOCK_BYTES;
 	int APPLY_MIN_LOCK_BYTES;
 	int APPLY_BLOCK_SIZE;
@@ -268,6 +275,11 @@ public:
 	int BLOBSTORE_MAX_RECV_BYTES_PER_SECOND;
 	int BLOBSTORE_LIST_MAX_KEYS_PER_PAGE;
 	bool BLOBSTORE_GLOBAL_CONNECTION_POOL;
+	int BLOBSTORE_MAX_IDLE_CONNECTION_TIME; // Pooled connections idle for longer are closed instead of reused, 0 disables
+	int BLOBSTORE_PREWARM_CONNECTIONS; // Connections opened ahead of demand when an endpoint's pool runs dry
+	bool BLOBSTORE_ADAPTIVE_CONCURRENCY; // Adapt the requests in flight per endpoint to throttling and latency
+	int BLOBSTORE_ADAPTIVE_CONCURRENCY_MIN; // Floor of the adaptive concurrency limit
+	double BLOBSTORE_ADAPTIVE_CONCURRENCY_LATENCY_RATIO; // Recent over long-term latency ratio treated as congestion
 	bool BLOBSTORE_ENABLE_LOGGING;
 	double BLOBSTORE_STATS_LOGGING_INTERVAL;
 	double BLOBSTORE_LATENCY_LOGGING_INTERVAL;
@@ -261,6 +261,8 @@ public:
 	                                                          Optional<int> const& minSplitBytes = {});
 
 	Future<Standalone<VectorRef<ReadHotRangeWithMetrics>>> getReadHotRanges(KeyRange const& keys);
+	// Returns, for each shard of keys, an upper bound on the version of the latest mutation to it at or before version
+	Future<std::vector<std::pair<KeyRange, Version>>> getRangeModifiedVersions(KeyRange const& keys, Version version);
 	Future<Standalone<VectorRef<ReadHotRangeWithMetrics>>> getHotRangeMetrics(StorageServerInterface ssi,
 	                                                                          KeyRange const& keys,
 	                                                                          ReadHotSubRangeRequest::SplitType type,
@@ -336,6 +338,8 @@ public:
 	Future<Void> forceRecoveryWithDataLoss(StringRef dcId);
 	// Management API, create snapshot
 	Future<Void> createSnapshot(StringRef uid, StringRef snapshot_command);
+	// Fetch the storage server locations of every shard intersecting keys into the location cache
+	Future<Void> warmLocationCache(KeyRange keys);
 
 	// private:
 	explicit DatabaseContext(Reference<AsyncVar<Reference<IClusterConnectionRecord>>> connectionRecord,
@@ -408,6 +412,9 @@ public:
 	// Cache of location information
 	int locationCacheSize;
 	CoalescedKeyRangeMap<Reference<LocationInfo>> locationCache;
+	// Restores the location cache from the location_cache_snapshot_file at startup and periodically rewrites it
+	Future<Void> locationCacheSnapshotter;
+	Future<Void> maintainLocationCacheSnapshot(std::string path);
 	std::unordered_map<Endpoint, EndpointFailureInfo> failedEndpointsOnHealthyServersInfo;
 
 	std::map<UID, StorageServerInfo*> server_interf;
@@ -447,6 +454,9 @@ public:
 	Counter transactionGetRangeRequests;
 	Counter transactionGetMappedRangeRequests;
 	Counter transactionGetRangeStreamRequests;
+	// Batches of shards read concurrently by FDB_STREAMING_MODE_PARALLEL range reads, and the shard requests they sent
+	Counter transactionGetRangeParallelBatches;
+	Counter transactionGetRangeParallelShardRequests;
 	Counter transactionWatchRequests;
 	Counter transactionGetAddressesForKeyRequests;
 	Counter transactionBytesRead;
@@ -461,6 +471,8 @@ public:
 	Counter transactionsCommitCompleted;
 	Counter transactionKeyServerLocationRequests;
 	Counter transactionKeyServerLocationRequestsCompleted;
+	Counter locationCacheHits;
+	Counter locationCacheMisses;
 	Counter transactionStatusRequests;
 	Counter transactionsTooOld;
 	Counter transactionsFutureVersions;
@@ -728,10 +728,13 @@ struct GetRangeLimits {
 	int rows;
 	int minRows;
 	int bytes;
+	// Read up to GET_RANGE_PARALLEL_SHARDS shards of a forward key range concurrently (FDB_STREAMING_MODE_PARALLEL)
+	bool parallel;
 
-	GetRangeLimits() : rows(ROW_LIMIT_UNLIMITED), minRows(1), bytes(BYTE_LIMIT_UNLIMITED) {}
-	explicit GetRangeLimits(int rowLimit) : rows(rowLimit), minRows(1), bytes(BYTE_LIMIT_UNLIMITED) {}
-	GetRangeLimits(int rowLimit, int byteLimit) : rows(rowLimit), minRows(1), bytes(byteLimit) {}
+	GetRangeLimits() : rows(ROW_LIMIT_UNLIMITED), minRows(1), bytes(BYTE_LIMIT_UNLIMITED), parallel(false) {}
+	explicit GetRangeLimits(int rowLimit)
+	  : rows(rowLimit), minRows(1), bytes(BYTE_LIMIT_UNLIMITED), parallel(false) {}
+	GetRangeLimits(int rowLimit, int byteLimit) : rows(rowLimit), minRows(1), bytes(byteLimit), parallel(false) {}
 
 	void decrement(VectorRef<KeyValueRef> const& data);
 	void decrement(KeyValueRef const& data);
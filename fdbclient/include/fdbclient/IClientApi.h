@@ -43,6 +43,9 @@ public:
 	// own memory. It is guaranteed, however, that the ThreadFuture will hold a reference to the memory. It will persist
 	// until the ThreadFuture's ThreadSingleAssignmentVar has its memory released or it is destroyed.
 	virtual ThreadFuture<Optional<Value>> get(const KeyRef& key, bool snapshot = false) = 0;
+	// Reads all of the given keys with a single call. The result holds the key-value pairs of the keys that are
+	// present, in the order the keys were given.
+	virtual ThreadFuture<RangeResult> getMultiple(const VectorRef<KeyRef>& keys, bool snapshot = false) = 0;
 	virtual ThreadFuture<Key> getKey(const KeySelectorRef& key, bool snapshot = false) = 0;
 	virtual ThreadFuture<RangeResult> getRange(const KeySelectorRef& begin,
 	                                           const KeySelectorRef& end,
@@ -78,6 +81,7 @@ public:
 
 	virtual void atomicOp(const KeyRef& key, const ValueRef& value, uint32_t operationType) = 0;
 	virtual void set(const KeyRef& key, const ValueRef& value) = 0;
+	virtual void setMultiple(const VectorRef<KeyValueRef>& keyValues) = 0;
 	virtual void clear(const KeyRef& begin, const KeyRef& end) = 0;
 	virtual void clear(const KeyRangeRef& range) = 0;
 	virtual void clear(const KeyRef& key) = 0;
@@ -159,6 +163,9 @@ public:
 	// Return a JSON string containing database client-side status information
 	virtual ThreadFuture<Standalone<StringRef>> getClientStatus() = 0;
 
+	// Fetch the storage server locations of every shard intersecting keys into the client's location cache
+	virtual ThreadFuture<Void> warmLocationCache(const KeyRangeRef& keys) = 0;
+
 	// used in template functions as the Transaction type that can be created through createTransaction()
 	using TransactionT = ITransaction;
 };
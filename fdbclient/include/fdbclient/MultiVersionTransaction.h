@@ -132,6 +132,11 @@ struct FdbCApi : public ThreadSafeReferenceCounted<FdbCApi> {
 	FDBFuture* (*databaseGetServerProtocol)(FDBDatabase* database, uint64_t expectedVersion);
 
 	FDBFuture* (*databaseGetClientStatus)(FDBDatabase* db);
+	FDBFuture* (*databaseWarmLocationCache)(FDBDatabase* db,
+	                                        uint8_t const* beginKeyName,
+	                                        int beginKeyNameLength,
+	                                        uint8_t const* endKeyName,
+	                                        int endKeyNameLength);
 
 	// Transaction
 	fdb_error_t (*transactionSetOption)(FDBTransaction* tr,
@@ -144,6 +149,7 @@ struct FdbCApi : public ThreadSafeReferenceCounted<FdbCApi> {
 	FDBFuture* (*transactionGetReadVersion)(FDBTransaction* tr);
 
 	FDBFuture* (*transactionGet)(FDBTransaction* tr, uint8_t const* keyName, int keyNameLength, fdb_bool_t snapshot);
+	FDBFuture* (*transactionGetMultiple)(FDBTransaction* tr, FDBKey const* keys, int count, fdb_bool_t snapshot);
 	FDBFuture* (*transactionGetKey)(FDBTransaction* tr,
 	                                uint8_t const* keyName,
 	                                int keyNameLength,
@@ -190,6 +196,7 @@ struct FdbCApi : public ThreadSafeReferenceCounted<FdbCApi> {
 	                       int keyNameLength,
 	                       uint8_t const* value,
 	                       int valueLength);
+	void (*transactionSetMultiple)(FDBTransaction* tr, FDBKeyValue const* keyValues, int count);
 	void (*transactionClear)(FDBTransaction* tr, uint8_t const* keyName, int keyNameLength);
 	void (*transactionClearRange)(FDBTransaction* tr,
 	                              uint8_t const* beginKeyName,
@@ -278,6 +285,7 @@ public:
 	ThreadFuture<Version> getReadVersion() override;
 
 	ThreadFuture<Optional<Value>> get(const KeyRef& key, bool snapshot = false) override;
+	ThreadFuture<RangeResult> getMultiple(const VectorRef<KeyRef>& keys, bool snapshot = false) override;
 	ThreadFuture<Key> getKey(const KeySelectorRef& key, bool snapshot = false) override;
 	ThreadFuture<RangeResult> getRange(const KeySelectorRef& begin,
 	                                   const KeySelectorRef& end,
@@ -313,6 +321,7 @@ public:
 
 	void atomicOp(const KeyRef& key, const ValueRef& value, uint32_t operationType) override;
 	void set(const KeyRef& key, const ValueRef& value) override;
+	void setMultiple(const VectorRef<KeyValueRef>& keyValues) override;
 	void clear(const KeyRef& begin, const KeyRef& end) override;
 	void clear(const KeyRangeRef& range) override;
 	void clear(const KeyRef& key) override;
@@ -382,6 +391,8 @@ public:
 	// Return a JSON string containing database client-side status information
 	ThreadFuture<Standalone<StringRef>> getClientStatus() override;
 
+	ThreadFuture<Void> warmLocationCache(const KeyRangeRef& keys) override;
+
 private:
 	const Reference<FdbCApi> api;
 	FdbCApi::FDBDatabase*
@@ -441,6 +452,7 @@ public:
 	ThreadFuture<Version> getReadVersion() override;
 
 	ThreadFuture<Optional<Value>> get(const KeyRef& key, bool snapshot = false) override;
+	ThreadFuture<RangeResult> getMultiple(const VectorRef<KeyRef>& keys, bool snapshot = false) override;
 	ThreadFuture<Key> getKey(const KeySelectorRef& key, bool snapshot = false) override;
 	ThreadFuture<RangeResult> getRange(const KeySelectorRef& begin,
 	                                   const KeySelectorRef& end,
@@ -477,6 +489,7 @@ public:
 
 	void atomicOp(const KeyRef& key, const ValueRef& value, uint32_t operationType) override;
 	void set(const KeyRef& key, const ValueRef& value) override;
+	void setMultiple(const VectorRef<KeyValueRef>& keyValues) override;
 	void clear(const KeyRef& begin, const KeyRef& end) override;
 	void clear(const KeyRangeRef& range) override;
 	void clear(const KeyRef& key) override;
@@ -694,6 +707,8 @@ public:
 	// Return a JSON string containing database client-side status information
 	ThreadFuture<Standalone<StringRef>> getClientStatus() override;
 
+	ThreadFuture<Void> warmLocationCache(const KeyRangeRef& keys) override;
+
 	// private:
 
 	// Database initialization state
@@ -176,6 +176,7 @@ struct TransactionOptions {
 	bool bypassStorageQuota : 1;
 	bool enableReplicaConsistencyCheck : 1;
 	int requiredReplicas;
+	int64_t rangeStreamExportWindow; // In-flight byte window for getRangeStream in export mode, 0 if disabled
 
 	TransactionPriority priority;
 
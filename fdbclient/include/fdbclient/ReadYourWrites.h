@@ -76,6 +76,7 @@ public:
 	Future<Version> getReadVersion();
 	Optional<Version> getCachedReadVersion() const { return tr.getCachedReadVersion(); }
 	Future<Optional<Value>> get(const Key& key, Snapshot = Snapshot::False);
+	Future<RangeResult> getMultiple(const Standalone<VectorRef<KeyRef>>& keys, Snapshot = Snapshot::False);
 	Future<Key> getKey(const KeySelector& key, Snapshot = Snapshot::False);
 	Future<RangeResult> getRange(const KeySelector& begin,
 	                             const KeySelector& end,
@@ -123,6 +124,7 @@ public:
 
 	void atomicOp(const KeyRef& key, const ValueRef& operand, uint32_t operationType);
 	void set(const KeyRef& key, const ValueRef& value);
+	void setMultiple(const VectorRef<KeyValueRef>& keyValues);
 	void clear(const KeyRangeRef& range);
 	void clear(const KeyRef& key);
 
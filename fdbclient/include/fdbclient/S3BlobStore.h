@@ -94,6 +94,9 @@ public:
 		Counter newConnections;
 		Counter expiredConnections;
 		Counter reusedConnections;
+		Counter idleClosedConnections;
+		Counter prewarmedConnections;
+		Counter throttledResponses;
 		Counter fastRetries;
 
 		LatencySample requestLatency;
@@ -104,7 +107,9 @@ public:
 		  : id(deterministicRandom()->randomUniqueID()), cc("BlobStoreStats", id.toString()),
 		    requestsSuccessful("RequestsSuccessful", cc), requestsFailed("RequestsFailed", cc),
 		    newConnections("NewConnections", cc), expiredConnections("ExpiredConnections", cc),
-		    reusedConnections("ReusedConnections", cc), fastRetries("FastRetries", cc),
+		    reusedConnections("ReusedConnections", cc), idleClosedConnections("IdleClosedConnections", cc),
+		    prewarmedConnections("PrewarmedConnections", cc), throttledResponses("ThrottledResponses", cc),
+		    fastRetries("FastRetries", cc),
 		    requestLatency("BlobStoreRequestLatency",
 		                   id,
 		                   CLIENT_KNOBS->BLOBSTORE_LATENCY_LOGGING_INTERVAL,
@@ -129,6 +134,14 @@ public:
 				}
 				return totalConnections;
 			});
+			specialCounter(blobStats->cc, "ConnectionReusePercent", [this]() {
+				int64_t reused = this->blobStats->reusedConnections.getValue();
+				int64_t total = reused + this->blobStats->newConnections.getValue();
+				return total > 0 ? 100 * reused / total : 0;
+			});
+			specialCounter(
+			    blobStats->cc, "ConcurrencyLimit", [this]() { return (int64_t)this->adaptiveConcurrency.limit; });
+			specialCounter(blobStats->cc, "RequestsInFlight", [this]() { return this->adaptiveConcurrency.inFlight; });
 
 			statsLogger = blobStats->cc.traceCounters(
 			    "BlobStoreMetrics", blobStats->id, CLIENT_KNOBS->BLOBSTORE_STATS_LOGGING_INTERVAL, "BlobStoreMetrics");
@@ -149,7 +162,8 @@ public:
 		    concurrent_uploads, concurrent_lists, concurrent_reads_per_file, concurrent_writes_per_file,
 		    enable_read_cache, read_block_size, read_ahead_blocks, read_cache_blocks_per_file,
 		    max_send_bytes_per_second, max_recv_bytes_per_second, sdk_auth, enable_object_integrity_check,
-		    global_connection_pool, max_delay_retryable_error, max_delay_connection_failed, multipart_retry_delay_ms;
+		    global_connection_pool, max_delay_retryable_error, max_delay_connection_failed, multipart_retry_delay_ms,
+		    max_idle_connection_time, prewarm_connections, adaptive_concurrency;
 
 		bool set(StringRef name, int value);
 		std::string getURLParameters() const;
@@ -191,7 +205,13 @@ public:
 				"sdk_auth (or sa)                      Use AWS SDK to resolve credentials. Only valid if "
 				"BUILD_AWS_BACKUP is enabled.",
 				"enable_object_integrity_check (or eoic) Enable integrity check on GET requests (Default: false).",
-				"global_connection_pool (or gcp)       Enable shared connection pool between all blobstore instances."
+				"global_connection_pool (or gcp)       Enable shared connection pool between all blobstore instances.",
+				"max_idle_connection_time (or mict)    Max seconds a pooled connection may sit idle and still be reused, "
+				"0 for no limit.",
+				"prewarm_connections (or pwc)          Number of connections opened ahead of demand when the pool runs "
+				"dry.",
+				"adaptive_concurrency (or acc)         Set 1 to adapt the requests in flight to throttling and latency, "
+				"up to concurrent_requests."
 			};
 		}
 
@@ -201,14 +221,15 @@ public:
 	struct ReusableConnection {
 		Reference<IConnection> conn;
 		double expirationTime;
+		double idleSince; // When the connection was last returned to the pool
 		// CROSS_PROCESS_FIX: Track which process created this connection
 		NetworkAddress creatingProcess;
-		ReusableConnection() : expirationTime(0) {
+		ReusableConnection() : expirationTime(0), idleSince(0) {
 			if (g_network && g_network->isSimulated()) {
 				creatingProcess = g_network->getLocalAddress();
 			}
 		}
-		ReusableConnection(Reference<IConnection> c, double exp) : conn(c), expirationTime(exp) {
+		ReusableConnection(Reference<IConnection> c, double exp) : conn(c), expirationTime(exp), idleSince(0) {
 			if (g_network && g_network->isSimulated()) {
 				creatingProcess = g_network->getLocalAddress();
 			}
@@ -216,7 +237,8 @@ public:
 
 		// CROSS_PROCESS_FIX: Copy constructor with cross-process detection
 		ReusableConnection(const ReusableConnection& other)
-		  : conn(other.conn), expirationTime(other.expirationTime), creatingProcess(other.creatingProcess) {
+		  : conn(other.conn), expirationTime(other.expirationTime), idleSince(other.idleSince),
+		    creatingProcess(other.creatingProcess) {
 			if (g_network && g_network->isSimulated() && creatingProcess.isValid() &&
 			    creatingProcess != g_network->getLocalAddress()) {
 				// Cross-process copy detected - invalidate the connection to prevent sharing
@@ -230,6 +252,7 @@ public:
 			if (this != &other) {
 				conn = other.conn;
 				expirationTime = other.expirationTime;
+				idleSince = other.idleSince;
 				creatingProcess = other.creatingProcess;
 				if (g_network && g_network->isSimulated() && creatingProcess.isValid() &&
 				    creatingProcess != g_network->getLocalAddress()) {
@@ -242,6 +265,44 @@ public:
 		}
 	};
 
+	// Cap on the number of request attempts in flight to the endpoint, adapted between
+	// BLOBSTORE_ADAPTIVE_CONCURRENCY_MIN and concurrent_requests when adaptive_concurrency is set.
+	// The limit starts at BLOBSTORE_ADAPTIVE_CONCURRENCY_MIN and grows by one for every successful request, roughly
+	// doubling per round trip, until the first sign of congestion. It is halved when the server throttles (429 or
+	// 503) or when recent latency inflates beyond BLOBSTORE_ADAPTIVE_CONCURRENCY_LATENCY_RATIO times the long-term
+	// latency, at most once per recent latency. After that it grows by one for every limit successful requests.
+	struct AdaptiveConcurrency {
+		bool enabled;
+		bool slowStart;
+		double limit;
+		double maxLimit;
+		int inFlight;
+		int successes;
+		double recentLatency;
+		double longTermLatency;
+		double lastDecrease;
+		AsyncTrigger released;
+
+		explicit AdaptiveConcurrency(BlobKnobs const& knobs);
+
+		// Wait for a slot under the current limit. Must be paired with release().
+		Future<Void> take();
+		void release();
+		void onResponse(double latency, bool throttled);
+
+		struct Releaser : NonCopyable {
+			AdaptiveConcurrency* ac;
+			explicit Releaser(AdaptiveConcurrency& ac) : ac(&ac) {}
+			void release() {
+				if (ac != nullptr) {
+					ac->release();
+					ac = nullptr;
+				}
+			}
+			~Releaser() { release(); }
+		};
+	};
+
 	// basically, reference counted queue with option to add other fields
 	struct ConnectionPoolData : NonCopyable, ReferenceCounted<ConnectionPoolData> {
 		std::queue<ReusableConnection> pool;
@@ -286,7 +347,8 @@ public:
 	    requestRateDelete(new SpeedLimit(knobs.delete_requests_per_second, 1)),
 	    sendRate(new SpeedLimit(knobs.max_send_bytes_per_second, 1)),
 	    recvRate(new SpeedLimit(knobs.max_recv_bytes_per_second, 1)), concurrentRequests(knobs.concurrent_requests),
-	    concurrentUploads(knobs.concurrent_uploads), concurrentLists(knobs.concurrent_lists) {
+	    concurrentUploads(knobs.concurrent_uploads), concurrentLists(knobs.concurrent_lists),
+	    adaptiveConcurrency(knobs) {
 
 		if (host.empty() || (proxyHost.present() != proxyPort.present()))
 			throw connection_string_invalid();
@@ -311,6 +373,9 @@ public:
 		maybeStartStatsLogger();
 	}
 
+	// Prewarming only holds a pointer to this endpoint, so stop it before any of the members it uses go away
+	~S3BlobStoreEndpoint() { prewarming.cancel(); }
+
 	static std::string getURLFormat(bool withResource = false) {
 		const char* resource = "";
 		if (withResource)
@@ -343,6 +408,10 @@ public:
 	Reference<ConnectionPoolData> connectionPool;
 	Future<ReusableConnection> connect(bool* reusingConn);
 	void returnConnection(ReusableConnection& conn);
+	// Opens prewarm_connections connections into the pool in the background, at most one round at a time.
+	// Prewarming does not keep the endpoint alive and is cancelled when the endpoint is destroyed.
+	void maybePrewarmConnections();
+	Future<Void> prewarming;
 
 	std::string host;
 	std::string service;
@@ -368,6 +437,7 @@ public:
 	FlowLock concurrentRequests;
 	FlowLock concurrentUploads;
 	FlowLock concurrentLists;
+	AdaptiveConcurrency adaptiveConcurrency;
 
 	Future<Void> updateSecret();
 
@@ -112,13 +112,6 @@ Future<Void> copyUpBulkDumpFileSet(std::string s3url,
 // Returns a Future that completes when the operation is done
 Future<Void> deleteResource(std::string s3url);
 
-// Calculate the xxhash64 checksum of a file.
-// Used for verifying data integrity during uploads and downloads.
-// file: File handle to calculate checksum for
-// size: Size of the file in bytes, or -1 to determine automatically
-// Returns an AsyncResult that completes with the hex string representation of the checksum
-AsyncResult<std::string> calculateFileChecksum(Reference<IAsyncFile> file, int64_t size = -1);
-
 // List files and directories at the given S3 URL
 // s3url: S3 URL to list (must include bucket parameter)
 // maxDepth: Maximum depth to recurse (default: 1)
@@ -127,6 +127,7 @@ struct StorageServerInterface {
 	RequestStream<struct GetHotShardsRequest> getHotShards;
 	RequestStream<struct GetStorageCheckSumRequest> getCheckSum;
 	RequestStream<struct BulkDumpRequest> bulkdump;
+	RequestStream<struct RangeModifiedVersionsRequest> getRangeModifiedVersions;
 
 private:
 	void initEndpointsFromGetValue();
@@ -437,6 +438,9 @@ struct GetKeyValuesStreamRequest {
 	VersionVector ssLatestCommitVersions; // includes the latest commit versions, as known
 	                                      // to this client, of all storage replicas that
 	                                      // serve the given key range
+	// If positive, the stream is served in export mode: the storage server reads ahead in large blocks and keeps up
+	// to this many unacknowledged bytes in flight. Zero keeps the default per-reply limits.
+	int64_t exportWindowBytes = 0;
 
 	GetKeyValuesStreamRequest() {}
 
@@ -455,6 +459,7 @@ struct GetKeyValuesStreamRequest {
 		           spanContext,
 		           options,
 		           ssLatestCommitVersions,
+		           exportWindowBytes,
 		           arena);
 	}
 };
@@ -790,6 +795,35 @@ struct SplitRangeRequest {
 	}
 };
 
+struct RangeModifiedVersionsReply {
+	constexpr static FileIdentifier file_identifier = 13072296;
+	// Each shard of the requested range (clipped to it) and the latest version at which a mutation to the shard was
+	// applied. A shard that has not been modified since it was assigned to the server reports the version it was
+	// assigned at, so the versions are upper bounds.
+	std::vector<std::pair<KeyRange, Version>> shards;
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, shards);
+	}
+};
+
+struct RangeModifiedVersionsRequest {
+	constexpr static FileIdentifier file_identifier = 6218743;
+	Arena arena;
+	KeyRangeRef keys;
+	Version version; // The reply accounts for every mutation at or before this version
+	ReplyPromise<RangeModifiedVersionsReply> reply;
+
+	RangeModifiedVersionsRequest() : version(invalidVersion) {}
+	RangeModifiedVersionsRequest(KeyRangeRef const& keys, Version version) : keys(arena, keys), version(version) {}
+
+	template <class Ar>
+	void serialize(Ar& ar) {
+		serializer(ar, keys, version, reply, arena);
+	}
+};
+
 struct ChangeFeedStreamReply : public ReplyPromiseStreamReply {
 	constexpr static FileIdentifier file_identifier = 1783066;
 	Arena arena;
@@ -64,6 +64,8 @@ public:
 	// Return a JSON string containing database client-side status information
 	ThreadFuture<Standalone<StringRef>> getClientStatus() override;
 
+	ThreadFuture<Void> warmLocationCache(const KeyRangeRef& keys) override;
+
 private:
 	friend class ThreadSafeTransaction;
 	DatabaseContext* db;
@@ -90,6 +92,7 @@ public:
 	ThreadFuture<Version> getReadVersion() override;
 
 	ThreadFuture<Optional<Value>> get(const KeyRef& key, bool snapshot = false) override;
+	ThreadFuture<RangeResult> getMultiple(const VectorRef<KeyRef>& keys, bool snapshot = false) override;
 	ThreadFuture<Key> getKey(const KeySelectorRef& key, bool snapshot = false) override;
 	ThreadFuture<RangeResult> getRange(const KeySelectorRef& begin,
 	                                   const KeySelectorRef& end,
@@ -130,6 +133,7 @@ public:
 
 	void atomicOp(const KeyRef& key, const ValueRef& value, uint32_t operationType) override;
 	void set(const KeyRef& key, const ValueRef& value) override;
+	void setMultiple(const VectorRef<KeyValueRef>& keyValues) override;
 	void clear(const KeyRef& begin, const KeyRef& end) override;
 	void clear(const KeyRangeRef& range) override;
 	void clear(const KeyRef& key) override;
@@ -48,12 +48,75 @@ void QueueModel::endRequest(uint64_t id, double latency, double penalty, double
 	if (penalty > 0) {
 		d.penalty = penalty;
 	}
+
+	if (latencySketchSelection && latency > 0) {
+		if (!d.latencies) {
+			d.latencies = std::make_unique<LatencySketch>();
+		}
+		d.latencies->addSample(latency);
+	}
 }
 
 QueueData const& QueueModel::getMeasurement(uint64_t id) {
 	return data[id]; // return smoothed penalty
 }
 
+Optional<double> QueueModel::predictTailLatency(uint64_t id) {
+	auto& d = data[id];
+	if (!d.latencies) {
+		return Optional<double>();
+	}
+	return d.latencies->tailLatency();
+}
+
+Optional<double> QueueModel::predictMedianLatency(uint64_t id) {
+	auto& d = data[id];
+	if (!d.latencies) {
+		return Optional<double>();
+	}
+	return d.latencies->medianLatency();
+}
+
+void LatencySketch::addSample(double latency) {
+	if (now() - windowStart > FLOW_KNOBS->LOAD_BALANCE_SKETCH_WINDOW) {
+		std::swap(current, previous);
+		current.clear();
+		windowStart = now();
+	}
+	current.addSample(latency);
+	stale = true;
+}
+
+Optional<double> LatencySketch::tailLatency() {
+	refresh();
+	return tail;
+}
+
+Optional<double> LatencySketch::medianLatency() {
+	refresh();
+	return median;
+}
+
+void LatencySketch::refresh() {
+	if (!stale) {
+		return;
+	}
+	stale = false;
+	DDSketch<double>* sketch = nullptr;
+	if (current.getPopulationSize() >= FLOW_KNOBS->LOAD_BALANCE_SKETCH_MIN_SAMPLES) {
+		sketch = &current;
+	} else if (previous.getPopulationSize() >= FLOW_KNOBS->LOAD_BALANCE_SKETCH_MIN_SAMPLES) {
+		sketch = &previous;
+	}
+	if (sketch == nullptr) {
+		tail = Optional<double>();
+		median = Optional<double>();
+		return;
+	}
+	tail = sketch->percentile(FLOW_KNOBS->LOAD_BALANCE_SKETCH_PERCENTILE);
+	median = sketch->median();
+}
+
 double QueueModel::addRequest(uint64_t id) {
 	auto& d = data[id];
 	d.smoothOutstanding.addDelta(d.penalty);
@@ -688,7 +688,57 @@ Future<REPLY_TYPE(Request)> loadBalance(
 	if (nextAlt >= bestAlt)
 		nextAlt++;
 
-	if (model) {
+	state bool choseByLatency = false;
+	if (model && model->latencySketchSelection) {
+		// Power of two choices among the healthy alternatives in the same DC (or all healthy alternatives, if fewer
+		// than two local ones are healthy), ranked by their predicted tail latency. Servers without enough latency
+		// samples are predicted at 0 so that they get explored.
+		std::vector<int> candidates;
+		for (int i = 0; i < alternatives->size(); i++) {
+			if (i == alternatives->countBest() && candidates.size() >= 2) {
+				break;
+			}
+			RequestStream<Request, P> const* thisStream = &alternatives->get(i, channel);
+			if (IFailureMonitor::failureMonitor().getState(thisStream->getEndpoint()).failed) {
+				continue;
+			}
+			auto const& qd = model->getMeasurement(thisStream->getEndpoint().token.first());
+			if (now() <= qd.failedUntil || (FLOW_KNOBS->LOAD_BALANCE_PENALTY_IS_BAD && qd.penalty > 1.001)) {
+				continue;
+			}
+			candidates.push_back(i);
+		}
+
+		if (candidates.size() >= 2) {
+			int first = deterministicRandom()->randomInt(0, candidates.size());
+			int second = deterministicRandom()->randomInt(0, candidates.size() - 1);
+			if (second >= first) {
+				second++;
+			}
+			auto endpointId = [&](int alt) { return alternatives->get(alt, channel).getEndpoint().token.first(); };
+			double firstTime = model->predictTailLatency(endpointId(candidates[first])).orDefault(0.0);
+			double secondTime = model->predictTailLatency(endpointId(candidates[second])).orDefault(0.0);
+			if (secondTime < firstTime) {
+				std::swap(first, second);
+				std::swap(firstTime, secondTime);
+			}
+			bestAlt = candidates[first];
+			nextAlt = candidates[second];
+			choseByLatency = true;
+
+			if (firstTime > FLOW_KNOBS->LOAD_BALANCE_SKETCH_HEDGE_LATENCY) {
+				// Even the better choice has a slow tail, so hedge once the request has outlived the server's typical
+				// latency. The second request budget still bounds how often this happens.
+				CODE_PROBE(true, "Load balance hedging a read predicted to be slow");
+				secondDelay = delay(model->predictMedianLatency(endpointId(bestAlt)).orDefault(0.0) +
+				                    FLOW_KNOBS->BASE_SECOND_REQUEST_TIME);
+			} else {
+				secondDelay = delay(model->secondMultiplier * secondTime + FLOW_KNOBS->BASE_SECOND_REQUEST_TIME);
+			}
+		}
+	}
+
+	if (model && !choseByLatency) {
 		double bestMetric = 1e9; // Storage server with the least outstanding requests.
 		double nextMetric = 1e9;
 		double bestTime = 1e9; // The latency to the server with the least outstanding requests.
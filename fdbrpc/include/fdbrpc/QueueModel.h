@@ -24,6 +24,7 @@
 
 #include "flow/flow.h"
 #include "fdbrpc/Smoother.h"
+#include "fdbrpc/DDSketch.h"
 #include "flow/Knobs.h"
 #include "flow/ActorCollection.h"
 #include "fdbrpc/TSSComparison.h" // For TSS Metrics
@@ -38,6 +39,34 @@ struct TSSEndpointData {
 	  : tssId(tssId), endpoint(endpoint), metrics(metrics) {}
 };
 
+// Client perceived latency distribution of one storage server. Samples are added to the current sketch, which is
+// rotated out every LOAD_BALANCE_SKETCH_WINDOW seconds. The previous window is kept so that predictions remain
+// available right after a rotation.
+struct LatencySketch {
+	DDSketch<double> current;
+	DDSketch<double> previous;
+	double windowStart;
+
+	// A 5% relative error is plenty for ranking replicas and keeps each sketch to a few kilobytes.
+	LatencySketch() : current(0.05), previous(0.05), windowStart(now()), stale(false) {}
+
+	void addSample(double latency);
+
+	// Return the estimated LOAD_BALANCE_SKETCH_PERCENTILE and median latencies, or an empty Optional if neither
+	// window has at least LOAD_BALANCE_SKETCH_MIN_SAMPLES samples.
+	Optional<double> tailLatency();
+	Optional<double> medianLatency();
+
+private:
+	// Percentiles are found by scanning the sketch buckets, so they are computed once after the sketch changes and
+	// reused by every replica selection until the next sample.
+	Optional<double> tail;
+	Optional<double> median;
+	bool stale;
+
+	void refresh();
+};
+
 // The data structure used for the client-side load balancing algorithm to
 // decide which storage server to read data from. Conceptually, it tracks the
 // number of outstanding requests the current client sent to each storage
@@ -74,6 +103,9 @@ struct QueueData {
 	// a bit of a hack to store this here, but it's the only centralized place for per-endpoint tracking
 	Optional<TSSEndpointData> tssData;
 
+	// Latency distribution used by the latency sketch selection policy, allocated on the first sample.
+	std::unique_ptr<LatencySketch> latencies;
+
 	QueueData()
 	  : smoothOutstanding(FLOW_KNOBS->QUEUE_MODEL_SMOOTHING_AMOUNT), latency(0.001), penalty(1.0), failedUntil(0),
 	    futureVersionBackoff(FLOW_KNOBS->FUTURE_VERSION_INITIAL_BACKOFF), increaseBackoffTime(0) {}
@@ -102,6 +134,15 @@ public:
 
 	QueueData const& getMeasurement(uint64_t id);
 
+	// Return the predicted LOAD_BALANCE_SKETCH_PERCENTILE and median latencies of a request to server `id`, if enough
+	// latency samples have been collected for it. Only populated when latencySketchSelection is set.
+	Optional<double> predictTailLatency(uint64_t id);
+	Optional<double> predictMedianLatency(uint64_t id);
+
+	// If true, loadBalance() picks replicas by predicted tail latency instead of by outstanding requests. Initialized
+	// from LOAD_BALANCE_LATENCY_SKETCH.
+	bool latencySketchSelection;
+
 	double secondMultiplier;
 	double secondBudget;
 	PromiseStream<Future<Void>> addActor;
@@ -120,7 +161,9 @@ public:
 	// Retrieves the data for this endpoint's pair TSS endpoint, if present
 	Optional<TSSEndpointData> getTssData(uint64_t endpointId);
 
-	QueueModel() : secondMultiplier(1.0), secondBudget(0), laggingRequestCount(0) {
+	QueueModel()
+	  : latencySketchSelection(FLOW_KNOBS->LOAD_BALANCE_LATENCY_SKETCH), secondMultiplier(1.0), secondBudget(0),
+	    laggingRequestCount(0) {
 		laggingRequests = actorCollection(addActor.getFuture(), &laggingRequestCount);
 		tssComparisons = actorCollection(addTSSActor.getFuture(), &laggingTSSCompareCount);
 	}
@@ -709,12 +709,15 @@ static Future<Void> updateLogBytesWritten(BackupData* self,
 }
 
 // Saves messages in the range of [0, numMsg) to a file and then remove these
-// messages. The file content format is a sequence of (Version, sub#, msgSize, message).
+// messages. The file content format is a sequence of (Version, sub#, msgSize, message),
+// in compressed blocks if BACKUP_WORKER_LOG_COMPRESSION is set.
 // Note only ready backups are saved.
 Future<Void> saveMutationsToFile(BackupData* self, Version popVersion, int numMsg) {
 	int blockSize = SERVER_KNOBS->BACKUP_FILE_BLOCK_BYTES;
+	bool compress = SERVER_KNOBS->BACKUP_WORKER_LOG_COMPRESSION;
 	std::vector<Future<Reference<IBackupFile>>> logFileFutures;
 	std::vector<Reference<IBackupFile>> logFiles;
+	std::vector<Reference<fileBackup::CompressedMutationLogWriter>> writers; // Only used with compression
 	std::vector<int64_t> blockEnds;
 	std::vector<UID> activeUids; // active Backups' UIDs
 	std::vector<Version> beginVersions; // logFiles' begin versions
@@ -768,8 +771,18 @@ Future<Void> saveMutationsToFile(BackupData* self, Version popVersion, int numMs
 		TraceEvent("OpenMutationFile", self->myId)
 		    .detail("BackupID", activeUids[i])
 		    .detail("TagId", self->tag.id)
-		    .detail("File", logFiles[i]->getFileName());
+		    .detail("File", logFiles[i]->getFileName())
+		    .detail("Compressed", compress);
+		if (compress) {
+			writers.push_back(makeReference<fileBackup::CompressedMutationLogWriter>(logFiles[i], blockSize));
+		}
 	}
+	auto write = [&](int index, const VersionedMessage& message, StringRef mutation) {
+		if (compress) {
+			return writers[index]->addMessage(message.version.version, message.version.sub, mutation);
+		}
+		return addMutation(logFiles[index], message, mutation, &blockEnds[index], blockSize);
+	};
 
 	blockEnds = std::vector<int64_t>(logFiles.size(), 0);
 	for (idx = 0; idx < numMsg; idx++) {
@@ -787,8 +800,7 @@ Future<Void> saveMutationsToFile(BackupData* self, Version popVersion, int numMs
 		if (m.type != MutationRef::Type::ClearRange) {
 			for (int index : keyRangeMap[m.param1]) {
 				if (message.getVersion() >= beginVersions[index]) {
-					adds.push_back(
-					    addMutation(logFiles[index], message, message.message, &blockEnds[index], blockSize));
+					adds.push_back(write(index, message, message.message));
 				}
 			}
 		} else {
@@ -805,8 +817,7 @@ Future<Void> saveMutationsToFile(BackupData* self, Version popVersion, int numMs
 				mutations.push_back(wr.toValue());
 				for (int index : range.value()) {
 					if (message.getVersion() >= beginVersions[index]) {
-						adds.push_back(
-						    addMutation(logFiles[index], message, mutations.back(), &blockEnds[index], blockSize));
+						adds.push_back(write(index, message, mutations.back()));
 					}
 				}
 			}
@@ -816,9 +827,17 @@ Future<Void> saveMutationsToFile(BackupData* self, Version popVersion, int numMs
 	}
 
 	std::vector<Future<Void>> finished;
-	std::transform(logFiles.begin(), logFiles.end(), std::back_inserter(finished), [](const Reference<IBackupFile>& f) {
-		return f->finish();
-	});
+	if (compress) {
+		std::transform(writers.begin(),
+		               writers.end(),
+		               std::back_inserter(finished),
+		               [](const Reference<fileBackup::CompressedMutationLogWriter>& w) { return w->finish(); });
+	} else {
+		std::transform(logFiles.begin(),
+		               logFiles.end(),
+		               std::back_inserter(finished),
+		               [](const Reference<IBackupFile>& f) { return f->finish(); });
+	}
 
 	co_await waitForAll(finished);
 
@@ -838,6 +857,7 @@ Future<Void> saveMutationsToFile(BackupData* self, Version popVersion, int numMs
 // Uploads self->messages to cloud storage and updates savedVersion.
 Future<Void> uploadData(BackupData* self) {
 	Version popVersion = invalidVersion;
+	double lastSaveTime = now();
 
 	while (true) {
 		// Too large uploadDelay will delay popping tLog data for too long.
@@ -872,6 +892,18 @@ Future<Void> uploadData(BackupData* self) {
 			// If we aren't able to process any messages and the lock is blocking us from
 			// queuing more, then we are stuck. This could suggest the lock capacity is too small.
 			ASSERT(numMsg > 0 || self->lock->waiters() == 0);
+
+			// Batch small uploads into larger files: keep buffering until enough bytes are queued, the oldest
+			// buffered data is too old, or the lock is blocking the puller. This delays popping the TLogs and
+			// saving progress by up to BACKUP_WORKER_MAX_FILE_DELAY, so it is off unless a target size is set.
+			if (SERVER_KNOBS->BACKUP_WORKER_TARGET_FILE_BYTES > 0 &&
+			    self->lock->activePermits() < SERVER_KNOBS->BACKUP_WORKER_TARGET_FILE_BYTES &&
+			    now() - lastSaveTime < SERVER_KNOBS->BACKUP_WORKER_MAX_FILE_DELAY && self->lock->waiters() == 0 &&
+			    !self->stopped) {
+				popVersion = lastPopVersion;
+				co_await (uploadDelay || self->doneTrigger.onTrigger());
+				continue;
+			}
 		}
 		if ((numMsg > 0 || popVersion > lastPopVersion) || self->pullFinished()) {
 			TraceEvent("BackupWorkerSave", self->myId)
@@ -883,6 +915,7 @@ Future<Void> uploadData(BackupData* self) {
 			// save an empty file for old epochs so that log file versions are continuous
 			co_await saveMutationsToFile(self, popVersion, numMsg);
 			self->eraseMessages(numMsg);
+			lastSaveTime = now();
 		}
 
 		if (popVersion > self->savedVersion) {
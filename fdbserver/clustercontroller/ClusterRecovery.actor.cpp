@@ -1080,16 +1080,22 @@ Future<std::vector<Standalone<CommitTransactionRef>>> recruitEverything(
 	    .trackLatest(self->clusterRecoveryStateEventHolder->trackingKey);
 
 	// Actually, newSeedServers does both the recruiting and initialization of the seed servers; so if this is a
-	// brand new database we are sort of lying that we are past the recruitment phase.  In a perfect world we would
-	// split that up so that the recruitment part happens above (in parallel with recruiting the transaction
-	// servers?).
-	co_await newSeedServers(self, recruits, seedServers);
+	// brand new database we are sort of lying that we are past the recruitment phase. The stateless roles do not
+	// depend on the seed servers, so they can be initialized in the meantime. The tlogs must wait, since
+	// newSeedServers assigns the localities they are recruited with.
+	Future<Void> seedServersRecruited = newSeedServers(self, recruits, seedServers);
+	if (!SERVER_KNOBS->CLUSTER_RECOVERY_OVERLAP_PHASES) {
+		co_await seedServersRecruited;
+	}
+	Future<Void> statelessInitialized =
+	    traceAfter(newCommitProxies(self, recruits), "CommitProxiesInitialized") &&
+	    traceAfter(newGrvProxies(self, recruits), "GRVProxiesInitialized") &&
+	    traceAfter(newResolvers(self, recruits), "ResolversInitialized");
+	co_await seedServersRecruited;
 
 	std::vector<Standalone<CommitTransactionRef>> confChanges;
 	Future<Void> txnSystemInitialized =
-	    traceAfter(newCommitProxies(self, recruits), "CommitProxiesInitialized") &&
-	    traceAfter(newGrvProxies(self, recruits), "GRVProxiesInitialized") &&
-	    traceAfter(newResolvers(self, recruits), "ResolversInitialized") &&
+	    statelessInitialized &&
 	    traceAfter(newTLogServers(self, recruits, oldLogSystem, &confChanges), "TLogServersInitialized");
 	co_await (txnSystemInitialized || monitorInitializingTxnSystem(self->controllerData->db.unfinishedRecoveries));
 
@@ -1256,11 +1262,39 @@ Future<Void> readTransactionSystemState(Reference<ClusterRecoveryData> self,
 	TraceEvent("RTSSComplete", self->dbgid).log();
 }
 
+// Moves the resolvers to the end of the previous epoch, which lets them resolve the first batches of the new one
+Future<Void> initializeResolvers(Reference<ClusterRecoveryData> self) {
+	std::vector<Future<ResolveTransactionBatchReply>> replies;
+	for (auto& r : self->resolvers) {
+		ResolveTransactionBatchRequest req;
+		req.prevVersion = -1;
+		req.version = self->lastEpochEnd;
+		req.lastReceivedVersion = -1;
+		req.lastShardMove = -1;
+		replies.push_back(brokenPromiseToNever(r.resolve.getReply(req)));
+	}
+
+	co_await waitForAll(replies);
+	TraceEvent("RecoveryInternal", self->dbgid)
+	    .detail("StatusCode", RecoveryStatus::recovery_transaction)
+	    .detail("Status", RecoveryStatus::names[RecoveryStatus::recovery_transaction])
+	    .detail("RecoveryTxnVersion", self->recoveryTransactionVersion)
+	    .detail("LastEpochEnd", self->lastEpochEnd)
+	    .detail("Step", "InitializedAllResolvers");
+}
+
 Future<Void> sendInitialCommitToResolvers(Reference<ClusterRecoveryData> self) {
 	KeyRange txnKeys = allKeys;
 	Sequence txnSequence = 0;
 	ASSERT(self->recoveryTransactionVersion);
 
+	// The master's resolve request carries no transactions, so the resolvers do not need the txnStateStore to answer
+	// it and can be initialized while it is being sent.
+	Future<Void> resolversInitialized;
+	if (SERVER_KNOBS->CLUSTER_RECOVERY_OVERLAP_PHASES) {
+		resolversInitialized = initializeResolvers(self);
+	}
+
 	RangeResult data =
 	    self->txnStateStore
 	        ->readRange(txnKeys, BUGGIFY ? 3 : SERVER_KNOBS->DESIRED_TOTAL_BYTES, SERVER_KNOBS->DESIRED_TOTAL_BYTES)
@@ -1314,23 +1348,10 @@ Future<Void> sendInitialCommitToResolvers(Reference<ClusterRecoveryData> self) {
 	    .detail("LastEpochEnd", self->lastEpochEnd)
 	    .detail("Step", "SentTxnStateStoreToCommitProxies");
 
-	std::vector<Future<ResolveTransactionBatchReply>> replies;
-	for (auto& r : self->resolvers) {
-		ResolveTransactionBatchRequest req;
-		req.prevVersion = -1;
-		req.version = self->lastEpochEnd;
-		req.lastReceivedVersion = -1;
-		req.lastShardMove = -1;
-		replies.push_back(brokenPromiseToNever(r.resolve.getReply(req)));
+	if (!resolversInitialized.isValid()) {
+		resolversInitialized = initializeResolvers(self);
 	}
-
-	co_await waitForAll(replies);
-	TraceEvent("RecoveryInternal", self->dbgid)
-	    .detail("StatusCode", RecoveryStatus::recovery_transaction)
-	    .detail("Status", RecoveryStatus::names[RecoveryStatus::recovery_transaction])
-	    .detail("RecoveryTxnVersion", self->recoveryTransactionVersion)
-	    .detail("LastEpochEnd", self->lastEpochEnd)
-	    .detail("Step", "InitializedAllResolvers");
+	co_await resolversInitialized;
 }
 
 Future<Void> triggerUpdates(Reference<ClusterRecoveryData> self, Reference<ILogSystem> oldLogSystem) {
@@ -1408,6 +1429,7 @@ ACTOR Future<Void> recoverFrom(Reference<ClusterRecoveryData> self,
 
 	Version txsPoppedVersion = wait(poppedTxsVersion);
 	wait(readTransactionSystemState(self, oldLogSystem, txsPoppedVersion));
+	self->recoveryPhaseFinished("ReadTxnState");
 	for (auto& itr : *initialConfChanges) {
 		for (auto& m : itr.mutations) {
 			self->configuration.applyMutation(m);
@@ -1436,6 +1458,7 @@ ACTOR Future<Void> recoverFrom(Reference<ClusterRecoveryData> self,
 			when(std::vector<Standalone<CommitTransactionRef>> confChanges = wait(recruitments)) {
 				initialConfChanges->insert(initialConfChanges->end(), confChanges.begin(), confChanges.end());
 				provisional.cancel();
+				self->recoveryPhaseFinished("Recruit");
 				break;
 			}
 			when(Standalone<CommitTransactionRef> _req = wait(provisional)) {
@@ -1483,6 +1506,7 @@ ACTOR Future<Void> clusterRecoveryCore(Reference<ClusterRecoveryData> self) {
 	state double recoverStartTime = now();
 
 	self->addActor.send(waitFailureServer(self->masterInterface.waitFailure.getFuture()));
+	self->lastRecoveryPhaseEnd = recoverStartTime;
 
 	TraceEvent(recoveryInterval.begin(), self->dbgid).log();
 
@@ -1493,6 +1517,7 @@ ACTOR Future<Void> clusterRecoveryCore(Reference<ClusterRecoveryData> self) {
 	    .trackLatest(self->clusterRecoveryStateEventHolder->trackingKey);
 
 	wait(self->cstate.read());
+	self->recoveryPhaseFinished("ReadCState");
 
 	if (self->cstate.prevDBState.lowestCompatibleProtocolVersion > currentProtocolVersion()) {
 		TraceEvent(SevWarnAlways, "IncompatibleProtocolVersion", self->dbgid).log();
@@ -1560,6 +1585,7 @@ ACTOR Future<Void> clusterRecoveryCore(Reference<ClusterRecoveryData> self) {
 		newState.lowestCompatibleProtocolVersion = minCompatibleProtocolVersion;
 	}
 	wait(self->cstate.write(newState) || recoverAndEndEpoch);
+	self->recoveryPhaseFinished("LockCState");
 
 	TraceEvent("ProtocolVersionCompatibilityChecked", self->dbgid)
 	    .detail("NewestProtocolVersion", self->cstate.myDBState.newestProtocolVersion)
@@ -1581,6 +1607,7 @@ ACTOR Future<Void> clusterRecoveryCore(Reference<ClusterRecoveryData> self) {
 			if (!minRecoveryDuration.isValid()) {
 				minRecoveryDuration = delay(SERVER_KNOBS->ENFORCED_MIN_RECOVERY_DURATION);
 				poppedTxsVersion = oldLogSystem->getTxsPoppedVersion();
+				self->recoveryPhaseFinished("LockTLogs");
 			}
 		}
 
@@ -1746,6 +1773,7 @@ ACTOR Future<Void> clusterRecoveryCore(Reference<ClusterRecoveryData> self) {
 		CODE_PROBE(true, "Cluster recovery failed because of the initial commit failed");
 		throw cluster_recovery_failed();
 	}
+	self->recoveryPhaseFinished("RecoveryTransaction");
 
 	ASSERT(self->recoveryTransactionVersion != 0);
 
@@ -1770,6 +1798,7 @@ ACTOR Future<Void> clusterRecoveryCore(Reference<ClusterRecoveryData> self) {
 	self->addActor.send(trackTlogRecovery(self, oldLogSystems, minRecoveryDuration));
 	debug_advanceMaxCommittedVersion(UID(), self->recoveryTransactionVersion);
 	wait(self->cstateUpdated.getFuture());
+	self->recoveryPhaseFinished("WriteCState");
 	debug_advanceMinCommittedVersion(UID(), self->recoveryTransactionVersion);
 
 	if (debugResult) {
@@ -1787,11 +1816,16 @@ ACTOR Future<Void> clusterRecoveryCore(Reference<ClusterRecoveryData> self) {
 	self->recoveryState = RecoveryState::ACCEPTING_COMMITS;
 	double recoveryDuration = now() - recoverStartTime;
 
-	TraceEvent((recoveryDuration > 4 && !g_network->isSimulated()) ? SevWarnAlways : SevInfo,
-	           getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_DURATION_EVENT_NAME).c_str(),
-	           self->dbgid)
-	    .detail("RecoveryDuration", recoveryDuration)
-	    .trackLatest(self->clusterRecoveryDurationEventHolder->trackingKey);
+	{
+		TraceEvent ev((recoveryDuration > 4 && !g_network->isSimulated()) ? SevWarnAlways : SevInfo,
+		              getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_DURATION_EVENT_NAME).c_str(),
+		              self->dbgid);
+		ev.detail("RecoveryDuration", recoveryDuration);
+		for (auto const& [phase, duration] : self->recoveryPhaseDurations) {
+			ev.detail(phase + "Duration", duration);
+		}
+		ev.trackLatest(self->clusterRecoveryDurationEventHolder->trackingKey);
+	}
 
 	TraceEvent(getRecoveryEventName(ClusterRecoveryEventType::CLUSTER_RECOVERY_STATE_EVENT_NAME).c_str(), self->dbgid)
 	    .detail("StatusCode", RecoveryStatus::accepting_commits)
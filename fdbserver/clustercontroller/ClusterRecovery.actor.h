@@ -241,6 +241,15 @@ struct ClusterRecoveryData : NonCopyable, ReferenceCounted<ClusterRecoveryData>
 	int64_t registrationCount; // Number of different MasterRegistrationRequests sent to clusterController
 
 	RecoveryState recoveryState;
+	// Duration of each phase of the current recovery, reported with the recovery duration event
+	std::map<std::string, double> recoveryPhaseDurations;
+	double lastRecoveryPhaseEnd;
+
+	void recoveryPhaseFinished(std::string const& phase) {
+		double t = now();
+		recoveryPhaseDurations[phase] = t - lastRecoveryPhaseEnd;
+		lastRecoveryPhaseEnd = t;
+	}
 
 	PromiseStream<Future<Void>> addActor;
 	Reference<AsyncVar<bool>> recruitmentStalled;
@@ -283,7 +292,8 @@ struct ClusterRecoveryData : NonCopyable, ReferenceCounted<ClusterRecoveryData>
 	    databaseLocked(false), minKnownCommittedVersion(invalidVersion), hasConfiguration(false),
 	    coordinators(coordinators), lastVersionTime(0), txnStateStore(nullptr), memoryLimit(2e9), dbId(dbId),
 	    masterInterface(masterInterface), masterLifetime(masterLifetimeToken), clusterController(clusterController),
-	    cstate(coordinators, addActor, dbgid), dbInfo(dbInfo), registrationCount(0), addActor(addActor),
+	    cstate(coordinators, addActor, dbgid), dbInfo(dbInfo), registrationCount(0), lastRecoveryPhaseEnd(now()),
+	    addActor(addActor),
 	    recruitmentStalled(makeReference<AsyncVar<bool>>(false)), forceRecovery(forceRecovery), neverCreated(false),
 	    safeLocality(tagLocalityInvalid), primaryLocality(tagLocalityInvalid),
 	    cc("ClusterRecoveryData", dbgid.toString()), changeCoordinatorsRequests("ChangeCoordinatorsRequests", cc),
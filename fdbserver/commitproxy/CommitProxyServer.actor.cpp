@@ -19,6 +19,7 @@
  */
 
 #include <algorithm>
+#include <numeric>
 #include <string_view>
 #include <tuple>
 #include <variant>
@@ -560,6 +561,12 @@ struct CommitBatchContext {
 	int transactionNum = 0;
 	int yieldBytes = 0;
 
+	// keyInfo ranges containing the first key of each mutation assignMutationsToStorageServers() assigns, in order.
+	// Empty when the lookups are done during assignment instead.
+	std::vector<KeyRangeMap<ServerCacheInfo>::iterator> mutationRanges;
+	int mutationRangeIndex = 0;
+	Optional<KeyRangeMap<ServerCacheInfo>::iterator> lastMutationRange;
+
 	LogSystemDiskQueueAdapter::CommitMessage msg;
 
 	Future<Version> loggingComplete;
@@ -804,9 +811,13 @@ ACTOR Future<Void> preresolutionProcessing(CommitBatchContext* self) {
 		self->pProxyCommitData->lastMasterReset = now();
 	}
 
-	// Pre-resolution the commits
-	CODE_PROBE(pProxyCommitData->latestLocalCommitBatchResolving.get() < localBatchNumber - 1, "Wait for local batch");
-	wait(pProxyCommitData->latestLocalCommitBatchResolving.whenAtLeast(localBatchNumber - 1));
+	// Pre-resolution the commits. A deeper resolution pipeline only waits for the previous batch to ask for its
+	// commit version, the rest of the ordering is kept below.
+	state int pipelineDepth = SERVER_KNOBS->PROXY_RESOLUTION_PIPELINE_DEPTH;
+	state NotifiedVersion& previousBatchStage = pipelineDepth > 0 ? pProxyCommitData->latestLocalCommitBatchVersioning
+	                                                               : pProxyCommitData->latestLocalCommitBatchResolving;
+	CODE_PROBE(previousBatchStage.get() < localBatchNumber - 1, "Wait for local batch");
+	wait(previousBatchStage.whenAtLeast(localBatchNumber - 1));
 	double queuingDelay = g_network->timer_monotonic() - startTime;
 	pProxyCommitData->stats.computeLatency.addMeasurement(queuingDelay);
 	pProxyCommitData->stats.commitBatchQueuingDist->sampleSeconds(queuingDelay);
@@ -820,6 +831,11 @@ ACTOR Future<Void> preresolutionProcessing(CommitBatchContext* self) {
 		    .detail("QDelay", queuingDelay)
 		    .detail("Transactions", trs.size())
 		    .detail("BatchNumber", localBatchNumber);
+		if (pipelineDepth > 0) {
+			ASSERT(pProxyCommitData->latestLocalCommitBatchVersioning.get() == localBatchNumber - 1);
+			pProxyCommitData->latestLocalCommitBatchVersioning.set(localBatchNumber);
+			wait(pProxyCommitData->latestLocalCommitBatchResolving.whenAtLeast(localBatchNumber - 1));
+		}
 		ASSERT(pProxyCommitData->latestLocalCommitBatchResolving.get() == localBatchNumber - 1);
 		pProxyCommitData->latestLocalCommitBatchResolving.set(localBatchNumber);
 
@@ -836,7 +852,14 @@ ACTOR Future<Void> preresolutionProcessing(CommitBatchContext* self) {
 		return Void();
 	}
 
-	self->releaseDelay = delay(computeReleaseDelay(self, latencyBucket), TaskPriority::ProxyMasterVersionReply);
+	if (pipelineDepth > 0) {
+		// Let the next batch resolve once no more than pipelineDepth batches are between resolution and logging,
+		// instead of pacing it by the estimated compute time of this one
+		self->releaseDelay =
+		    pProxyCommitData->latestLocalCommitBatchLogging.whenAtLeast(localBatchNumber - pipelineDepth);
+	} else {
+		self->releaseDelay = delay(computeReleaseDelay(self, latencyBucket), TaskPriority::ProxyMasterVersionReply);
+	}
 
 	if (debugID.present()) {
 		g_traceBatch.addEvent(
@@ -856,10 +879,21 @@ ACTOR Future<Void> preresolutionProcessing(CommitBatchContext* self) {
 	                            pProxyCommitData->mostRecentProcessedRequestNumber,
 	                            pProxyCommitData->dbgid);
 	state double beforeGettingCommitVersion = g_network->timer_monotonic();
-	GetCommitVersionReply versionReply = wait(brokenPromiseToNever(
-	    pProxyCommitData->master.getCommitVersion.getReply(req, TaskPriority::ProxyMasterVersionReply)));
+	state Future<GetCommitVersionReply> versionReplyFuture = brokenPromiseToNever(
+	    pProxyCommitData->master.getCommitVersion.getReply(req, TaskPriority::ProxyMasterVersionReply));
+	if (pipelineDepth > 0) {
+		// The master serves requests in request number order, so the next batch can ask for its version now
+		ASSERT(pProxyCommitData->latestLocalCommitBatchVersioning.get() == localBatchNumber - 1);
+		pProxyCommitData->latestLocalCommitBatchVersioning.set(localBatchNumber);
+	}
+	GetCommitVersionReply versionReply = wait(versionReplyFuture);
+	if (pipelineDepth > 0) {
+		// Resolver changes and resolution requests must still follow batch order
+		wait(pProxyCommitData->latestLocalCommitBatchResolving.whenAtLeast(localBatchNumber - 1));
+	}
 
-	pProxyCommitData->mostRecentProcessedRequestNumber = versionReply.requestNum;
+	pProxyCommitData->mostRecentProcessedRequestNumber =
+	    std::max(pProxyCommitData->mostRecentProcessedRequestNumber, versionReply.requestNum);
 
 	pProxyCommitData->stats.txnCommitVersionAssigned += trs.size();
 	pProxyCommitData->stats.lastCommitVersionAssigned = versionReply.version;
@@ -917,6 +951,9 @@ ACTOR Future<Void> getResolution(CommitBatchContext* self) {
 		ASSERT(requests.requests[r].txnStateTransactions.size() == requests.requests[0].txnStateTransactions.size());
 
 	pProxyCommitData->stats.txnCommitResolving += trs.size();
+	pProxyCommitData->stats.resolutionPipelineDepth.addMeasurement(
+	    self->localBatchNumber - 1 - pProxyCommitData->latestLocalCommitBatchLogging.get());
+	state double resolutionSent = g_network->timer_monotonic();
 	std::vector<Future<ResolveTransactionBatchReply>> replies;
 	for (int r = 0; r < pProxyCommitData->resolvers.size(); r++) {
 		requests.requests[r].debugID = self->debugID;
@@ -951,6 +988,9 @@ ACTOR Future<Void> getResolution(CommitBatchContext* self) {
 	self->resolution.swap(*const_cast<std::vector<ResolveTransactionBatchReply>*>(&resolutionResp));
 
 	self->pProxyCommitData->stats.resolutionDist->sampleSeconds(g_network->timer_monotonic() - resolutionStart);
+	double resolutionLatency = g_network->timer_monotonic() - resolutionSent;
+	self->pProxyCommitData->stats.resolutionLatency.addMeasurement(resolutionLatency);
+	self->pProxyCommitData->stats.resolutionLatencyBands.addMeasurement(resolutionLatency);
 	if (self->debugID.present()) {
 		g_traceBatch.addEvent(
 		    "CommitDebug", self->debugID.get().first(), "CommitProxyServer.commitBatch.AfterResolution");
@@ -1302,15 +1342,211 @@ void rejectMutationsForReadLockOnRange(CommitBatchContext* self) {
 	}
 }
 
+bool isAssignedTransaction(CommitBatchContext* self, int transactionNum) {
+	return self->committed[transactionNum] == ConflictBatchStatus::TransactionCommitted &&
+	       (!self->locked || self->trs[transactionNum].isLockAware());
+}
+
+bool isAssignedMutation(const MutationRef& m) {
+	return isSingleKeyMutation((MutationRef::Type)m.type) || m.type == MutationRef::ClearRange;
+}
+
+// Resolves keys[begin, end) to the keyInfo ranges containing them. The keys are visited in sorted order, so runs of
+// keys in the same or nearby shards step the previous range forward instead of descending keyInfo again.
+void lookupSortedKeyRanges(KeyRangeMap<ServerCacheInfo>& keyInfo,
+                           const std::vector<StringRef>& keys,
+                           std::vector<KeyRangeMap<ServerCacheInfo>::iterator>& ranges,
+                           int begin,
+                           int end) {
+	// Beyond this many shards between two consecutive keys a new descent is cheaper than stepping
+	constexpr int maxSteps = 8;
+
+	std::vector<int> order(end - begin);
+	std::iota(order.begin(), order.end(), begin);
+	std::sort(order.begin(), order.end(), [&keys](int a, int b) { return keys[a] < keys[b]; });
+
+	const auto last = keyInfo.ranges().end();
+	auto range = last;
+	for (int i : order) {
+		const StringRef& key = keys[i];
+		// The previous key is not greater than this one, so only the end of its range needs checking
+		for (int step = 0; range != last && step < maxSteps && key >= range.end(); step++) {
+			++range;
+		}
+		if (range == last || key >= range.end()) {
+			range = keyInfo.rangeContaining(key);
+		}
+		ranges[i] = range;
+	}
+}
+
+// Keys whose keyInfo ranges are looked up before assignment. When the lookups run on tagLookupThreads the job is shared
+// with the threads so that it outlives a cancelled commit batch, and the keys are copied into keyBytes because the
+// batch's arenas cannot be shared across threads.
+struct TagLookupJob {
+	KeyRangeMap<ServerCacheInfo>* keyInfo = nullptr;
+	std::string keyBytes;
+	std::vector<StringRef> keys;
+	std::vector<KeyRangeMap<ServerCacheInfo>::iterator> ranges;
+	bool sorted = false;
+
+	void copyKeys() {
+		int bytes = 0;
+		for (const auto& key : keys) {
+			bytes += key.size();
+		}
+		keyBytes.reserve(bytes);
+		for (auto& key : keys) {
+			const uint8_t* copy = (const uint8_t*)keyBytes.data() + keyBytes.size();
+			keyBytes.append((const char*)key.begin(), key.size());
+			key = StringRef(copy, key.size());
+		}
+	}
+
+	void lookup(int begin, int end) {
+		if (sorted) {
+			lookupSortedKeyRanges(*keyInfo, keys, ranges, begin, end);
+			return;
+		}
+		for (int i = begin; i < end; i++) {
+			ranges[i] = keyInfo->rangeContaining(keys[i]);
+		}
+	}
+};
+
+struct TagLookupWorker : IThreadPoolReceiver {
+	void init() override {}
+
+	struct LookupAction : TypedAction<TagLookupWorker, LookupAction> {
+		std::shared_ptr<TagLookupJob> job;
+		int begin, end;
+		ThreadReturnPromise<Void> done;
+
+		LookupAction(std::shared_ptr<TagLookupJob> job, int begin, int end) : job(job), begin(begin), end(end) {}
+
+		double getTimeEstimate() const override { return 0; }
+	};
+
+	void action(LookupAction& a) {
+		a.job->lookup(a.begin, a.end);
+		a.done.send(Void());
+	}
+};
+
+// Copies the keys of job and splits its lookups into one chunk per thread, which are posted to threads. Without
+// threads, as in simulation, the chunks are looked up inline in the same way.
+Future<Void> lookupOnThreads(Reference<IThreadPool> threads, int threadCount, std::shared_ptr<TagLookupJob> job) {
+	job->copyKeys();
+	job->ranges.resize(job->keys.size());
+	std::vector<Future<Void>> lookups;
+	int chunk = std::max<int>((job->keys.size() + threadCount - 1) / threadCount, 1);
+	for (int begin = 0; begin < job->keys.size(); begin += chunk) {
+		int end = std::min<int>(begin + chunk, job->keys.size());
+		if (!threads) {
+			job->lookup(begin, end);
+			continue;
+		}
+		auto a = new TagLookupWorker::LookupAction(job, begin, end);
+		lookups.push_back(a->done.getFuture());
+		threads->post(a);
+	}
+	return waitForAll(lookups);
+}
+
+/// Looks up the keyInfo range of every mutation assignMutationsToStorageServers() is about to assign, in sorted key
+/// order and/or split across tagLookupThreads. keyInfo is only modified by the commit pipeline, which is held by this
+/// batch until it is logged, so the lookups can yield and the threads can read it while the network thread waits.
+ACTOR Future<Void> lookupMutationRanges(CommitBatchContext* self) {
+	state ProxyCommitData* const pProxyCommitData = self->pProxyCommitData;
+	state double lookupStart = g_network->timer_monotonic();
+	state std::shared_ptr<TagLookupJob> job = std::make_shared<TagLookupJob>();
+	state int chunkBegin = 0;
+
+	if (SERVER_KNOBS->PROXY_TAG_LOOKUP_THREADS <= 0 && !SERVER_KNOBS->PROXY_SORTED_TAG_LOOKUP) {
+		return Void();
+	}
+	job->keyInfo = &pProxyCommitData->keyInfo;
+	for (int t = self->transactionNum; t < self->trs.size(); t++) {
+		if (!isAssignedTransaction(self, t)) {
+			continue;
+		}
+		for (const auto& m : self->trs[t].transaction.mutations) {
+			if (isAssignedMutation(m)) {
+				job->keys.push_back(m.param1);
+			}
+		}
+	}
+	job->sorted = SERVER_KNOBS->PROXY_SORTED_TAG_LOOKUP &&
+	              job->keys.size() >= SERVER_KNOBS->PROXY_SORTED_TAG_LOOKUP_MIN_MUTATIONS;
+
+	if (SERVER_KNOBS->PROXY_TAG_LOOKUP_THREADS > 0 &&
+	    job->keys.size() >= SERVER_KNOBS->PROXY_PARALLEL_TAG_LOOKUP_MIN_MUTATIONS) {
+		self->computeDuration += g_network->timer_monotonic() - self->computeStart;
+		wait(lookupOnThreads(pProxyCommitData->tagLookupThreads, SERVER_KNOBS->PROXY_TAG_LOOKUP_THREADS, job));
+		self->computeStart = g_network->timer_monotonic();
+	} else if (job->sorted) {
+		// Large batches are looked up in chunks of about DESIRED_TOTAL_BYTES of keys, yielding between them as
+		// assignMutationsToStorageServers() does.
+		job->ranges.resize(job->keys.size());
+		while (chunkBegin < job->keys.size()) {
+			int chunkEnd = chunkBegin;
+			int bytes = 0;
+			while (chunkEnd < job->keys.size() && bytes <= SERVER_KNOBS->DESIRED_TOTAL_BYTES) {
+				bytes += job->keys[chunkEnd++].size();
+			}
+			job->lookup(chunkBegin, chunkEnd);
+			chunkBegin = chunkEnd;
+			if (chunkBegin < job->keys.size() && g_network->check_yield(TaskPriority::ProxyCommitYield1)) {
+				self->computeDuration += g_network->timer_monotonic() - self->computeStart;
+				wait(delay(0, TaskPriority::ProxyCommitYield1));
+				self->computeStart = g_network->timer_monotonic();
+			}
+		}
+	} else {
+		return Void();
+	}
+	self->mutationRanges = std::move(job->ranges);
+	self->mutationRangeIndex = 0;
+
+	double duration = g_network->timer_monotonic() - lookupStart;
+	pProxyCommitData->stats.tagLookupDist->sampleSeconds(duration);
+	pProxyCommitData->stats.tagLookupTime += duration;
+	return Void();
+}
+
+// Returns the keyInfo range containing key, caching the last one found in lastRange, since consecutive mutations of a
+// transaction often hit the same shard.
+KeyRangeMap<ServerCacheInfo>::iterator nextMutationRange(KeyRangeMap<ServerCacheInfo>& keyInfo,
+                                                         Optional<KeyRangeMap<ServerCacheInfo>::iterator>& lastRange,
+                                                         const StringRef& key) {
+	if (lastRange.present()) {
+		auto range = lastRange.get();
+		if (key >= range.begin() && key < range.end()) {
+			return range;
+		}
+	}
+	auto range = keyInfo.rangeContaining(key);
+	lastRange = range;
+	return range;
+}
+
+// Returns the keyInfo range containing the first key of m, which is the next mutation being assigned.
+KeyRangeMap<ServerCacheInfo>::iterator nextMutationRange(CommitBatchContext* self, const MutationRef& m) {
+	if (self->mutationRangeIndex < self->mutationRanges.size()) {
+		return self->mutationRanges[self->mutationRangeIndex++];
+	}
+	return nextMutationRange(self->pProxyCommitData->keyInfo, self->lastMutationRange, m.param1);
+}
+
 /// This second pass through committed transactions assigns the actual mutations to the appropriate storage servers'
 /// tags
 ACTOR Future<Void> assignMutationsToStorageServers(CommitBatchContext* self) {
 	state ProxyCommitData* const pProxyCommitData = self->pProxyCommitData;
 	state std::vector<CommitTransactionRequest>& trs = self->trs;
+	state double assignStart = g_network->timer_monotonic();
 
 	for (; self->transactionNum < trs.size(); self->transactionNum++) {
-		if (!(self->committed[self->transactionNum] == ConflictBatchStatus::TransactionCommitted &&
-		      (!self->locked || trs[self->transactionNum].isLockAware()))) {
+		if (!isAssignedTransaction(self, self->transactionNum)) {
 			continue;
 		}
 
@@ -1341,7 +1577,9 @@ ACTOR Future<Void> assignMutationsToStorageServers(CommitBatchContext* self) {
 			// Determine the set of tags (responsible storage servers) for the mutation, splitting it
 			// if necessary.  Serialize (splits of) the mutation into the message buffer and add the tags.
 			if (isSingleKeyMutation((MutationRef::Type)m.type)) {
-				auto& tags = pProxyCommitData->tagsForKey(m.param1);
+				auto keyRange = nextMutationRange(self, m);
+				keyRange.value().populateTags();
+				auto& tags = keyRange.value().tags;
 
 				// sample single key mutation based on cost
 				// the expectation of sampling is every COMMIT_SAMPLE_COST sample once
@@ -1353,7 +1591,7 @@ ACTOR Future<Void> assignMutationsToStorageServers(CommitBatchContext* self) {
 					double prob = mul * cost / totalCosts;
 
 					if (deterministicRandom()->random01() < prob) {
-						const auto& storageServers = pProxyCommitData->keyInfo[m.param1].src_info;
+						const auto& storageServers = keyRange.value().src_info;
 						for (const auto& ssInfo : storageServers) {
 							auto id = ssInfo->interf.id();
 							// scale cost
@@ -1383,7 +1621,7 @@ ACTOR Future<Void> assignMutationsToStorageServers(CommitBatchContext* self) {
 				ASSERT(std::holds_alternative<MutationRef>(var));
 				writtenMutation = std::get<MutationRef>(var);
 			} else if (m.type == MutationRef::ClearRange) {
-				auto range = pProxyCommitData->keyInfo.rangeContaining(m.param1);
+				auto range = nextMutationRange(self, m);
 				if (range.end() >= m.param2) {
 					// Fast path
 					DEBUG_MUTATION("ProxyCommit", self->commitVersion, m, pProxyCommitData->dbgid)
@@ -1490,7 +1728,11 @@ ACTOR Future<Void> assignMutationsToStorageServers(CommitBatchContext* self) {
 			    trs[self->transactionNum].commitCostEstimation.get().expensiveCostEstCount;
 		}
 	}
+	ASSERT(self->mutationRangeIndex == self->mutationRanges.size());
 
+	double duration = g_network->timer_monotonic() - assignStart;
+	pProxyCommitData->stats.assignMutationsDist->sampleSeconds(duration);
+	pProxyCommitData->stats.assignMutationsTime += duration;
 	return Void();
 }
 
@@ -1557,6 +1799,7 @@ ACTOR Future<Void> postResolution(CommitBatchContext* self) {
 	}
 
 	// Second pass
+	wait(lookupMutationRanges(self));
 	wait(assignMutationsToStorageServers(self));
 
 	if (debugID.present()) {
@@ -2792,7 +3035,9 @@ Future<Void> logDetailedMetrics(ProxyCommitData* commitData) {
 		    .detail("TxnCommitIn", txnCommitInReal - txnCommitInBaseline)
 		    .detail("Mutations", mutationsReal - mutationsBaseline)
 		    .detail("MutationBytes", mutationBytesReal - mutationBytesBaseline)
-		    .detail("UniqueClients", commitData->stats.getSizeAndResetUniqueClients());
+		    .detail("UniqueClients", commitData->stats.getSizeAndResetUniqueClients())
+		    .detail("TagLookupTime", commitData->stats.getAndResetTagLookupTime())
+		    .detail("AssignMutationsTime", commitData->stats.getAndResetAssignMutationsTime());
 	}
 }
 
@@ -2839,6 +3084,13 @@ ACTOR Future<Void> commitProxyServerCore(CommitProxyInterface proxy,
 	state Future<Void> dbInfoChange = commitData.db->onChange();
 	//TraceEvent("ProxyInit3", proxy.id());
 
+	if (SERVER_KNOBS->PROXY_TAG_LOOKUP_THREADS > 0 && !g_network->isSimulated()) {
+		commitData.tagLookupThreads = createGenericThreadPool();
+		for (int i = 0; i < SERVER_KNOBS->PROXY_TAG_LOOKUP_THREADS; i++) {
+			commitData.tagLookupThreads->addThread(new CommitBatch::TagLookupWorker(), "fdb-proxy-tags");
+		}
+	}
+
 	commitData.resolvers = commitData.db->get().resolvers;
 	commitData.localTLogCount = commitData.db->get().logSystemConfig.numLogs();
 	ASSERT(commitData.resolvers.size() != 0);
@@ -3061,4 +3313,148 @@ Future<Void> commitProxyServer(CommitProxyInterface proxy,
 	}
 }
 
+static Key tagLookupTestKey(int i) {
+	return Key(format("key/%010d", i));
+}
+
+// Measures keyInfo lookups per second for a batch of mutations, per key, with the last range cache, in sorted order and
+// split across threads, and checks they all agree. Transactions write runs of adjacent keys, as bulk loads do.
+TEST_CASE("performance/fdbserver/CommitProxy/TagLookup") {
+	state const int shards = params.getInt("shards").orDefault(10000);
+	state const int keysPerShard = params.getInt("keysPerShard").orDefault(1000);
+	state const int mutations = params.getInt("mutations").orDefault(200000);
+	state const int runLength = params.getInt("runLength").orDefault(100);
+	state const int threadCount = params.getInt("threads").orDefault(4);
+	state KeyRangeMap<ServerCacheInfo> keyInfo;
+	state Arena arena;
+	state std::vector<StringRef> keys;
+	state std::vector<KeyRangeMap<ServerCacheInfo>::iterator> expected(mutations);
+	state std::shared_ptr<CommitBatch::TagLookupJob> job = std::make_shared<CommitBatch::TagLookupJob>();
+	state Reference<IThreadPool> threads = createGenericThreadPool();
+	state double perKey = 0;
+	state double lastRange = 0;
+	state double sortedOrder = 0;
+	state double threaded = 0;
+	state double start = 0;
+	noUnseed = true;
+
+	for (int i = 0; i < shards; i++) {
+		ServerCacheInfo info;
+		info.tags.push_back(Tag(0, i));
+		keyInfo.insert(KeyRangeRef(tagLookupTestKey(i * keysPerShard), tagLookupTestKey((i + 1) * keysPerShard)), info);
+	}
+	while (keys.size() < mutations) {
+		int first = deterministicRandom()->randomInt(0, shards * keysPerShard - runLength);
+		for (int i = 0; i < runLength && keys.size() < mutations; i++) {
+			keys.push_back(StringRef(arena, tagLookupTestKey(first + i)));
+		}
+	}
+	for (int i = 0; i < threadCount; i++) {
+		threads->addThread(new CommitBatch::TagLookupWorker(), "fdb-proxy-tags");
+	}
+
+	{
+		using Iterator = KeyRangeMap<ServerCacheInfo>::iterator;
+		std::vector<Iterator> cached(keys.size()), sorted(keys.size());
+		start = timer_monotonic();
+		for (int i = 0; i < keys.size(); i++) {
+			expected[i] = keyInfo.rangeContaining(keys[i]);
+		}
+		perKey = timer_monotonic() - start;
+
+		start = timer_monotonic();
+		Optional<Iterator> last;
+		for (int i = 0; i < keys.size(); i++) {
+			cached[i] = CommitBatch::nextMutationRange(keyInfo, last, keys[i]);
+		}
+		lastRange = timer_monotonic() - start;
+
+		start = timer_monotonic();
+		CommitBatch::lookupSortedKeyRanges(keyInfo, keys, sorted, 0, keys.size());
+		sortedOrder = timer_monotonic() - start;
+
+		for (int i = 0; i < keys.size(); i++) {
+			ASSERT(cached[i] == expected[i]);
+			ASSERT(sorted[i] == expected[i]);
+			ASSERT(keys[i] >= expected[i].begin() && keys[i] < expected[i].end());
+		}
+	}
+
+	// Includes copying the keys, as lookupMutationRanges() does
+	job->keyInfo = &keyInfo;
+	job->keys = keys;
+	job->sorted = true;
+	start = timer_monotonic();
+	wait(CommitBatch::lookupOnThreads(threads, threadCount, job));
+	threaded = timer_monotonic() - start;
+	for (int i = 0; i < keys.size(); i++) {
+		ASSERT(job->ranges[i] == expected[i]);
+	}
+	wait(threads->stop());
+
+	printf("Tag lookup of %d mutations over %d shards, runs of %d keys:\n", mutations, shards, runLength);
+	printf("  per key:     %.0f mutations/sec\n", keys.size() / std::max(perKey, 1e-9));
+	printf("  last range:  %.0f mutations/sec\n", keys.size() / std::max(lastRange, 1e-9));
+	printf("  sorted:      %.0f mutations/sec\n", keys.size() / std::max(sortedOrder, 1e-9));
+	printf("  %d threads:  %.0f mutations/sec\n", threadCount, keys.size() / std::max(threaded, 1e-9));
+	return Void();
+}
+
+// Looks up random keys on real threads, sorted or not, and checks every range against keyInfo. The keys are copied
+// into the job, so the arena they came from can go away while the threads run.
+TEST_CASE("noSim/fdbserver/CommitProxy/ParallelTagLookup") {
+	state KeyRangeMap<ServerCacheInfo> keyInfo;
+	state Reference<IThreadPool> threads = createGenericThreadPool();
+	state int threadCount = deterministicRandom()->randomInt(1, 5);
+	state int keySpace = 1000000;
+	state int round = 0;
+	state std::shared_ptr<CommitBatch::TagLookupJob> job;
+	state Future<Void> lookups;
+	noUnseed = true;
+
+	{
+		std::vector<int> boundaries;
+		for (int i = deterministicRandom()->randomInt(1, 2000); i > 0; i--) {
+			boundaries.push_back(deterministicRandom()->randomInt(0, keySpace));
+		}
+		std::sort(boundaries.begin(), boundaries.end());
+		boundaries.erase(std::unique(boundaries.begin(), boundaries.end()), boundaries.end());
+		for (int i = 0; i + 1 < boundaries.size(); i++) {
+			ServerCacheInfo info;
+			info.tags.push_back(Tag(0, i));
+			keyInfo.insert(KeyRangeRef(tagLookupTestKey(boundaries[i]), tagLookupTestKey(boundaries[i + 1])), info);
+		}
+	}
+	for (int i = 0; i < threadCount; i++) {
+		threads->addThread(new CommitBatch::TagLookupWorker(), "fdb-proxy-tags");
+	}
+
+	for (round = 0; round < 20; round++) {
+		job = std::make_shared<CommitBatch::TagLookupJob>();
+		job->keyInfo = &keyInfo;
+		job->sorted = deterministicRandom()->coinflip();
+		{
+			Arena arena;
+			int count = deterministicRandom()->randomInt(0, 20000);
+			while (job->keys.size() < count) {
+				// Runs of adjacent keys, including repeats of the same key
+				int first = deterministicRandom()->randomInt(0, keySpace);
+				for (int i = deterministicRandom()->randomInt(1, 50); i > 0 && job->keys.size() < count; i--) {
+					int key = first + deterministicRandom()->randomInt(0, 20);
+					job->keys.push_back(StringRef(arena, tagLookupTestKey(key)));
+				}
+			}
+			lookups = CommitBatch::lookupOnThreads(threads, threadCount, job);
+		}
+		wait(lookups);
+		ASSERT(job->ranges.size() == job->keys.size());
+		for (int i = 0; i < job->keys.size(); i++) {
+			ASSERT(job->ranges[i] == keyInfo.rangeContaining(job->keys[i]));
+		}
+	}
+
+	wait(threads->stop());
+	return Void();
+}
+
 void forceLinkCommitProxyTests() {}
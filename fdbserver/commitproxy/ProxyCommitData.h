@@ -30,6 +30,7 @@
 #include "fdbserver/core/MasterInterface.h"
 #include "fdbserver/core/ResolverInterface.h"
 #include "flow/IRandom.h"
+#include "flow/IThreadPool.h"
 
 struct SingleKeyMutationDescriptor {
 	Standalone<StringRef> shardBegin;
@@ -75,6 +76,12 @@ struct ProxyStats {
 
 	LatencySample computeLatency;
 
+	// Resolver round trip of each batch, and how many earlier batches were still between resolution and logging when
+	// it was sent (see PROXY_RESOLUTION_PIPELINE_DEPTH).
+	LatencySample resolutionLatency;
+	LatencyBands resolutionLatencyBands;
+	LatencySample resolutionPipelineDepth;
+
 	Future<Void> logger;
 
 	int64_t maxComputeNS;
@@ -86,6 +93,8 @@ struct ProxyStats {
 	Reference<Histogram> resolutionDist;
 	Reference<Histogram> postResolutionDist;
 	Reference<Histogram> processingMutationDist;
+	Reference<Histogram> tagLookupDist;
+	Reference<Histogram> assignMutationsDist;
 	Reference<Histogram> tlogLoggingDist;
 	Reference<Histogram> replyCommitDist;
 
@@ -94,6 +103,10 @@ struct ProxyStats {
 	// use a `Counter` along with a `CounterCollection` here, and instead have
 	// to reimplement the basic functionality.
 	std::unordered_set<NetworkAddress> uniqueClients;
+	// Seconds spent looking up the key ranges of mutations, and assigning mutations to tags (including the lookups
+	// when they are not done beforehand).
+	double tagLookupTime = 0;
+	double assignMutationsTime = 0;
 
 	int64_t getAndResetMaxCompute() {
 		int64_t r = maxComputeNS;
@@ -113,6 +126,10 @@ struct ProxyStats {
 		return r;
 	}
 
+	double getAndResetTagLookupTime() { return std::exchange(tagLookupTime, 0); }
+
+	double getAndResetAssignMutationsTime() { return std::exchange(assignMutationsTime, 0); }
+
 	explicit ProxyStats(UID id,
 	                    NotifiedVersion* pVersion,
 	                    NotifiedVersion* pCommittedVersion,
@@ -144,6 +161,15 @@ struct ProxyStats {
 	                   id,
 	                   SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
 	                   SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+	    resolutionLatency("CommitResolutionLatencyMetrics",
+	                      id,
+	                      SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+	                      SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
+	    resolutionLatencyBands("CommitResolutionLatencyBands", id, SERVER_KNOBS->STORAGE_LOGGING_DELAY),
+	    resolutionPipelineDepth("ResolutionPipelineDepth",
+	                            id,
+	                            SERVER_KNOBS->LATENCY_METRICS_LOGGING_INTERVAL,
+	                            SERVER_KNOBS->LATENCY_SKETCH_ACCURACY),
 	    maxComputeNS(0), minComputeNS(1e12),
 	    commitBatchQueuingDist(
 	        Histogram::getHistogram("CommitProxy"_sr, "CommitBatchQueuing"_sr, Histogram::Unit::milliseconds)),
@@ -154,6 +180,9 @@ struct ProxyStats {
 	        Histogram::getHistogram("CommitProxy"_sr, "PostResolutionQueuing"_sr, Histogram::Unit::milliseconds)),
 	    processingMutationDist(
 	        Histogram::getHistogram("CommitProxy"_sr, "ProcessingMutation"_sr, Histogram::Unit::milliseconds)),
+	    tagLookupDist(Histogram::getHistogram("CommitProxy"_sr, "TagLookup"_sr, Histogram::Unit::milliseconds)),
+	    assignMutationsDist(
+	        Histogram::getHistogram("CommitProxy"_sr, "AssignMutations"_sr, Histogram::Unit::milliseconds)),
 	    tlogLoggingDist(Histogram::getHistogram("CommitProxy"_sr, "TlogLogging"_sr, Histogram::Unit::milliseconds)),
 	    replyCommitDist(Histogram::getHistogram("CommitProxy"_sr, "ReplyCommit"_sr, Histogram::Unit::milliseconds)) {
 		specialCounter(cc, "LastAssignedCommitVersion", [this]() { return this->lastCommitVersionAssigned; });
@@ -212,6 +241,8 @@ struct ProxyCommitData {
 	bool provisional;
 
 	int64_t localCommitBatchesStarted;
+	// With PROXY_RESOLUTION_PIPELINE_DEPTH, the latest local batch that has asked the master for a commit version
+	NotifiedVersion latestLocalCommitBatchVersioning;
 	NotifiedVersion latestLocalCommitBatchResolving;
 	NotifiedVersion latestLocalCommitBatchLogging;
 
@@ -254,6 +285,10 @@ struct ProxyCommitData {
 
 	std::shared_ptr<RangeLock> rangeLock = nullptr;
 
+	// Looks up keyInfo ranges for large commit batches, see lookupMutationRanges(). Declared after keyInfo so that
+	// its threads are joined before keyInfo is destroyed.
+	Reference<IThreadPool> tagLookupThreads;
+
 	// The tag related to a storage server rarely change, so we keep a vector of tags for each key range to be slightly
 	// more CPU efficient. When a tag related to a storage server does change, we empty out all of these vectors to
 	// signify they must be repopulated. We do not repopulate them immediately to avoid a slow task.
@@ -273,9 +308,11 @@ struct ProxyCommitData {
 		     newLatencyBandConfig.get().commitConfig != latencyBandConfig.get().commitConfig)) {
 			TraceEvent("LatencyBandCommitUpdatingConfig").detail("Present", newLatencyBandConfig.present());
 			stats.commitLatencyBands.clearBands();
+			stats.resolutionLatencyBands.clearBands();
 			if (newLatencyBandConfig.present()) {
 				for (auto band : newLatencyBandConfig.get().commitConfig.bands) {
 					stats.commitLatencyBands.addThreshold(band);
+					stats.resolutionLatencyBands.addThreshold(band);
 				}
 			}
 		}
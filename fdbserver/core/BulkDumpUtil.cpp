@@ -81,37 +81,75 @@ std::pair<BulkLoadFileSet, BulkLoadFileSet> getLocalRemoteFileSetSetting(Version
 	return std::make_pair(fileSetLocal, fileSetRemote);
 }
 
-// Generate SST file given the input sortedKVS to the input filePath.
-// TODO(BulkDump): This copy of sortedKVS can be a slow task if data is large.
-void writeKVSToSSTFile(std::string filePath, std::map<Key, Value>& sortedKVS, UID logId) {
+BulkDumpFileWriter::BulkDumpFileWriter(UID logId, const BulkLoadFileSet& localFileSet)
+  : logId(logId), localFileSet(localFileSet), keyCount(0), sampleCount(0), bytes(0), finished(false) {
+	// Clean up local folder
+	resetFileFolder((abspath(localFileSet.getFolder())));
+}
+
+BulkDumpFileWriter::~BulkDumpFileWriter() = default;
+
+std::unique_ptr<IRocksDBSstFileWriter> BulkDumpFileWriter::openFile(const std::string& filePath) {
 	const std::string absFilePath = abspath(filePath);
-	// Check file
 	if (fileExists(absFilePath)) {
 		TraceEvent(SevWarn, "SSBulkDumpRetriableError", logId)
-		    .detail("Reason", "exist old File when writeKVSToSSTFile")
+		    .detail("Reason", "exist old File when BulkDumpFileWriter opens file")
 		    .detail("DataFilePathLocal", absFilePath);
 		ASSERT_WE_THINK(false);
 		throw retry();
 	}
-	// Dump data to file
 	std::unique_ptr<IRocksDBSstFileWriter> sstWriter = newRocksDBSstFileWriter();
 	sstWriter->open(absFilePath);
-	for (const auto& [key, value] : sortedKVS) {
-		sstWriter->write(key, value); // assuming sorted
-	}
-	if (!sstWriter->finish()) {
+	return sstWriter;
+}
+
+void BulkDumpFileWriter::finishFile(IRocksDBSstFileWriter* writer, const std::string& filePath) {
+	if (!writer->finish()) {
 		// Unexpected: having data but failed to finish
 		TraceEvent(SevWarn, "SSBulkDumpRetriableError", logId)
-		    .detail("Reason", "failed to finish data sst writer when writeKVSToSSTFile")
-		    .detail("DataFilePath", absFilePath);
+		    .detail("Reason", "failed to finish sst writer when BulkDumpFileWriter finishes file")
+		    .detail("DataFilePath", abspath(filePath));
 		ASSERT_WE_THINK(false);
 		throw retry();
 	}
-	return;
+}
+
+void BulkDumpFileWriter::append(KeyValueRef kv) {
+	ASSERT(!finished);
+	if (dataWriter == nullptr) {
+		dataWriter = openFile(localFileSet.getDataFileFullPath());
+	}
+	dataWriter->write(kv.key, kv.value); // assuming sorted
+	keyCount++;
+	bytes += kv.expectedSize();
+
+	ByteSampleInfo sampleInfo = isKeyValueInSample(kv);
+	if (sampleInfo.inSample) {
+		if (sampleWriter == nullptr) {
+			sampleWriter = openFile(localFileSet.getBytesSampleFileFullPath());
+		}
+		sampleWriter->write(kv.key, BinaryWriter::toValue(sampleInfo.sampledSize, Unversioned()));
+		sampleCount++;
+	}
+}
+
+void BulkDumpFileWriter::finish() {
+	ASSERT(!finished);
+	finished = true;
+	if (dataWriter != nullptr) {
+		finishFile(dataWriter.get(), localFileSet.getDataFileFullPath());
+		dataWriter.reset();
+	} else {
+		ASSERT(sampleWriter == nullptr);
+	}
+	if (sampleWriter != nullptr) {
+		finishFile(sampleWriter.get(), localFileSet.getBytesSampleFileFullPath());
+		sampleWriter.reset();
+	}
 }
 
 Future<BulkLoadManifest> dumpDataFileToLocalDirectory(UID logId,
-                                                      std::shared_ptr<RangeDumpRawData> rangeDumpRawData,
+                                                      std::shared_ptr<BulkDumpFileWriter> fileWriter,
                                                       BulkLoadFileSet localFileSet,
                                                       BulkLoadFileSet remoteFileSet,
                                                       BulkLoadByteSampleSetting byteSampleSetting,
@@ -119,29 +157,13 @@ Future<BulkLoadManifest> dumpDataFileToLocalDirectory(UID logId,
                                                       KeyRange dumpRange,
                                                       BulkLoadType dumpType,
                                                       BulkLoadTransportMethod transportMethod) {
-	// Step 1: Clean up local folder
-	resetFileFolder((abspath(localFileSet.getFolder())));
-
-	// Step 2: Dump data to file
-	bool containDataFile = false;
-	if (rangeDumpRawData->kvs.size() > 0) {
-		writeKVSToSSTFile(abspath(localFileSet.getDataFileFullPath()), rangeDumpRawData->kvs, logId);
-		containDataFile = true;
-	} else {
-		ASSERT(rangeDumpRawData->sampled.empty());
-		containDataFile = false;
-	}
-
-	// Step 3: Dump sample to file
-	bool containByteSampleFile = false;
-	if (rangeDumpRawData->sampled.size() > 0) {
-		writeKVSToSSTFile(abspath(localFileSet.getBytesSampleFileFullPath()), rangeDumpRawData->sampled, logId);
-		containByteSampleFile = true;
-	} else {
-		containByteSampleFile = false;
-	}
+	// Step 1: Close the data file and the byte sampling file
+	// The data has been streamed to the files when reading the range
+	fileWriter->finish();
+	const bool containDataFile = fileWriter->hasDataFile();
+	const bool containByteSampleFile = fileWriter->hasByteSampleFile();
 
-	// Step 4: Generate manifest file
+	// Step 2: Generate manifest file
 	if (fileExists(abspath(localFileSet.getManifestFileFullPath()))) {
 		TraceEvent(SevWarn, "SSBulkDumpRetriableError", logId)
 		    .detail("Reason", "exist old manifestFile")
@@ -159,8 +181,8 @@ Future<BulkLoadManifest> dumpDataFileToLocalDirectory(UID logId,
 	                                  dumpRange.begin,
 	                                  dumpRange.end,
 	                                  dumpVersion,
-	                                  rangeDumpRawData->kvsBytes,
-	                                  rangeDumpRawData->kvs.size(),
+	                                  fileWriter->getBytes(),
+	                                  fileWriter->getKeyCount(),
 	                                  byteSampleSetting,
 	                                  dumpType,
 	                                  transportMethod);
@@ -18,10 +18,14 @@
  * limitations under the License.
  */
 
+#include <cinttypes>
+
+#include "fdbclient/BackupAgent.h"
 #include "fdbclient/BulkLoading.h"
 #include "fdbclient/FDBTypes.h"
 #include "fdbclient/NativeAPI.actor.h"
 #include "fdbclient/S3Client.h"
+#include "fdbserver/core/BulkDumpUtil.h"
 #include "fdbserver/core/BulkLoadUtil.h"
 #include "fdbserver/core/Knobs.h"
 #include "fdbserver/core/RocksDBCheckpointUtils.actor.h"
@@ -96,10 +100,44 @@ Future<Void> writeBulkFileBytes(std::string path, std::shared_ptr<std::string> c
 	}
 }
 
+// Copy the file block by block so that copying a large data file does not hold the whole file in memory.
 Future<Void> copyBulkFile(std::string fromFile, std::string toFile, size_t fileBytesMax) {
-	auto content = std::make_shared<std::string>();
-	co_await readBulkFileBytes(abspath(fromFile), fileBytesMax, /*output=*/content);
-	co_await writeBulkFileBytes(toFile, content);
+	try {
+		int64_t chunkSize = SERVER_KNOBS->BULKLOAD_ASYNC_READ_WRITE_BLOCK_SIZE;
+		Reference<IAsyncFile> source = co_await IAsyncFileSystem::filesystem()->open(
+		    abspath(fromFile), IAsyncFile::OPEN_NO_AIO | IAsyncFile::OPEN_READONLY | IAsyncFile::OPEN_UNCACHED, 0644);
+		int64_t fileSize = co_await source->size();
+		if (fileSize > (int64_t)fileBytesMax) {
+			TraceEvent(SevError, "CopyBulkFileTooLarge").detail("FileSize", fileSize).detail("MaxLength", fileBytesMax);
+			throw file_too_large();
+		}
+		Reference<IAsyncFile> destination = co_await IAsyncFileSystem::filesystem()->open(
+		    abspath(toFile),
+		    IAsyncFile::OPEN_ATOMIC_WRITE_AND_CREATE | IAsyncFile::OPEN_READWRITE | IAsyncFile::OPEN_CREATE,
+		    0644);
+
+		int64_t offset = 0;
+		auto chunk = std::make_shared<std::string>();
+		while (offset < fileSize) {
+			int64_t bytesToCopy = std::min(chunkSize, fileSize - offset);
+			chunk->resize(bytesToCopy);
+			int bytesRead = co_await uncancellable(holdWhile(chunk, source->read(chunk->data(), bytesToCopy, offset)));
+			if (bytesRead != bytesToCopy) {
+				TraceEvent(SevError, "CopyBulkFileReadError")
+				    .detail("BytesRead", bytesRead)
+				    .detail("BytesExpected", bytesToCopy);
+				throw io_error();
+			}
+			co_await uncancellable(holdWhile(chunk, destination->write(chunk->data(), bytesToCopy, offset)));
+			offset += bytesToCopy;
+		}
+
+		co_await destination->truncate(fileSize);
+		co_await destination->sync();
+	} catch (Error& e) {
+		TraceEvent(SevWarn, "CopyBulkFileError").error(e).detail("From", fromFile).detail("To", toFile);
+		throw e;
+	}
 }
 
 Future<BulkLoadTaskState> getBulkLoadTaskStateFromDataMove(Database cx,
@@ -435,6 +473,119 @@ Future<Void> bulkLoadDownloadTaskFileSets(BulkLoadTransportMethod transportMetho
 	}
 }
 
+Future<BulkLoadFileSet> bulkLoadConvertRangeFileToSST(BulkLoadFileSet rangeFileSet, KeyRange range, UID logId) {
+	ASSERT(rangeFileSet.hasDataFile());
+	double startTime = now();
+	const std::string rangeFileName = rangeFileSet.getDataFileName();
+	const std::string dataFileName = rangeFileName + ".sst";
+	BulkLoadFileSet sstFileSet(rangeFileSet.getRootPath(),
+	                           rangeFileSet.getRelativePath().empty() ? "sst"
+	                                                                  : joinPath(rangeFileSet.getRelativePath(), "sst"),
+	                           rangeFileSet.getManifestFileName(),
+	                           dataFileName,
+	                           generateBulkLoadBytesSampleFileNameFromDataFileName(dataFileName),
+	                           BulkLoadChecksum());
+	int64_t blockCount = 0;
+	int64_t keyCount = 0;
+	Error err;
+	try {
+		// Range files are named range,<version>,<uid>,<blockSize>, see BackupContainerFileSystem::writeRangeFile
+		Version fileVersion;
+		unsigned int blockSize = 0;
+		int len = 0;
+		if (sscanf(rangeFileName.c_str(), "range,%" SCNd64 ",%*[^,],%u%n", &fileVersion, &blockSize, &len) != 2 ||
+		    len != (int)rangeFileName.size() || blockSize == 0) {
+			throw restore_unknown_file_type();
+		}
+		Reference<IAsyncFile> file =
+		    co_await IAsyncFileSystem::filesystem()->open(abspath(rangeFileSet.getDataFileFullPath()),
+		                                                  IAsyncFile::OPEN_NO_AIO | IAsyncFile::OPEN_READONLY |
+		                                                      IAsyncFile::OPEN_UNCACHED,
+		                                                  0644);
+		int64_t fileSize = co_await file->size();
+		BulkDumpFileWriter writer(logId, sstFileSet);
+		bool pastEnd = false;
+		for (int64_t offset = 0; offset < fileSize && !pastEnd; offset += blockSize) {
+			int readLen = std::min<int64_t>(blockSize, fileSize - offset);
+			Standalone<StringRef> buf = makeString(readLen);
+			int bytesRead = co_await file->read(mutateString(buf), readLen, offset);
+			if (bytesRead != readLen) {
+				throw restore_bad_read();
+			}
+			Standalone<VectorRef<KeyValueRef>> block = fileBackup::decodeRangeFileBlock(buf);
+			// The first and the last keys of a block are the boundaries of the block rather than data
+			for (int i = 1; i + 1 < block.size(); i++) {
+				if (block[i].key >= range.end) {
+					pastEnd = true;
+					break;
+				}
+				if (block[i].key >= range.begin) {
+					writer.append(block[i]);
+				}
+			}
+			blockCount++;
+			co_await yield();
+		}
+		writer.finish();
+		keyCount = writer.getKeyCount();
+		if (!writer.hasByteSampleFile()) {
+			sstFileSet.removeByteSampleFile();
+		}
+		if (!writer.hasDataFile()) {
+			sstFileSet.removeDataFile();
+		}
+	} catch (Error& e) {
+		err = e;
+	}
+	if (err.isValid()) {
+		if (err.code() == error_code_actor_cancelled) {
+			throw err;
+		}
+		TraceEvent(SevWarnAlways, "SSBulkLoadTaskConvertRangeFileError", logId)
+		    .errorUnsuppressed(err)
+		    .detail("RangeFileSet", rangeFileSet.toString())
+		    .detail("Range", range)
+		    .detail("Duration", now() - startTime);
+		// Retried by the data move which loads the task
+		throw bulkload_task_failed();
+	}
+	TraceEvent(bulkLoadVerboseEventSev(), "SSBulkLoadTaskConvertRangeFile", logId)
+	    .detail("RangeFileSet", rangeFileSet.toString())
+	    .detail("SSTFileSet", sstFileSet.toString())
+	    .detail("Range", range)
+	    .detail("BlockCount", blockCount)
+	    .detail("KeyCount", keyCount)
+	    .detail("Duration", now() - startTime);
+	co_return sstFileSet;
+}
+
+Future<Void> bulkLoadDownloadRangeFileSets(BulkLoadTransportMethod transportMethod,
+                                           std::shared_ptr<BulkLoadFileSetKeyMap> fromRemoteFileSets,
+                                           std::shared_ptr<BulkLoadFileSetKeyMap> localFileSets,
+                                           std::string toLocalRoot,
+                                           UID logId) {
+	int index = 0;
+	for (auto iter = fromRemoteFileSets->begin(); iter != fromRemoteFileSets->end(); iter++, index++) {
+		KeyRange keys = iter->first;
+		std::string localRoot = joinPath(toLocalRoot, std::to_string(index));
+		if (!iter->second.hasDataFile()) {
+			// Empty range marker, see bulkLoadDownloadTaskFileSets
+			localFileSets->push_back(std::make_pair(keys,
+			                                        BulkLoadFileSet(localRoot,
+			                                                        iter->second.getRelativePath(),
+			                                                        iter->second.getManifestFileName(),
+			                                                        "",
+			                                                        "",
+			                                                        BulkLoadChecksum())));
+			continue;
+		}
+		BulkLoadFileSet rangeFileSet =
+		    co_await bulkLoadDownloadTaskFileSet(transportMethod, iter->second, localRoot, logId);
+		BulkLoadFileSet sstFileSet = co_await bulkLoadConvertRangeFileToSST(rangeFileSet, keys, logId);
+		localFileSets->push_back(std::make_pair(keys, sstFileSet));
+	}
+}
+
 Future<Void> downloadManifestFile(BulkLoadTransportMethod transportMethod,
                                   std::string fromRemotePath,
                                   std::string toLocalPath,
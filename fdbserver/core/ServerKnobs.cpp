@@ -236,6 +236,8 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( PEEK_BATCHING_EMPTY_MSG_INTERVAL,                    0.005 ); if ( randomize && BUGGIFY ) PEEK_BATCHING_EMPTY_MSG_INTERVAL = 0.01;
 	init( POP_FROM_LOG_DELAY,                                      1 ); if ( randomize && BUGGIFY ) POP_FROM_LOG_DELAY = 0;
 	init( TLOG_PULL_ASYNC_DATA_WARNING_TIMEOUT_SECS,             120 );
+	init( TLOG_PUSH_COMPRESSION,                               false ); if ( randomize && BUGGIFY ) TLOG_PUSH_COMPRESSION = true;
+	init( TLOG_PUSH_COMPRESSION_MIN_BYTES,                      4096 ); if ( randomize && BUGGIFY ) TLOG_PUSH_COMPRESSION_MIN_BYTES = deterministicRandom()->randomInt(0, 1000);
 
 	// disk snapshot max timeout, to be put in TLog, storage and coordinator nodes
 	init( MAX_FORKED_PROCESS_OUTPUT,                            1024 );
@@ -774,12 +776,14 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( SHARDED_ROCKSDB_MAX_OPEN_FILES,                      50000 ); // Should be smaller than OS's fd limit.
 	init( SHARDED_ROCKSDB_COMPACTION_PRI,                          3 ); // kMinOverlappingRatio, RocksDB default.
 	init (SHARDED_ROCKSDB_READ_ASYNC_IO,                       false ); if (isSimulated) SHARDED_ROCKSDB_READ_ASYNC_IO = deterministicRandom()->coinflip();
+	init( SHARDED_ROCKSDB_READ_VALUE_BATCH_SIZE,                   1 ); if( randomize && BUGGIFY )  SHARDED_ROCKSDB_READ_VALUE_BATCH_SIZE = deterministicRandom()->randomInt(1, 64);
 	init( SHARDED_ROCKSDB_PREFIX_LEN,                             11 ); if( randomize && BUGGIFY )  SHARDED_ROCKSDB_PREFIX_LEN = deterministicRandom()->randomInt(1, 20);
 	init( SHARDED_ROCKSDB_BLOOM_FILTER_BITS,                       3 ); if( randomize && BUGGIFY )  SHARDED_ROCKSDB_BLOOM_FILTER_BITS = deterministicRandom()->randomInt(3, 10);
 	init (SHARDED_ROCKSDB_MEMTABLE_BLOOM_FILTER_RATIO,           0.1 );
 	init( SHARDED_ROCKSDB_USE_DIRECT_IO,                       false ); if (isSimulated) SHARDED_ROCKSDB_USE_DIRECT_IO = deterministicRandom()->coinflip();
 	init( ENFORCE_SHARDED_ROCKSDB_SIM_IF_AVALIABLE,            false ); // Turn off by default.
 	init( SHARDED_ROCKSDB_HISTOGRAMS_SAMPLE_RATE,              0.001 ); if( isSimulated ) SHARDED_ROCKSDB_HISTOGRAMS_SAMPLE_RATE = deterministicRandom()->random01();
+	init( SHARDED_ROCKSDB_COMMIT_WORKERS,                          0 ); if( randomize && BUGGIFY )  SHARDED_ROCKSDB_COMMIT_WORKERS = deterministicRandom()->randomInt(2, 5); // In simulation the writer runs the worker groups itself
 
 
 	// Leader election
@@ -849,9 +853,14 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( TXN_STATE_SEND_AMOUNT,                                    4 );
 	init( REPORT_TRANSACTION_COST_ESTIMATION_DELAY,               0.1 );
 	init( PROXY_REJECT_BATCH_QUEUED_TOO_LONG,                    true );
+	init( PROXY_RESOLUTION_PIPELINE_DEPTH,                          0 ); if( randomize && BUGGIFY ) PROXY_RESOLUTION_PIPELINE_DEPTH = deterministicRandom()->randomInt(1, 6);
 
 	bool buggfyUseResolverPrivateMutations = randomize && BUGGIFY && !ENABLE_VERSION_VECTOR_TLOG_UNICAST;
 	init( PROXY_USE_RESOLVER_PRIVATE_MUTATIONS,                 false ); if( buggfyUseResolverPrivateMutations ) PROXY_USE_RESOLVER_PRIVATE_MUTATIONS = deterministicRandom()->coinflip();
+	init( PROXY_TAG_LOOKUP_THREADS,                                 0 ); if( randomize && BUGGIFY ) PROXY_TAG_LOOKUP_THREADS = deterministicRandom()->randomInt(1, 4);
+	init( PROXY_PARALLEL_TAG_LOOKUP_MIN_MUTATIONS,               5000 ); if( randomize && BUGGIFY ) PROXY_PARALLEL_TAG_LOOKUP_MIN_MUTATIONS = deterministicRandom()->randomInt(0, 100);
+	init( PROXY_SORTED_TAG_LOOKUP,                              false ); if( randomize && BUGGIFY ) PROXY_SORTED_TAG_LOOKUP = deterministicRandom()->coinflip();
+	init( PROXY_SORTED_TAG_LOOKUP_MIN_MUTATIONS,                  100 ); if( randomize && BUGGIFY ) PROXY_SORTED_TAG_LOOKUP_MIN_MUTATIONS = deterministicRandom()->randomInt(0, 10);
 
 	init( BURSTINESS_METRICS_ENABLED  ,                         false );
 	init( BURSTINESS_METRICS_LOG_INTERVAL,                        0.1 );
@@ -882,6 +891,8 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( PROVISIONAL_DELAY_GROWTH,                              1.5 );
 	init( SECONDS_BEFORE_RECRUIT_BACKUP_WORKER,                  4.0 ); if( randomize && BUGGIFY ) SECONDS_BEFORE_RECRUIT_BACKUP_WORKER = deterministicRandom()->random01() * 8;
 	init( CC_INTERFACE_TIMEOUT,                                 10.0 ); if( randomize && BUGGIFY ) CC_INTERFACE_TIMEOUT = 0.0;
+	init( MASTER_BATCH_VERSION_REQUESTS,                        true ); if( randomize && BUGGIFY ) MASTER_BATCH_VERSION_REQUESTS = false;
+	init( CLUSTER_RECOVERY_OVERLAP_PHASES,                      true ); if( randomize && BUGGIFY ) CLUSTER_RECOVERY_OVERLAP_PHASES = false;
 
 	// Resolver
 	init( SAMPLE_OFFSET_PER_KEY,                                 100 );
@@ -895,6 +906,9 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( BACKUP_FILE_BLOCK_BYTES,                       1024 * 1024 );
 	init( BACKUP_WORKER_LOCK_BYTES,                              3e9 ); if(randomize && BUGGIFY) BACKUP_WORKER_LOCK_BYTES = deterministicRandom()->randomInt(2048, 4096) * 4096;
 	init( BACKUP_UPLOAD_DELAY,                                  10.0 ); if(randomize && BUGGIFY) BACKUP_UPLOAD_DELAY = deterministicRandom()->random01() * 60;
+	init( BACKUP_WORKER_LOG_COMPRESSION,                       false ); if(randomize && BUGGIFY) BACKUP_WORKER_LOG_COMPRESSION = true;
+	init( BACKUP_WORKER_TARGET_FILE_BYTES,                         0 ); if(randomize && BUGGIFY) BACKUP_WORKER_TARGET_FILE_BYTES = deterministicRandom()->randomInt(0, 4) * BACKUP_FILE_BLOCK_BYTES;
+	init( BACKUP_WORKER_MAX_FILE_DELAY,                         30.0 ); if(randomize && BUGGIFY) BACKUP_WORKER_MAX_FILE_DELAY = deterministicRandom()->random01() * 60;
 
 	//Cluster Controller
 	init( CLUSTER_CONTROLLER_LOGGING_DELAY,                      5.0 );
@@ -1142,6 +1156,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( FUTURE_VERSION_DELAY,                                  1.0 );
 	init( STORAGE_LIMIT_BYTES,                                500000 );
 	init( BUGGIFY_LIMIT_BYTES,                                  1000 );
+	init( STORAGE_SERVER_BTREE_VERSIONED_MAP,                  false ); if( randomize && BUGGIFY ) STORAGE_SERVER_BTREE_VERSIONED_MAP = true;
 	init( FETCH_USING_STREAMING,                               false ); if( randomize && isSimulated && BUGGIFY ) FETCH_USING_STREAMING = true; //Determines if fetch keys uses streaming reads
 	init( FETCH_USING_BLOB,                                    false );
 	init( FETCH_BLOCK_BYTES,                                     2e6 );
@@ -1173,6 +1188,12 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( STORAGE_DURABILITY_LAG_REJECT_THRESHOLD,              0.25 );
 	init( STORAGE_DURABILITY_LAG_MIN_RATE,                       0.1 );
 	init( STORAGE_COMMIT_INTERVAL,                               0.5 ); if( randomize && BUGGIFY ) STORAGE_COMMIT_INTERVAL = 2.0;
+	init( STORAGE_ADAPTIVE_COMMIT_BATCHING,                    false ); if( randomize && BUGGIFY ) STORAGE_ADAPTIVE_COMMIT_BATCHING = deterministicRandom()->coinflip();
+	init( STORAGE_ADAPTIVE_COMMIT_TARGET_LAG,                    2.0 ); if( randomize && BUGGIFY ) STORAGE_ADAPTIVE_COMMIT_TARGET_LAG = deterministicRandom()->random01() * 5.0;
+	init( STORAGE_ADAPTIVE_COMMIT_MIN_BYTES,                 1000000 ); if( randomize && BUGGIFY ) STORAGE_ADAPTIVE_COMMIT_MIN_BYTES = 10000;
+	init( STORAGE_ADAPTIVE_COMMIT_MAX_BYTES,               100000000 ); if( randomize && BUGGIFY ) STORAGE_ADAPTIVE_COMMIT_MAX_BYTES = 2000000;
+	init( STORAGE_ADAPTIVE_COMMIT_MAX_INTERVAL,                  1.0 );
+	init( STORAGE_ADAPTIVE_COMMIT_SMOOTHING,                     0.2 );
 
 	// Constants which affect the fraction of data which is sampled
 	// by storage severs to estimate key-range sizes and splits.
@@ -1211,6 +1232,8 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( FETCH_KEYS_TOO_LONG_TIME_CRITERIA,                   300.0 );
 	init( MAX_STORAGE_COMMIT_TIME,                             200.0 ); //The max fsync stall time on the storage server and tlog before marking a disk as failed
 	init( RANGESTREAM_LIMIT_BYTES,                               2e6 ); if( randomize && BUGGIFY ) RANGESTREAM_LIMIT_BYTES = 1;
+	init( RANGESTREAM_EXPORT_READ_BYTES,                         4e6 ); if( randomize && BUGGIFY ) RANGESTREAM_EXPORT_READ_BYTES = deterministicRandom()->randomInt(1, 1e5);
+	init( RANGESTREAM_EXPORT_MAX_WINDOW_BYTES,                  64e6 ); if( randomize && BUGGIFY ) RANGESTREAM_EXPORT_MAX_WINDOW_BYTES = 1;
 	init( BLOBWORKERSTATUSSTREAM_LIMIT_BYTES,                    1e4 ); if( randomize && BUGGIFY ) BLOBWORKERSTATUSSTREAM_LIMIT_BYTES = 1;
 	init( ENABLE_CLEAR_RANGE_EAGER_READS,                       true ); if( randomize && BUGGIFY ) ENABLE_CLEAR_RANGE_EAGER_READS = deterministicRandom()->coinflip();
 	init( CHECKPOINT_TRANSFER_BLOCK_BYTES,                      40e6 );
@@ -1235,6 +1258,7 @@ void ServerKnobs::initialize(Randomize randomize, ClientKnobs* clientKnobs, IsSi
 	init( FETCH_SHARD_UPDATES_BYTE_LIMIT,                    2500000 ); if( randomize && BUGGIFY ) FETCH_SHARD_UPDATES_BYTE_LIMIT = 100;
 	init( TRACK_READ_LATENCIES_PER_TYPE,                       false ); if( randomize && BUGGIFY ) TRACK_READ_LATENCIES_PER_TYPE = true;
 	init( STORAGE_UPDATE_PROCESS_STATS_INTERVAL,                   5 ); if( randomize && BUGGIFY ) STORAGE_UPDATE_PROCESS_STATS_INTERVAL = deterministicRandom()->random01() * 60 + 1;
+	init( STORAGE_EAGER_READS_SKIP_IN_MEMORY_KEYS,             false ); if( randomize && BUGGIFY ) STORAGE_EAGER_READS_SKIP_IN_MEMORY_KEYS = deterministicRandom()->coinflip();
 
 	//Wait Failure
 	init( MAX_OUTSTANDING_WAIT_FAILURE_REQUESTS,                 250 ); if( randomize && BUGGIFY ) MAX_OUTSTANDING_WAIT_FAILURE_REQUESTS = 2;
@@ -25,18 +25,40 @@
 #include "fdbclient/BulkDumping.h"
 #include "fdbclient/StorageServerInterface.h"
 
-struct RangeDumpRawData {
-	Arena arena;
-	std::map<Key, Value> kvs;
-	std::map<Key, Value> sampled;
-	Key lastKey;
-	int64_t kvsBytes;
-	RangeDumpRawData() = default;
-	RangeDumpRawData(const std::map<Key, Value>& kvs,
-	                 const std::map<Key, Value>& sampled,
-	                 const Key& lastKey,
-	                 int64_t kvsBytes)
-	  : kvs(kvs), sampled(sampled), lastKey(lastKey), kvsBytes(kvsBytes) {}
+class IRocksDBSstFileWriter;
+
+// Streams the key-values of one bulk dump batch into the local data file and byte sample file as they are read, so the
+// memory used by a batch does not depend on its size. Key-values must be appended in increasing key order, which is
+// the order in which the storage server reads them. The data file is created on the first append and the byte sample
+// file on the first sampled key, so an empty batch produces neither file.
+class BulkDumpFileWriter {
+public:
+	BulkDumpFileWriter(UID logId, const BulkLoadFileSet& localFileSet);
+	~BulkDumpFileWriter();
+
+	// Write the key-value to the data file, and its sampled size to the byte sample file if the key is sampled
+	void append(KeyValueRef kv);
+
+	// Close the files. No append is allowed afterwards.
+	void finish();
+
+	bool hasDataFile() const { return keyCount > 0; }
+	bool hasByteSampleFile() const { return sampleCount > 0; }
+	int64_t getKeyCount() const { return keyCount; }
+	int64_t getBytes() const { return bytes; }
+
+private:
+	std::unique_ptr<IRocksDBSstFileWriter> openFile(const std::string& filePath);
+	void finishFile(IRocksDBSstFileWriter* writer, const std::string& filePath);
+
+	UID logId;
+	BulkLoadFileSet localFileSet;
+	std::unique_ptr<IRocksDBSstFileWriter> dataWriter;
+	std::unique_ptr<IRocksDBSstFileWriter> sampleWriter;
+	int64_t keyCount;
+	int64_t sampleCount;
+	int64_t bytes;
+	bool finished;
 };
 
 struct SSBulkDumpTask {
@@ -86,13 +108,12 @@ std::string generateBulkDumpJobFolder(const UID& jobId);
 // Define task folder name.
 std::string getBulkDumpJobTaskFolder(const UID& jobId, const UID& taskId);
 
-// Generate key-value data, byte sampling data, and manifest file.
+// Close the data file and byte sampling file of the batch streamed by fileWriter, and generate the manifest file.
 // Return BulkLoadManifest metadata (equivalent to content of the manifest file).
-// TODO(BulkDump): can cause slow tasks, do the task in a separate thread in the future.
-// The size of sortedData is defined at the place of generating the data (getRangeDataToDump).
-// The size is configured by MOVE_SHARD_KRM_ROW_LIMIT.
+// The batch size is defined at the place of generating the data (getRangeDataToDump).
+// The size is configured by SS_BULKDUMP_BATCH_BYTES.
 Future<BulkLoadManifest> dumpDataFileToLocalDirectory(UID logId,
-                                                      std::shared_ptr<RangeDumpRawData> rangeDumpRawData,
+                                                      std::shared_ptr<BulkDumpFileWriter> fileWriter,
                                                       BulkLoadFileSet localFileSet,
                                                       BulkLoadFileSet remoteFileSet,
                                                       BulkLoadByteSampleSetting byteSampleSetting,
@@ -56,6 +56,19 @@ Future<Void> bulkLoadDownloadTaskFileSets(BulkLoadTransportMethod transportMetho
                                           std::string toLocalRoot,
                                           UID logId);
 
+// Decode the backup range file downloaded to rangeFileSet and rewrite its key-values within range as an SST data file
+// and a byte sample file in the sst sub-folder of the range file folder. Return the file set of the SST files, which has
+// no data file if the range file has no key-value within range.
+Future<BulkLoadFileSet> bulkLoadConvertRangeFileToSST(BulkLoadFileSet rangeFileSet, KeyRange range, UID logId);
+
+// Download the backup range files of a RangeFile bulkload task and convert them to SST files.
+// Range files of a backup snapshot share a remote folder, so each one is downloaded to its own folder under toLocalRoot.
+Future<Void> bulkLoadDownloadRangeFileSets(BulkLoadTransportMethod transportMethod,
+                                           std::shared_ptr<BulkLoadFileSetKeyMap> fromRemoteFileSets,
+                                           std::shared_ptr<BulkLoadFileSetKeyMap> localFileSets,
+                                           std::string toLocalRoot,
+                                           UID logId);
+
 Future<bool> doBytesSamplingOnDataFile(std::string dataFileFullPath, std::string byteSampleFileFullPath, UID logId);
 
 // Download job manifest file which is generated when dumping the data
@@ -130,6 +130,8 @@ public:
 	double PEEK_BATCHING_EMPTY_MSG_INTERVAL;
 	double POP_FROM_LOG_DELAY;
 	double TLOG_PULL_ASYNC_DATA_WARNING_TIMEOUT_SECS;
+	bool TLOG_PUSH_COMPRESSION; // If true, commit proxies compress the messages pushed to each TLog
+	int TLOG_PUSH_COMPRESSION_MIN_BYTES; // Push payloads smaller than this are sent uncompressed
 
 	// Data distribution queue
 	double HEALTH_POLL_TIME;
@@ -650,10 +652,14 @@ public:
 	int SHARDED_ROCKSDB_MAX_OPEN_FILES;
 	int SHARDED_ROCKSDB_COMPACTION_PRI;
 	bool SHARDED_ROCKSDB_READ_ASYNC_IO;
+	int SHARDED_ROCKSDB_READ_VALUE_BATCH_SIZE; // Max point reads served by one MultiGet, 1 disables batching
 	int SHARDED_ROCKSDB_PREFIX_LEN;
 	int SHARDED_ROCKSDB_BLOOM_FILTER_BITS;
 	double SHARDED_ROCKSDB_MEMTABLE_BLOOM_FILTER_RATIO;
 	double SHARDED_ROCKSDB_HISTOGRAMS_SAMPLE_RATE;
+	// Number of threads sharing the per-shard work that follows each commit (iterator refresh, compaction suggestions
+	// and range deletion flushes). 0 or 1 runs it on the writer thread.
+	int SHARDED_ROCKSDB_COMMIT_WORKERS;
 	bool SHARDED_ROCKSDB_USE_DIRECT_IO;
 	bool ENFORCE_SHARDED_ROCKSDB_SIM_IF_AVALIABLE; // set to enforce shardedrocks in simulation as much as possible
 
@@ -719,7 +725,20 @@ public:
 	int TXN_STATE_SEND_AMOUNT;
 	double REPORT_TRANSACTION_COST_ESTIMATION_DELAY;
 	bool PROXY_REJECT_BATCH_QUEUED_TOO_LONG;
+	// If positive, a commit proxy asks for the next batch's commit version without waiting for the previous batch to
+	// be sent to the resolvers, and lets up to this many batches be between resolution and logging. 0 paces batches by
+	// their estimated compute time instead.
+	int PROXY_RESOLUTION_PIPELINE_DEPTH;
 	bool PROXY_USE_RESOLVER_PRIVATE_MUTATIONS;
+	// Threads looking up the key ranges of committed mutations before they are assigned to storage server tags, 0
+	// does the lookups while assigning. Batches with fewer mutations than the minimum are looked up on the network
+	// thread. Simulation splits the lookups the same way but runs them inline.
+	int PROXY_TAG_LOOKUP_THREADS;
+	int PROXY_PARALLEL_TAG_LOOKUP_MIN_MUTATIONS;
+	// Look up the key ranges of a batch's mutations in sorted key order, for batches with at least the minimum number
+	// of mutations.
+	bool PROXY_SORTED_TAG_LOOKUP;
+	int PROXY_SORTED_TAG_LOOKUP_MIN_MUTATIONS;
 	bool BURSTINESS_METRICS_ENABLED;
 	// Interval on which to emit burstiness metrics on the commit proxy (in
 	// seconds).
@@ -747,6 +766,12 @@ public:
 	double PROVISIONAL_MAX_DELAY;
 	double SECONDS_BEFORE_RECRUIT_BACKUP_WORKER;
 	double CC_INTERFACE_TIMEOUT;
+	// Answer all of the commit version and live committed version requests that arrive in one run loop tick together,
+	// instead of one at a time
+	bool MASTER_BATCH_VERSION_REQUESTS;
+	// Overlap the independent steps of cluster recovery: initialize the stateless roles while the seed storage servers
+	// of a new database are recruited, and initialize the resolvers while the txnStateStore is sent to the proxies
+	bool CLUSTER_RECOVERY_OVERLAP_PHASES;
 
 	// Resolver
 	int64_t KEY_BYTES_PER_SAMPLE;
@@ -760,6 +785,9 @@ public:
 	int BACKUP_FILE_BLOCK_BYTES;
 	int64_t BACKUP_WORKER_LOCK_BYTES;
 	double BACKUP_UPLOAD_DELAY;
+	bool BACKUP_WORKER_LOG_COMPRESSION; // Write compressed mutation log blocks, which older restores can't read
+	int64_t BACKUP_WORKER_TARGET_FILE_BYTES; // Buffered bytes to wait for before saving mutations, 0 disables
+	double BACKUP_WORKER_MAX_FILE_DELAY; // Longest time mutations are buffered while waiting for a larger file
 
 	// Cluster Controller
 	double CLUSTER_CONTROLLER_LOGGING_DELAY;
@@ -1100,6 +1128,8 @@ public:
 	double FUTURE_VERSION_DELAY;
 	int STORAGE_LIMIT_BYTES;
 	int BUGGIFY_LIMIT_BYTES;
+	bool STORAGE_SERVER_BTREE_VERSIONED_MAP; // Keep the MVCC window of the storage server in a BTreeVersionedMap
+	                                         // instead of the PTree based VersionedMap
 	bool FETCH_USING_STREAMING;
 	bool FETCH_USING_BLOB;
 	int FETCH_BLOCK_BYTES;
@@ -1130,6 +1160,14 @@ public:
 	int STORAGE_FETCH_BYTES;
 	int STORAGE_ROCKSDB_FETCH_BYTES;
 	double STORAGE_COMMIT_INTERVAL;
+	// When enabled, updateStorage sizes each durability batch and the delay between commits from recent engine commit
+	// throughput instead of STORAGE_COMMIT_BYTES and STORAGE_COMMIT_INTERVAL.
+	bool STORAGE_ADAPTIVE_COMMIT_BATCHING;
+	double STORAGE_ADAPTIVE_COMMIT_TARGET_LAG; // Seconds of versions beyond the MVCC window allowed to be non-durable
+	int64_t STORAGE_ADAPTIVE_COMMIT_MIN_BYTES;
+	int64_t STORAGE_ADAPTIVE_COMMIT_MAX_BYTES;
+	double STORAGE_ADAPTIVE_COMMIT_MAX_INTERVAL;
+	double STORAGE_ADAPTIVE_COMMIT_SMOOTHING; // Weight of the latest commit in the smoothed commit throughput
 	int BYTE_SAMPLING_FACTOR;
 	int BYTE_SAMPLING_OVERHEAD;
 	double MIN_BYTE_SAMPLING_PROBABILITY; // Adjustable only for test of PhysicalShardMove. Should always be 0 for other
@@ -1159,6 +1197,8 @@ public:
 	double FETCH_KEYS_TOO_LONG_TIME_CRITERIA;
 	double MAX_STORAGE_COMMIT_TIME;
 	int64_t RANGESTREAM_LIMIT_BYTES;
+	int64_t RANGESTREAM_EXPORT_READ_BYTES; // Engine read size per reply for range streams in export mode
+	int64_t RANGESTREAM_EXPORT_MAX_WINDOW_BYTES; // Upper bound on the in-flight byte window an export stream may request
 	int64_t BLOBWORKERSTATUSSTREAM_LIMIT_BYTES;
 	bool ENABLE_CLEAR_RANGE_EAGER_READS;
 	bool QUICK_GET_VALUE_FALLBACK;
@@ -1180,6 +1220,9 @@ public:
 	int FETCH_SHARD_UPDATES_BYTE_LIMIT;
 	bool TRACK_READ_LATENCIES_PER_TYPE;
 	int64_t STORAGE_UPDATE_PROCESS_STATS_INTERVAL;
+	// If true, eager reads for atomic ops are not sent to the storage engine when the key's latest value is already in
+	// the storage server's in-memory versioned data, e.g. a counter updated by an earlier version.
+	bool STORAGE_EAGER_READS_SKIP_IN_MEMORY_KEYS;
 
 	// Wait Failure
 	int MAX_OUTSTANDING_WAIT_FAILURE_REQUESTS;
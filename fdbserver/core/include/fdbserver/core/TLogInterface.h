@@ -25,6 +25,7 @@
 #include "fdbclient/FDBTypes.h"
 #include "fdbclient/CommitTransaction.h"
 #include "fdbrpc/TimedRequest.h"
+#include "flow/CompressionUtils.h"
 
 struct TLogInterface {
 	constexpr static FileIdentifier file_identifier = 16308510;
@@ -338,6 +339,10 @@ struct TLogCommitRequest : TimedRequest {
 	std::vector<uint16_t> tLogLocIds;
 	Optional<UID> debugID;
 
+	// If present, messages is compressed with this CompressionFilter and must be passed to decompressMessages()
+	// before it is parsed.
+	Optional<uint8_t> messagesCompression;
+
 	TLogCommitRequest() {}
 	TLogCommitRequest(const SpanContext& context,
 	                  const Arena& a,
@@ -354,6 +359,18 @@ struct TLogCommitRequest : TimedRequest {
 	    knownCommittedVersion(knownCommittedVersion), minKnownCommittedVersion(minKnownCommittedVersion),
 	    seqPrevVersion(seqPrevVersion), messages(messages), tLogCount(tLogCount), tLogLocIds(tLogLocIds),
 	    debugID(debugID) {}
+
+	// Restores the uncompressed messages sent by the commit proxy. Returns the number of bytes received on the wire.
+	int decompressMessages() {
+		int wireBytes = messages.size();
+		if (messagesCompression.present()) {
+			messages = CompressionUtils::decompress(
+			    static_cast<CompressionFilter>(messagesCompression.get()), messages, arena);
+			messagesCompression.reset();
+		}
+		return wireBytes;
+	}
+
 	template <class Ar>
 	void serialize(Ar& ar) {
 		serializer(ar,
@@ -368,7 +385,8 @@ struct TLogCommitRequest : TimedRequest {
 		           spanContext,
 		           seqPrevVersion,
 		           tLogLocIds,
-		           arena);
+		           arena,
+		           messagesCompression);
 	}
 };
 
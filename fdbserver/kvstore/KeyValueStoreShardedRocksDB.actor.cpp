@@ -38,7 +38,9 @@
 #include "flow/Histogram.h"
 #include "flow/UnitTest.h"
 
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <tuple>
 #include <vector>
 
@@ -67,6 +69,7 @@ const KeyRef persistVersion = "\xff\xffVersion"_sr;
 const StringRef SHARDED_ROCKSDB_HISTOGRAM_GROUP = "ShardedRocksDB"_sr;
 const StringRef ROCKSDB_COMMIT_LATENCY_HISTOGRAM = "RocksDBCommitLatency"_sr;
 const StringRef ROCKSDB_WRITE_ACTION_QUEUE_WAIT_HISTOGRAM = "RocksDBWriteActionQueueWait"_sr;
+const StringRef ROCKSDB_COMMIT_FOLLOW_UP_LATENCY_HISTOGRAM = "RocksDBCommitFollowUpLatency"_sr;
 const StringRef ROCKSDB_ADD_SHARD_LATENCY_HISTOGRAM = "RocksDBAddShardLatency"_sr;
 const StringRef ROCKSDB_REMOVE_SHARD_LATENCY_HISTOGRAM = "RocksDBRemoveShardLatency"_sr;
 const StringRef ROCKSDB_READRANGE_LATENCY_HISTOGRAM = "RocksDBReadRangeLatency"_sr;
@@ -417,10 +420,13 @@ struct Counters {
 	Counter immediateThrottle;
 	Counter failedToAcquire;
 	Counter convertedRangeDeletions;
+	Counter readBatches;
+	Counter batchedReads;
 
 	Counters()
 	  : cc("RocksDBCounters"), immediateThrottle("ImmediateThrottle", cc), failedToAcquire("FailedToAcquire", cc),
-	    convertedRangeDeletions("ConvertedRangeDeletions", cc) {}
+	    convertedRangeDeletions("ConvertedRangeDeletions", cc), readBatches("ReadBatches", cc),
+	    batchedReads("BatchedReads", cc) {}
 };
 
 rocksdb::CompactionPri getCompactionPriority() {
@@ -2054,6 +2060,7 @@ struct LatencyMetrics {
 	Reference<Histogram> addShardLatency;
 	Reference<Histogram> removeShardLatency;
 	Reference<Histogram> writeActionQueueWait;
+	Reference<Histogram> commitFollowUpLatency;
 
 	LatencyMetrics()
 	  : readRangeLatency(Histogram::getHistogram(SHARDED_ROCKSDB_HISTOGRAM_GROUP,
@@ -2082,13 +2089,112 @@ struct LatencyMetrics {
 	                                               Histogram::Unit::milliseconds)),
 	    writeActionQueueWait(Histogram::getHistogram(SHARDED_ROCKSDB_HISTOGRAM_GROUP,
 	                                                 ROCKSDB_WRITE_ACTION_QUEUE_WAIT_HISTOGRAM,
-	                                                 Histogram::Unit::milliseconds)) {}
+	                                                 Histogram::Unit::milliseconds)),
+	    commitFollowUpLatency(Histogram::getHistogram(SHARDED_ROCKSDB_HISTOGRAM_GROUP,
+	                                                  ROCKSDB_COMMIT_FOLLOW_UP_LATENCY_HISTOGRAM,
+	                                                  Histogram::Unit::milliseconds)) {}
 
 	// Delete copy constructors.
 	explicit(false) LatencyMetrics(const LatencyMetrics&) = delete;
 	LatencyMetrics& operator=(const LatencyMetrics&) = delete;
 };
 
+// Per-shard work that follows a commit, for one group of physical shards. Shards are grouped by column family id so
+// that each shard is handled by exactly one commit worker.
+struct CommitFollowUp {
+	std::vector<PhysicalShard*> shards;
+	std::vector<std::pair<rocksdb::ColumnFamilyHandle*, KeyRange>> deletes;
+
+	bool empty() const { return shards.empty() && deletes.empty(); }
+};
+
+void runCommitFollowUp(rocksdb::DB* db, const CommitFollowUp& work, IteratorPool* iteratorPool) {
+	if (SERVER_KNOBS->SHARDED_ROCKSDB_REUSE_ITERATORS) {
+		for (auto shard : work.shards) {
+			iteratorPool->update(shard->id);
+		}
+	}
+
+	if (SERVER_KNOBS->SHARDED_ROCKSDB_SUGGEST_COMPACT_CLEAR_RANGE) {
+		for (const auto& [cf, range] : work.deletes) {
+			auto begin = toSlice(range.begin);
+			auto end = toSlice(range.end);
+			ASSERT(db->SuggestCompactRange(cf, &begin, &end).ok());
+		}
+	}
+
+	// Check for number of range deletes in shards.
+	// TODO: Disable this once RocksDB is upgraded to a version with range delete improvement.
+	if (SERVER_KNOBS->ROCKSDB_CF_RANGE_DELETION_LIMIT > 0) {
+		rocksdb::FlushOptions fOptions;
+		fOptions.wait = SERVER_KNOBS->ROCKSDB_WAIT_ON_CF_FLUSH;
+		fOptions.allow_write_stall = SERVER_KNOBS->SHARDED_ROCKSDB_ALLOW_WRITE_STALL_ON_FLUSH;
+
+		for (auto shard : work.shards) {
+			if (shard->shouldFlush()) {
+				TraceEvent("FlushCF")
+				    .detail("PhysicalShardId", shard->id)
+				    .detail("NumRangeDeletions", shard->numRangeDeletions);
+				db->Flush(fOptions, shard->cf);
+				shard->numRangeDeletions = 0;
+			}
+		}
+	}
+}
+
+// Lets the writer thread block until the commit workers have finished the follow-up work of its commit. Every posted
+// action counts down exactly once, whether it runs or is cancelled.
+struct CommitFollowUpLatch {
+	std::mutex mutex;
+	std::condition_variable cv;
+	int remaining;
+
+	explicit CommitFollowUpLatch(int count) : remaining(count) {}
+
+	void countDown() {
+		std::lock_guard<std::mutex> lock(mutex);
+		if (--remaining == 0) {
+			cv.notify_all();
+		}
+	}
+
+	void wait() {
+		std::unique_lock<std::mutex> lock(mutex);
+		cv.wait(lock, [this] { return remaining == 0; });
+	}
+};
+
+// Updated by the commit worker threads and read by the metrics logger.
+struct CommitWorkerMetrics {
+	std::atomic<int> queueDepth;
+	std::vector<std::atomic<int64_t>> actions;
+	std::vector<std::atomic<int64_t>> busyMicros;
+	std::vector<std::atomic<int64_t>> maxLatencyMicros;
+
+	explicit CommitWorkerMetrics(int workers)
+	  : queueDepth(0), actions(workers), busyMicros(workers), maxLatencyMicros(workers) {}
+
+	void record(int worker, double latency) {
+		int64_t latencyMicros = latency * 1e6;
+		actions[worker]++;
+		busyMicros[worker] += latencyMicros;
+		if (latencyMicros > maxLatencyMicros[worker].load()) {
+			maxLatencyMicros[worker] = latencyMicros;
+		}
+	}
+
+	void logAndReset(UID id) {
+		TraceEvent e("ShardedRocksDBCommitWorkerMetrics", id);
+		e.detail("QueueDepth", queueDepth.load());
+		for (int i = 0; i < actions.size(); ++i) {
+			const std::string suffix = std::to_string(i);
+			e.detail("Actions" + suffix, actions[i].exchange(0));
+			e.detail("BusySeconds" + suffix, busyMicros[i].exchange(0) / 1e6);
+			e.detail("MaxLatencySeconds" + suffix, maxLatencyMicros[i].exchange(0) / 1e6);
+		}
+	}
+};
+
 struct RocksDBMetrics {
 	UID debugID;
 	std::shared_ptr<ShardedRocksDBState> rState;
@@ -2244,6 +2350,21 @@ ACTOR Future<Void> rocksDBAggregatedMetricsLogger(std::shared_ptr<ShardedRocksDB
 struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 	using CF = rocksdb::ColumnFamilyHandle*;
 
+	ACTOR static Future<Void> commitWorkerMetricsLogger(UID id,
+	                                                   std::shared_ptr<ShardedRocksDBState> rState,
+	                                                   std::shared_ptr<CommitWorkerMetrics> metrics,
+	                                                   Future<Void> openFuture) {
+		wait(openFuture);
+		loop {
+			wait(delay(SERVER_KNOBS->ROCKSDB_METRICS_DELAY));
+			if (rState->closing) {
+				break;
+			}
+			metrics->logAndReset(id);
+		}
+		return Void();
+	}
+
 	ACTOR static Future<Void> refreshIteratorPool(std::shared_ptr<ShardedRocksDBState> rState,
 	                                              std::shared_ptr<IteratorPool> iteratorPool,
 	                                              Future<Void> readyToStart) {
@@ -2408,23 +2529,79 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 		}
 	};
 
+	struct CommitWorker : IThreadPoolReceiver {
+		const UID logId;
+		int threadIndex;
+		std::shared_ptr<LatencyMetrics> latencyMetrics;
+		std::shared_ptr<IteratorPool> iteratorPool;
+		std::shared_ptr<CommitWorkerMetrics> metrics;
+
+		CommitWorker(UID logId,
+		             int threadIndex,
+		             std::shared_ptr<LatencyMetrics> latencyMetrics,
+		             std::shared_ptr<IteratorPool> iteratorPool,
+		             std::shared_ptr<CommitWorkerMetrics> metrics)
+		  : logId(logId), threadIndex(threadIndex), latencyMetrics(latencyMetrics), iteratorPool(iteratorPool),
+		    metrics(metrics) {}
+
+		void init() override {}
+		~CommitWorker() override = default;
+
+		// Runs on completion and when the pool cancels the action, so the writer is never left waiting.
+		struct FollowUpAction : TypedAction<CommitWorker, FollowUpAction> {
+			rocksdb::DB* db;
+			CommitFollowUp work;
+			CommitFollowUpLatch* latch;
+			CommitWorkerMetrics* metrics;
+
+			FollowUpAction(rocksdb::DB* db,
+			               CommitFollowUp&& work,
+			               CommitFollowUpLatch* latch,
+			               CommitWorkerMetrics* metrics)
+			  : db(db), work(std::move(work)), latch(latch), metrics(metrics) {
+				metrics->queueDepth++;
+			}
+			~FollowUpAction() override {
+				metrics->queueDepth--;
+				latch->countDown();
+			}
+			double getTimeEstimate() const override { return SERVER_KNOBS->COMMIT_TIME_ESTIMATE; }
+		};
+
+		void action(FollowUpAction& a) {
+			double begin = timer_monotonic();
+			runCommitFollowUp(a.db, a.work, iteratorPool.get());
+			double latency = timer_monotonic() - begin;
+			latencyMetrics->commitFollowUpLatency->sampleSeconds(latency);
+			metrics->record(threadIndex, latency);
+		}
+	};
+
 	struct Writer : IThreadPoolReceiver {
 		const UID logId;
 		int threadIndex;
 		std::unordered_map<uint32_t, rocksdb::ColumnFamilyHandle*>* columnFamilyMap;
 		std::shared_ptr<LatencyMetrics> latencyMetrics;
 		std::shared_ptr<IteratorPool> iteratorPool;
+		// Shares the follow-up work of each commit when set. Otherwise it runs on this thread, split into the same
+		// groups when commitWorkerMetrics is set.
+		IThreadPool* commitWorkers;
+		std::shared_ptr<CommitWorkerMetrics> commitWorkerMetrics;
 		double sampleStartTime;
 
 		explicit Writer(UID logId,
 		                int threadIndex,
 		                std::unordered_map<uint32_t, rocksdb::ColumnFamilyHandle*>* columnFamilyMap,
 		                std::shared_ptr<LatencyMetrics> latencyMetrics,
-		                std::shared_ptr<IteratorPool> iteratorPool)
+		                std::shared_ptr<IteratorPool> iteratorPool,
+		                IThreadPool* commitWorkers = nullptr,
+		                std::shared_ptr<CommitWorkerMetrics> commitWorkerMetrics = nullptr)
 		  : logId(logId), threadIndex(threadIndex), columnFamilyMap(columnFamilyMap), latencyMetrics(latencyMetrics),
-		    iteratorPool(iteratorPool), sampleStartTime(now()) {
+		    iteratorPool(iteratorPool), commitWorkers(commitWorkers), commitWorkerMetrics(commitWorkerMetrics),
+		    sampleStartTime(now()) {
 			ASSERT(latencyMetrics);
 			ASSERT(iteratorPool);
+			ASSERT(!commitWorkers || commitWorkerMetrics);
 		}
 
 		~Writer() override = default;
@@ -2602,39 +2779,47 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 				return;
 			}
 
-			if (SERVER_KNOBS->SHARDED_ROCKSDB_REUSE_ITERATORS) {
-				for (auto shard : *(a.dirtyShards)) {
-					iteratorPool->update(shard->id);
-				}
+			// The write above is the single durability point of the commit. What follows is per-shard, so it is split
+			// into groups of shards and, with commit workers, run in parallel. Column family handles are resolved here
+			// because columnFamilyMap is only accessed from this thread.
+			const int groupCount = commitWorkerMetrics ? SERVER_KNOBS->SHARDED_ROCKSDB_COMMIT_WORKERS : 1;
+			std::vector<CommitFollowUp> groups(groupCount);
+			for (auto shard : *(a.dirtyShards)) {
+				groups[shard->cf->GetID() % groupCount].shards.push_back(shard);
 			}
-
-			if (SERVER_KNOBS->SHARDED_ROCKSDB_SUGGEST_COMPACT_CLEAR_RANGE) {
-				for (const auto& [id, range] : deletes) {
-					auto cf = columnFamilyMap->find(id);
-					ASSERT(cf != columnFamilyMap->end());
-					auto begin = toSlice(range.begin);
-					auto end = toSlice(range.end);
-
-					ASSERT(a.db->SuggestCompactRange(cf->second, &begin, &end).ok());
-				}
+			for (const auto& [id, range] : deletes) {
+				auto cf = columnFamilyMap->find(id);
+				ASSERT(cf != columnFamilyMap->end());
+				groups[id % groupCount].deletes.emplace_back(cf->second, range);
 			}
 
-			// Check for number of range deletes in shards.
-			// TODO: Disable this once RocksDB is upgraded to a version with range delete improvement.
-			if (SERVER_KNOBS->ROCKSDB_CF_RANGE_DELETION_LIMIT > 0) {
-				rocksdb::FlushOptions fOptions;
-				fOptions.wait = SERVER_KNOBS->ROCKSDB_WAIT_ON_CF_FLUSH;
-				fOptions.allow_write_stall = SERVER_KNOBS->SHARDED_ROCKSDB_ALLOW_WRITE_STALL_ON_FLUSH;
-
-				for (auto shard : (*a.dirtyShards)) {
-					if (shard->shouldFlush()) {
-						TraceEvent("FlushCF")
-						    .detail("PhysicalShardId", shard->id)
-						    .detail("NumRangeDeletions", shard->numRangeDeletions);
-						a.db->Flush(fOptions, shard->cf);
-						shard->numRangeDeletions = 0;
+			if (groupCount == 1) {
+				runCommitFollowUp(a.db, groups[0], iteratorPool.get());
+			} else if (!commitWorkers) {
+				// In simulation the writer is a coroutine and cannot block on other threads, so the groups run here in
+				// turn, accounted as if each had its own worker.
+				for (int i = 0; i < groupCount; ++i) {
+					if (!groups[i].empty()) {
+						double begin = timer_monotonic();
+						runCommitFollowUp(a.db, groups[i], iteratorPool.get());
+						double latency = timer_monotonic() - begin;
+						latencyMetrics->commitFollowUpLatency->sampleSeconds(latency);
+						commitWorkerMetrics->record(i, latency);
+					}
+				}
+			} else {
+				int posted = 0;
+				for (const auto& group : groups) {
+					posted += !group.empty();
+				}
+				CommitFollowUpLatch latch(posted);
+				for (auto& group : groups) {
+					if (!group.empty()) {
+						commitWorkers->post(new CommitWorker::FollowUpAction(
+						    a.db, std::move(group), &latch, commitWorkerMetrics.get()));
 					}
 				}
+				latch.wait();
 			}
 
 			if (a.sample) {
@@ -3094,16 +3279,8 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 			double getTimeEstimate() const override { return SERVER_KNOBS->READ_VALUE_TIME_ESTIMATE; }
 		};
 
-		void action(ReadValueAction& a) {
-			double readBeginTime = timer_monotonic();
-			if (a.sample) {
-				latencyMetrics->readActionQueueWait->sampleSeconds(readBeginTime - a.startTime);
-			}
-			Optional<TraceBatch> traceBatch;
-			if (a.debugID.present()) {
-				traceBatch = { TraceBatch{} };
-				traceBatch.get().addEvent("GetValueDebug", a.debugID.get().first(), "Reader.Before");
-			}
+		// Sends an error to a throttled read that waited in the queue past its timeout, returns true if it did.
+		bool readValueTimedOut(ReadValueAction& a, double readBeginTime) {
 			if (shouldThrottle(a.type, a.key) && SERVER_KNOBS->ROCKSDB_SET_READ_TIMEOUT &&
 			    readBeginTime - a.startTime > readValueTimeout) {
 				TraceEvent(SevWarn, "ShardedRocksDBError")
@@ -3115,21 +3292,22 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 				} else {
 					a.result.sendError(key_value_store_deadline_exceeded());
 				}
-				return;
+				return true;
 			}
+			return false;
+		}
 
-			rocksdb::PinnableSlice value;
-			auto options = getReadOptions();
-
-			auto db = a.shard->db;
-			if (shouldThrottle(a.type, a.key) && SERVER_KNOBS->ROCKSDB_SET_READ_TIMEOUT) {
-				uint64_t deadlineMircos =
-				    db->GetEnv()->NowMicros() + (readValueTimeout - (timer_monotonic() - a.startTime)) * 1000000;
-				std::chrono::seconds deadlineSeconds(deadlineMircos / 1000000);
-				options.deadline = std::chrono::duration_cast<std::chrono::microseconds>(deadlineSeconds);
-			}
-			auto s = db->Get(options, a.shard->cf, toSlice(a.key), &value);
+		void setReadValueDeadline(rocksdb::ReadOptions& options, rocksdb::DB* db, double startTime) {
+			uint64_t deadlineMircos =
+			    db->GetEnv()->NowMicros() + (readValueTimeout - (timer_monotonic() - startTime)) * 1000000;
+			std::chrono::seconds deadlineSeconds(deadlineMircos / 1000000);
+			options.deadline = std::chrono::duration_cast<std::chrono::microseconds>(deadlineSeconds);
+		}
 
+		void sendReadValueResult(ReadValueAction& a,
+		                         const rocksdb::Status& s,
+		                         const rocksdb::PinnableSlice& value,
+		                         Optional<TraceBatch>& traceBatch) {
 			if (a.sample) {
 				latencyMetrics->readValueLatency->sampleSeconds(timer_monotonic() - a.startTime);
 			}
@@ -3148,6 +3326,86 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 			}
 		}
 
+		void action(ReadValueAction& a) {
+			double readBeginTime = timer_monotonic();
+			if (a.sample) {
+				latencyMetrics->readActionQueueWait->sampleSeconds(readBeginTime - a.startTime);
+			}
+			Optional<TraceBatch> traceBatch;
+			if (a.debugID.present()) {
+				traceBatch = { TraceBatch{} };
+				traceBatch.get().addEvent("GetValueDebug", a.debugID.get().first(), "Reader.Before");
+			}
+			if (readValueTimedOut(a, readBeginTime)) {
+				return;
+			}
+
+			rocksdb::PinnableSlice value;
+			auto options = getReadOptions();
+
+			auto db = a.shard->db;
+			if (shouldThrottle(a.type, a.key) && SERVER_KNOBS->ROCKSDB_SET_READ_TIMEOUT) {
+				setReadValueDeadline(options, db, a.startTime);
+			}
+			auto s = db->Get(options, a.shard->cf, toSlice(a.key), &value);
+			sendReadValueResult(a, s, value, traceBatch);
+		}
+
+		// Point reads that arrived in the same run loop iteration, served with one MultiGet per column family.
+		struct MultiGetAction : TypedAction<Reader, MultiGetAction> {
+			std::vector<std::unique_ptr<ReadValueAction>> reads;
+
+			double getTimeEstimate() const override { return SERVER_KNOBS->READ_VALUE_TIME_ESTIMATE * reads.size(); }
+		};
+
+		void action(MultiGetAction& a) {
+			double readBeginTime = timer_monotonic();
+			std::vector<Optional<TraceBatch>> traceBatches(a.reads.size());
+
+			// Throttled reads carry a deadline, so they are grouped apart from the others of the same column family.
+			std::map<std::tuple<rocksdb::DB*, rocksdb::ColumnFamilyHandle*, bool>, std::vector<int>> groups;
+			for (int i = 0; i < a.reads.size(); ++i) {
+				ReadValueAction& r = *a.reads[i];
+				if (r.sample) {
+					latencyMetrics->readActionQueueWait->sampleSeconds(readBeginTime - r.startTime);
+				}
+				if (r.debugID.present()) {
+					traceBatches[i] = { TraceBatch{} };
+					traceBatches[i].get().addEvent("GetValueDebug", r.debugID.get().first(), "Reader.Before");
+				}
+				if (readValueTimedOut(r, readBeginTime)) {
+					continue;
+				}
+				bool throttled = shouldThrottle(r.type, r.key) && SERVER_KNOBS->ROCKSDB_SET_READ_TIMEOUT;
+				groups[{ r.shard->db, r.shard->cf, throttled }].push_back(i);
+			}
+
+			for (const auto& [group, indexes] : groups) {
+				auto [db, cf, throttled] = group;
+				auto options = getReadOptions();
+				if (throttled) {
+					double startTime = a.reads[indexes.front()]->startTime;
+					for (int i : indexes) {
+						startTime = std::min(startTime, a.reads[i]->startTime);
+					}
+					setReadValueDeadline(options, db, startTime);
+				}
+
+				std::vector<rocksdb::Slice> keys;
+				keys.reserve(indexes.size());
+				for (int i : indexes) {
+					keys.push_back(toSlice(a.reads[i]->key));
+				}
+				std::vector<rocksdb::PinnableSlice> values(indexes.size());
+				std::vector<rocksdb::Status> statuses(indexes.size());
+				db->MultiGet(options, cf, keys.size(), keys.data(), values.data(), statuses.data());
+
+				for (int j = 0; j < indexes.size(); ++j) {
+					sendReadValueResult(*a.reads[indexes[j]], statuses[j], values[j], traceBatches[indexes[j]]);
+				}
+			}
+		}
+
 		struct ReadValuePrefixAction : TypedAction<Reader, ReadValuePrefixAction> {
 			Key key;
 			int maxLength;
@@ -3385,7 +3643,26 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 			compactionThread = createGenericThreadPool(0, SERVER_KNOBS->ROCKSDB_COMPACTION_THREAD_PRIORITY);
 			readThreads = createGenericThreadPool(/*stackSize=*/0, SERVER_KNOBS->ROCKSDB_READER_THREAD_PRIORITY);
 		}
-		writeThread->addThread(new Writer(id, 0, shardManager.getColumnFamilyMap(), latencyMetrics, iteratorPool),
+		if (SERVER_KNOBS->SHARDED_ROCKSDB_COMMIT_WORKERS > 1) {
+			commitWorkerMetrics = std::make_shared<CommitWorkerMetrics>(SERVER_KNOBS->SHARDED_ROCKSDB_COMMIT_WORKERS);
+			// The writer blocks while commit workers run, which a coroutine thread pool cannot do. In simulation the
+			// writer runs the groups itself.
+			if (!g_network->isSimulated()) {
+				commitWorkerThreads =
+				    createGenericThreadPool(/*stackSize=*/0, SERVER_KNOBS->ROCKSDB_WRITER_THREAD_PRIORITY);
+				for (int i = 0; i < SERVER_KNOBS->SHARDED_ROCKSDB_COMMIT_WORKERS; ++i) {
+					commitWorkerThreads->addThread(
+					    new CommitWorker(id, i, latencyMetrics, iteratorPool, commitWorkerMetrics), "fdb-rocksdb-cm");
+				}
+			}
+		}
+		writeThread->addThread(new Writer(id,
+		                                  0,
+		                                  shardManager.getColumnFamilyMap(),
+		                                  latencyMetrics,
+		                                  iteratorPool,
+		                                  commitWorkerThreads.getPtr(),
+		                                  commitWorkerMetrics),
 		                       "fdb-rocksdb-wr");
 		compactionThread->addThread(new CompactionWorker(id), "fdb-rocksdb-cw");
 		TraceEvent("ShardedRocksDBReadThreads", id)
@@ -3405,6 +3682,11 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 		self->refreshRocksDBBackgroundWorkHolder.cancel();
 		self->cleanUpJob.cancel();
 		self->counterLogger.cancel();
+		self->commitWorkerMetricsJob.cancel();
+		self->readBatchFlush.cancel();
+		if (self->pendingReads) {
+			self->postReadBatch();
+		}
 
 		try {
 			wait(self->readThreads->stop());
@@ -3426,6 +3708,9 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 		try {
 			wait(self->writeThread->stop());
 			wait(self->compactionThread->stop());
+			if (self->commitWorkerThreads) {
+				wait(self->commitWorkerThreads->stop());
+			}
 		} catch (Error& e) {
 			TraceEvent(SevError, "ShardedRocksCloseWriteThreadError").errorUnsuppressed(e);
 		}
@@ -3470,6 +3755,9 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 			this->refreshRocksDBBackgroundWorkHolder =
 			    refreshRocksDBBackgroundEventCounter(this->id, this->eventListener);
 			this->cleanUpJob = emptyShardCleaner(this->rState, openFuture, &shardManager, writeThread);
+			if (commitWorkerMetrics) {
+				this->commitWorkerMetricsJob = commitWorkerMetricsLogger(id, rState, commitWorkerMetrics, openFuture);
+			}
 			writeThread->post(a.release());
 			counterLogger = counters.cc.traceCounters("RocksDBCounters", id, SERVER_KNOBS->ROCKSDB_METRICS_DELAY);
 			return openFuture;
@@ -3596,7 +3884,7 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 		if (!shouldThrottle(type, key)) {
 			auto a = new Reader::ReadValueAction(key, shard->physicalShard, type, debugID);
 			auto res = a->result.getFuture();
-			readThreads->post(a);
+			postReadValue(a);
 			return res;
 		}
 
@@ -3605,7 +3893,65 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 
 		checkWaiters(semaphore, maxWaiters);
 		auto a = std::make_unique<Reader::ReadValueAction>(key, shard->physicalShard, type, debugID);
-		return read(a.release(), &semaphore, readThreads.getPtr(), &counters.failedToAcquire);
+		return readValueBatched(this, a.release(), &semaphore, &counters.failedToAcquire);
+	}
+
+	// Same as read(), but the action joins the current point read batch instead of being posted on its own.
+	ACTOR static Future<Optional<Value>> readValueBatched(ShardedRocksDBKeyValueStore* self,
+	                                                      Reader::ReadValueAction* action,
+	                                                      FlowLock* semaphore,
+	                                                      Counter* counter) {
+		state std::unique_ptr<Reader::ReadValueAction> a(action);
+		state Optional<Void> slot = wait(timeout(semaphore->take(), SERVER_KNOBS->ROCKSDB_READ_QUEUE_WAIT));
+		if (!slot.present()) {
+			++(*counter);
+			throw server_overloaded();
+		}
+
+		state FlowLock::Releaser release(*semaphore);
+
+		auto fut = a->result.getFuture();
+		self->postReadValue(a.release());
+		Optional<Value> result = wait(fut);
+
+		return result;
+	}
+
+	// Point reads issued in the same run loop iteration are gathered into one MultiGetAction, so that a reader
+	// thread serves them with a MultiGet per column family instead of one Get and one thread pool hop per key.
+	void postReadValue(Reader::ReadValueAction* a) {
+		if (SERVER_KNOBS->SHARDED_ROCKSDB_READ_VALUE_BATCH_SIZE <= 1) {
+			readThreads->post(a);
+			return;
+		}
+		if (!pendingReads) {
+			pendingReads = std::make_unique<Reader::MultiGetAction>();
+			readBatchFlush = flushReadBatch(this);
+		}
+		pendingReads->reads.emplace_back(a);
+		if (pendingReads->reads.size() >= SERVER_KNOBS->SHARDED_ROCKSDB_READ_VALUE_BATCH_SIZE) {
+			postReadBatch();
+		}
+	}
+
+	void postReadBatch() {
+		std::unique_ptr<Reader::MultiGetAction> batch = std::move(pendingReads);
+		if (batch->reads.size() == 1) {
+			readThreads->post(batch->reads.front().release());
+			return;
+		}
+		++counters.readBatches;
+		counters.batchedReads += batch->reads.size();
+		readThreads->post(batch.release());
+	}
+
+	ACTOR static Future<Void> flushReadBatch(ShardedRocksDBKeyValueStore* self) {
+		// Let every read already scheduled in this run loop iteration join the batch
+		wait(delay(0));
+		if (self->pendingReads) {
+			self->postReadBatch();
+		}
+		return Void();
 	}
 
 	Future<Optional<Value>> readValuePrefix(KeyRef key, int maxLength, Optional<ReadOptions> options) override {
@@ -3859,6 +4205,8 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 	Reference<IThreadPool> writeThread;
 	Reference<IThreadPool> compactionThread;
 	Reference<IThreadPool> readThreads;
+	Reference<IThreadPool> commitWorkerThreads;
+	std::shared_ptr<CommitWorkerMetrics> commitWorkerMetrics;
 	Future<Void> errorFuture;
 	Promise<Void> closePromise;
 	Future<Void> openFuture;
@@ -3867,12 +4215,16 @@ struct ShardedRocksDBKeyValueStore : IKeyValueStore {
 	int numReadWaiters;
 	FlowLock fetchSemaphore;
 	int numFetchWaiters;
+	// Point reads waiting to be posted to readThreads together, see postReadValue()
+	std::unique_ptr<Reader::MultiGetAction> pendingReads;
+	Future<Void> readBatchFlush;
 	Counters counters;
 	Future<Void> compactionJob;
 	Future<Void> refreshHolder;
 	Future<Void> refreshRocksDBBackgroundWorkHolder;
 	Future<Void> cleanUpJob;
 	Future<Void> counterLogger;
+	Future<Void> commitWorkerMetricsJob;
 };
 
 ACTOR Future<Void> testCheckpointRestore(IKeyValueStore* kvStore, std::vector<KeyRange> ranges) {
@@ -3990,6 +4342,44 @@ TEST_CASE("noSim/ShardedRocksDB/SingleShardRead") {
 	return Void();
 }
 
+TEST_CASE("noSim/ShardedRocksDB/BatchedPointReads") {
+	state const std::string rocksDBTestDir = "sharded-rocksdb-test-db";
+	platform::eraseDirectoryRecursive(rocksDBTestDir);
+
+	state IKeyValueStore* kvStore =
+	    new ShardedRocksDBKeyValueStore(rocksDBTestDir, deterministicRandom()->randomUniqueID());
+	wait(kvStore->init());
+
+	wait(kvStore->addRange(KeyRangeRef("a"_sr, "b"_sr), "shard-1"));
+	wait(kvStore->addRange(KeyRangeRef("b"_sr, "c"_sr), "shard-2"));
+
+	state int count = 500;
+	for (int i = 0; i < count; i += 2) {
+		kvStore->set({ Key(format("%c%06d", i % 4 == 0 ? 'a' : 'b', i)), Value(format("v%d", i)) });
+	}
+	wait(kvStore->commit(false));
+
+	// Reads issued together are served as batches spanning both shards, with hits and misses mixed
+	state std::vector<Future<Optional<Value>>> reads;
+	for (int i = 0; i < count; ++i) {
+		reads.push_back(kvStore->readValue(Key(format("%c%06d", i % 4 < 2 ? 'a' : 'b', i))));
+	}
+	wait(waitForAll(reads));
+	for (int i = 0; i < count; ++i) {
+		if (i % 2 == 0) {
+			ASSERT(reads[i].get() == Optional<Value>(Value(format("v%d", i))));
+		} else {
+			ASSERT(!reads[i].get().present());
+		}
+	}
+
+	Future<Void> closed = kvStore->onClosed();
+	kvStore->dispose();
+	wait(closed);
+	ASSERT(!directoryExists(rocksDBTestDir));
+	return Void();
+}
+
 TEST_CASE("noSim/ShardedRocksDB/RangeOps") {
 	state std::string rocksDBTestDir = "sharded-rocksdb-kvs-test-db";
 	platform::eraseDirectoryRecursive(rocksDBTestDir);
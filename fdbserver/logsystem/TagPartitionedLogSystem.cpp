@@ -27,6 +27,7 @@
 #include "fdbserver/core/WaitFailure.h"
 
 #include "flow/CoroUtils.h"
+#include "flow/UnitTest.h"
 
 namespace {
 
@@ -592,6 +593,54 @@ Future<TLogCommitReply> TagPartitionedLogSystem::recordPushMetrics(Reference<Con
 	co_return t;
 }
 
+// Compresses the per-TLog push payloads of one version when TLOG_PUSH_COMPRESSION is enabled. TLogs that are sent the
+// same tags receive byte-identical payloads, which are compressed only once.
+class TLogPushCompressor {
+public:
+	TLogPushCompressor(bool enabled, int minBytes)
+	  : filter(enabled && CompressionUtils::supportedFilters.contains(CompressionFilter::ZSTD) ? CompressionFilter::ZSTD
+	                                                                                          : CompressionFilter::NONE),
+	    minBytes(minBytes) {}
+
+	// Returns the payload to send in place of msg, and sets compression if the payload is compressed.
+	Standalone<StringRef> compress(const Standalone<StringRef>& msg, Optional<uint8_t>& compression) {
+		if (filter == CompressionFilter::NONE || msg.size() < minBytes) {
+			return msg;
+		}
+		for (const auto& [raw, compressed] : payloads) {
+			if (raw == msg) {
+				CODE_PROBE(true, "TLog push payload compressed once for several TLogs");
+				return setCompression(msg, compressed, compression);
+			}
+		}
+
+		Arena arena;
+		StringRef result = CompressionUtils::compress(filter, msg, arena);
+		Optional<Standalone<StringRef>> compressed;
+		// Payloads that do not shrink are sent as is
+		if (result.size() < msg.size()) {
+			compressed = Standalone<StringRef>(result, arena);
+		}
+		payloads.emplace_back(msg, compressed);
+		return setCompression(msg, compressed, compression);
+	}
+
+private:
+	Standalone<StringRef> setCompression(const Standalone<StringRef>& msg,
+	                                     const Optional<Standalone<StringRef>>& compressed,
+	                                     Optional<uint8_t>& compression) const {
+		if (!compressed.present()) {
+			return msg;
+		}
+		compression = static_cast<uint8_t>(filter);
+		return compressed.get();
+	}
+
+	const CompressionFilter filter;
+	const int minBytes;
+	std::vector<std::pair<Standalone<StringRef>, Optional<Standalone<StringRef>>>> payloads;
+};
+
 Future<Version> TagPartitionedLogSystem::push(const ILogSystem::PushVersionSet& versionSet,
                                               LogPushData& data,
                                               SpanContext const& spanContext,
@@ -629,6 +678,7 @@ Future<Version> TagPartitionedLogSystem::push(const ILogSystem::PushVersionSet&
 	uint8_t logGroupLocal = 0;
 	std::vector<Future<Void>> quorumResults;
 	std::vector<std::pair<UID, Future<TLogCommitReply>>> allReplies;
+	TLogPushCompressor compressor(SERVER_KNOBS->TLOG_PUSH_COMPRESSION, SERVER_KNOBS->TLOG_PUSH_COMPRESSION_MIN_BYTES);
 	const Span span("TPLS:push"_loc, spanContext);
 	for (auto& it : tLogs) {
 		if (!it->isLocal) {
@@ -669,17 +719,20 @@ Future<Version> TagPartitionedLogSystem::push(const ILogSystem::PushVersionSet&
 			}
 
 			const auto& interface = it->logServers[loc]->get().interf();
-			const auto request = TLogCommitRequest(spanContext,
-			                                       msg.arena(),
-			                                       prevVersion,
-			                                       versionSet.version,
-			                                       versionSet.knownCommittedVersion,
-			                                       versionSet.minKnownCommittedVersion,
-			                                       seqPrevVersion,
-			                                       msg,
-			                                       tLogCount[logGroupLocal],
-			                                       tLogLocIds[logGroupLocal],
-			                                       debugID);
+			Optional<uint8_t> messagesCompression;
+			Standalone<StringRef> payload = compressor.compress(msg, messagesCompression);
+			auto request = TLogCommitRequest(spanContext,
+			                                 payload.arena(),
+			                                 prevVersion,
+			                                 versionSet.version,
+			                                 versionSet.knownCommittedVersion,
+			                                 versionSet.minKnownCommittedVersion,
+			                                 seqPrevVersion,
+			                                 payload,
+			                                 tLogCount[logGroupLocal],
+			                                 tLogLocIds[logGroupLocal],
+			                                 debugID);
+			request.messagesCompression = messagesCompression;
 			auto tLogReply = recordPushMetrics(it->connectionResetTrackers[loc],
 			                                   it->tlogPushDistTrackers[loc],
 			                                   interface.address(),
@@ -3704,3 +3757,40 @@ Future<Void> TagPartitionedLogSystem::trackTLogRecoveryActor(
 		recoveredVersion->set(currentRecoveredVersion);
 	}
 }
+
+TEST_CASE("/TagPartitionedLogSystem/PushCompression") {
+	if (!CompressionUtils::supportedFilters.contains(CompressionFilter::ZSTD)) {
+		return Void();
+	}
+	TLogPushCompressor compressor(true, 100);
+
+	Optional<uint8_t> compression;
+	Standalone<StringRef> small("small"_sr);
+	ASSERT(compressor.compress(small, compression) == small);
+	ASSERT(!compression.present());
+
+	Standalone<StringRef> msg = makeString(100000);
+	for (int i = 0; i < msg.size(); i++) {
+		mutateString(msg)[i] = 'a' + (i % 7);
+	}
+	Standalone<StringRef> compressed = compressor.compress(msg, compression);
+	ASSERT(compression.present());
+	ASSERT_LT(compressed.size(), msg.size());
+
+	// An identical payload for another TLog reuses the first compression
+	Optional<uint8_t> compression2;
+	Standalone<StringRef> copy(msg.toString());
+	Standalone<StringRef> compressed2 = compressor.compress(copy, compression2);
+	ASSERT(compression2 == compression);
+	ASSERT(compressed2.begin() == compressed.begin());
+
+	std::vector<uint16_t> tLogLocIds;
+	TLogCommitRequest req(
+	    SpanContext(), compressed.arena(), 1, 2, 0, 0, 1, compressed, 1, tLogLocIds, Optional<UID>());
+	req.messagesCompression = compression;
+	ASSERT_EQ(req.decompressMessages(), compressed.size());
+	ASSERT(!req.messagesCompression.present());
+	ASSERT(req.messages == msg);
+
+	return Void();
+}
@@ -116,6 +116,9 @@ struct SWIFT_CXX_REF_MASTERDATA MasterData : NonCopyable, ReferenceCounted<Maste
 	CounterValue getCommitVersionRequests;
 	CounterValue getLiveCommittedVersionRequests;
 	CounterValue reportLiveCommittedVersionRequests;
+	// The number of batches the version requests counted above were answered in
+	CounterValue commitVersionBatches;
+	CounterValue liveCommittedVersionBatches;
 	// This counter gives an estimate of the number of non-empty peeks that storage servers
 	// should do from tlogs (in the worst case, ignoring blocking peek timeouts).
 	std::unique_ptr<LatencySample> versionVectorTagUpdates;
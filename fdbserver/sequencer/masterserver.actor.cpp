@@ -19,7 +19,9 @@
  */
 
 #include <algorithm>
+#include <deque>
 #include <iterator>
+#include <tuple>
 
 #include "fdbrpc/sim_validation.h"
 #include "fdbserver/core/CoordinatedState.h"
@@ -127,34 +129,19 @@ SWIFT_ACTOR Future<Void> getVersionSwift(Reference<MasterData> self, GetCommitVe
 }
 #endif
 
-ACTOR Future<Void> getVersionCxx(Reference<MasterData> self, GetCommitVersionRequest req) {
-	state Span span("M:getVersion"_loc, req.spanContext);
-	state std::map<UID, CommitProxyVersionReplies>::iterator proxyItr =
-	    self->lastCommitProxyVersionReplies.find(req.requestingProxy); // lastCommitProxyVersionReplies never changes
-
-	++self->getCommitVersionRequests;
-
-	if (proxyItr == self->lastCommitProxyVersionReplies.end()) {
-		// Request from invalid proxy (e.g. from duplicate recruitment request)
-		req.reply.send(Never());
-		return Void();
-	}
-
-	CODE_PROBE(proxyItr->second.latestRequestNum.get() < req.requestNum - 1,
-	           "Commit version request queued up",
-	           probe::decoration::rare);
-	wait(proxyItr->second.latestRequestNum.whenAtLeast(req.requestNum - 1));
-
-	auto itr = proxyItr->second.replies.find(req.requestNum);
-	if (itr != proxyItr->second.replies.end()) {
+// Answers a commit version request once the proxy's previous request has been answered
+void replyToCommitVersionRequest(Reference<MasterData> self,
+                                 CommitProxyVersionReplies& proxyReplies,
+                                 GetCommitVersionRequest const& req) {
+	auto itr = proxyReplies.replies.find(req.requestNum);
+	if (itr != proxyReplies.replies.end()) {
 		CODE_PROBE(true, "Duplicate request for sequence");
 		req.reply.send(itr->second);
-	} else if (req.requestNum <= proxyItr->second.latestRequestNum.get()) {
+	} else if (req.requestNum <= proxyReplies.latestRequestNum.get()) {
 		CODE_PROBE(true,
 		           "Old request for previously acknowledged sequence - may be impossible with current FlowTransport",
 		           probe::decoration::rare);
-		ASSERT(req.requestNum <
-		       proxyItr->second.latestRequestNum.get()); // The latest request can never be acknowledged
+		ASSERT(req.requestNum < proxyReplies.latestRequestNum.get()); // The latest request can never be acknowledged
 		req.reply.send(Never());
 	} else {
 		GetCommitVersionReply rep;
@@ -200,16 +187,37 @@ ACTOR Future<Void> getVersionCxx(Reference<MasterData> self, GetCommitVersionReq
 		rep.version = self->version;
 		rep.requestNum = req.requestNum;
 
-		proxyItr->second.replies.erase(proxyItr->second.replies.begin(),
-		                               proxyItr->second.replies.upper_bound(req.mostRecentProcessedRequestNum));
-		proxyItr->second.replies[req.requestNum] = rep;
+		proxyReplies.replies.erase(proxyReplies.replies.begin(),
+		                           proxyReplies.replies.upper_bound(req.mostRecentProcessedRequestNum));
+		proxyReplies.replies[req.requestNum] = rep;
 		ASSERT(rep.prevVersion >= 0);
 
 		req.reply.send(rep);
 
-		ASSERT(proxyItr->second.latestRequestNum.get() == req.requestNum - 1);
-		proxyItr->second.latestRequestNum.set(req.requestNum);
+		ASSERT(proxyReplies.latestRequestNum.get() == req.requestNum - 1);
+		proxyReplies.latestRequestNum.set(req.requestNum);
 	}
+}
+
+ACTOR Future<Void> getVersionCxx(Reference<MasterData> self, GetCommitVersionRequest req) {
+	state Span span("M:getVersion"_loc, req.spanContext);
+	state std::map<UID, CommitProxyVersionReplies>::iterator proxyItr =
+	    self->lastCommitProxyVersionReplies.find(req.requestingProxy); // lastCommitProxyVersionReplies never changes
+
+	++self->getCommitVersionRequests;
+
+	if (proxyItr == self->lastCommitProxyVersionReplies.end()) {
+		// Request from invalid proxy (e.g. from duplicate recruitment request)
+		req.reply.send(Never());
+		return Void();
+	}
+
+	CODE_PROBE(proxyItr->second.latestRequestNum.get() < req.requestNum - 1,
+	           "Commit version request queued up",
+	           probe::decoration::rare);
+	wait(proxyItr->second.latestRequestNum.whenAtLeast(req.requestNum - 1));
+
+	replyToCommitVersionRequest(self, proxyItr->second, req);
 
 	return Void();
 }
@@ -259,6 +267,7 @@ MasterData::MasterData(Reference<AsyncVar<ServerDBInfo> const> const& dbInfo,
     getCommitVersionRequests("GetCommitVersionRequests", cc),
     getLiveCommittedVersionRequests("GetLiveCommittedVersionRequests", cc),
     reportLiveCommittedVersionRequests("ReportLiveCommittedVersionRequests", cc),
+    commitVersionBatches("CommitVersionBatches", cc), liveCommittedVersionBatches("LiveCommittedVersionBatches", cc),
     waitForPrevCommitRequests("WaitForPrevCommitRequests", cc),
     nonWaitForPrevCommitRequests("NonWaitForPrevCommitRequests", cc), addActor(addActor) {
 	logger = cc.traceCounters("MasterMetrics", dbgid, SERVER_KNOBS->WORKER_LOGGING_INTERVAL, "MasterMetrics");
@@ -299,12 +308,50 @@ void MasterData::setSwiftImpl(fdbserver_swift::MasterDataActor* impl) {
 
 MasterData::~MasterData() {}
 
-ACTOR Future<Void> provideVersionsCxx(Reference<MasterData> self) {
+// Answers a batch of commit version requests in one pass. Each proxy's requests are answered in request number
+// order, so the requests a proxy has pipelined are answered together. A request whose predecessor has not arrived yet
+// gets its own getVersion() actor to wait for it.
+void replyToCommitVersionRequests(Reference<MasterData> self,
+                                  std::vector<GetCommitVersionRequest>& batch,
+                                  ActorCollection& versionActors) {
+	std::sort(batch.begin(), batch.end(), [](GetCommitVersionRequest const& a, GetCommitVersionRequest const& b) {
+		return std::tie(a.requestingProxy, a.requestNum) < std::tie(b.requestingProxy, b.requestNum);
+	});
+
+	++self->commitVersionBatches;
+	for (auto& req : batch) {
+		auto proxyItr = self->lastCommitProxyVersionReplies.find(req.requestingProxy);
+		if (proxyItr == self->lastCommitProxyVersionReplies.end() ||
+		    proxyItr->second.latestRequestNum.get() < req.requestNum - 1) {
+			versionActors.add(getVersion(self, req));
+			continue;
+		}
+
+		Span span("M:getVersion"_loc, req.spanContext);
+		++self->getCommitVersionRequests;
+		replyToCommitVersionRequest(self, proxyItr->second, req);
+	}
+	batch.clear();
+}
+
+ACTOR Future<Void> provideVersionsCxx(Reference<MasterData> self, bool batched) {
 	state ActorCollection versionActors(false);
+	state std::vector<GetCommitVersionRequest> batch;
 
 	loop choose {
 		when(GetCommitVersionRequest req = waitNext(self->myInterface.getCommitVersion.getFuture())) {
-			versionActors.add(getVersion(self, req));
+			if (!batched) {
+				versionActors.add(getVersion(self, req));
+			} else {
+				// Requests are delivered as they are read off the network, so yield once to let the other requests
+				// already received at this priority join the batch
+				batch.push_back(req);
+				wait(delay(0, TaskPriority::GetConsistentReadVersion));
+				while (self->myInterface.getCommitVersion.getFuture().isReady()) {
+					batch.push_back(self->myInterface.getCommitVersion.getFuture().pop());
+				}
+				replyToCommitVersionRequests(self, batch, versionActors);
+			}
 		}
 		when(wait(versionActors.getResult())) {}
 	}
@@ -323,14 +370,14 @@ ACTOR Future<Void> provideVersions(Reference<MasterData> self) {
 	if (SERVER_KNOBS->FLOW_WITH_SWIFT) {
 		wait(provideVersionsSwift(self));
 	} else {
-		wait(provideVersionsCxx(self));
+		wait(provideVersionsCxx(self, SERVER_KNOBS->MASTER_BATCH_VERSION_REQUESTS));
 	}
 
 	return Void();
 }
 #else
 ACTOR Future<Void> provideVersions(Reference<MasterData> self) {
-	wait(provideVersionsCxx(self));
+	wait(provideVersionsCxx(self, SERVER_KNOBS->MASTER_BATCH_VERSION_REQUESTS));
 	return Void();
 }
 #endif
@@ -387,29 +434,52 @@ SWIFT_ACTOR Future<Void> serveLiveCommittedVersionSwift(Reference<MasterData> se
 }
 #endif
 
+// Answers a batch of live committed version requests from the GRV proxies with one snapshot of the live committed
+// version state. Only the version vector delta depends on the request.
+void replyToLiveCommittedVersionRequests(Reference<MasterData> self,
+                                         std::vector<GetRawCommittedVersionRequest>& batch) {
+	if (self->liveCommittedVersion.get() == invalidVersion) {
+		self->liveCommittedVersion.set(self->recoveryTransactionVersion);
+	}
+	++self->liveCommittedVersionBatches;
+
+	GetRawCommittedVersionReply reply;
+	reply.version = self->liveCommittedVersion.get();
+	reply.locked = self->databaseLocked;
+	reply.metadataVersion = self->proxyMetadataVersion;
+	reply.minKnownCommittedVersion = self->minKnownCommittedVersion;
+	for (auto& req : batch) {
+		if (req.debugID.present())
+			g_traceBatch.addEvent("TransactionDebug",
+			                      req.debugID.get().first(),
+			                      "MasterServer.serveLiveCommittedVersion.GetRawCommittedVersion");
+
+		++self->getLiveCommittedVersionRequests;
+		if (SERVER_KNOBS->ENABLE_VERSION_VECTOR) {
+			self->ssVersionVector.getDelta(req.maxVersion, reply.ssVersionVectorDelta);
+			self->versionVectorSizeOnCVReply->addMeasurement(reply.ssVersionVectorDelta.size());
+		}
+		req.reply.send(reply);
+	}
+	batch.clear();
+}
+
 ACTOR Future<Void> serveLiveCommittedVersionCxx(Reference<MasterData> self) {
+	state std::vector<GetRawCommittedVersionRequest> batch;
+
 	loop {
 		choose {
 			when(GetRawCommittedVersionRequest req = waitNext(self->myInterface.getLiveCommittedVersion.getFuture())) {
-				if (req.debugID.present())
-					g_traceBatch.addEvent("TransactionDebug",
-					                      req.debugID.get().first(),
-					                      "MasterServer.serveLiveCommittedVersion.GetRawCommittedVersion");
-
-				if (self->liveCommittedVersion.get() == invalidVersion) {
-					self->liveCommittedVersion.set(self->recoveryTransactionVersion);
-				}
-				++self->getLiveCommittedVersionRequests;
-				GetRawCommittedVersionReply reply;
-				reply.version = self->liveCommittedVersion.get();
-				reply.locked = self->databaseLocked;
-				reply.metadataVersion = self->proxyMetadataVersion;
-				reply.minKnownCommittedVersion = self->minKnownCommittedVersion;
-				if (SERVER_KNOBS->ENABLE_VERSION_VECTOR) {
-					self->ssVersionVector.getDelta(req.maxVersion, reply.ssVersionVectorDelta);
-					self->versionVectorSizeOnCVReply->addMeasurement(reply.ssVersionVectorDelta.size());
+				batch.push_back(req);
+				if (SERVER_KNOBS->MASTER_BATCH_VERSION_REQUESTS) {
+					// Reports received while yielding are not acknowledged yet, so replying after them is still
+					// causally consistent
+					wait(delay(0, TaskPriority::GetLiveCommittedVersion));
+					while (self->myInterface.getLiveCommittedVersion.getFuture().isReady()) {
+						batch.push_back(self->myInterface.getLiveCommittedVersion.getFuture().pop());
+					}
 				}
-				req.reply.send(reply);
+				replyToLiveCommittedVersionRequests(self, batch);
 			}
 			when(ReportRawCommittedVersionRequest req =
 			         waitNext(self->myInterface.reportLiveCommittedVersion.getFuture())) {
@@ -698,3 +768,76 @@ TEST_CASE("/fdbserver/MasterServer/FigureVersion/NegativeReferenceVersion") {
 	ASSERT_EQ(figureVersion(0, 2.0, -1e6, 5e5, 0.1, 1e6), 550000);
 	return Void();
 }
+
+// A commit proxy for the commit version benchmark, which keeps up to inFlight commit version requests outstanding
+ACTOR Future<Void> benchmarkCommitProxy(MasterInterface mi, UID proxyId, int inFlight, int versions) {
+	state std::deque<Future<GetCommitVersionReply>> replies;
+	state int sent = 0;
+	state uint64_t processed = 0;
+
+	while (sent < versions || !replies.empty()) {
+		if (sent < versions && replies.size() < static_cast<size_t>(inFlight)) {
+			++sent;
+			replies.push_back(
+			    mi.getCommitVersion.getReply(GetCommitVersionRequest(SpanContext(), sent, processed, proxyId)));
+			continue;
+		}
+		GetCommitVersionReply rep = wait(replies.front());
+		replies.pop_front();
+		processed = rep.requestNum;
+	}
+	return Void();
+}
+
+// Returns the seconds it took the sequencer to hand out versionsPerProxy commit versions to each of the proxies
+ACTOR Future<double> benchmarkCommitVersions(int proxies, bool batched, int inFlight, int versionsPerProxy) {
+	state MasterInterface mi;
+	state PromiseStream<Future<Void>> addActor;
+	state Reference<MasterData> self(new MasterData(makeReference<AsyncVar<ServerDBInfo>>(),
+	                                                mi,
+	                                                ServerCoordinators(),
+	                                                ClusterControllerFullInterface(),
+	                                                ""_sr,
+	                                                addActor,
+	                                                false));
+	state std::vector<Future<Void>> clients;
+	state Future<Void> provider;
+	state double start;
+
+	self->lastEpochEnd = 0;
+	self->recoveryTransactionVersion = 1;
+	for (int i = 0; i < proxies; i++) {
+		self->lastCommitProxyVersionReplies[deterministicRandom()->randomUniqueID()] = CommitProxyVersionReplies();
+	}
+
+	provider = provideVersionsCxx(self, batched);
+	start = timer_monotonic();
+	for (auto& proxy : self->lastCommitProxyVersionReplies) {
+		clients.push_back(benchmarkCommitProxy(mi, proxy.first, inFlight, versionsPerProxy));
+	}
+	wait(waitForAll(clients));
+	ASSERT_GE(self->version, proxies * versionsPerProxy);
+	return timer_monotonic() - start;
+}
+
+TEST_CASE(":/fdbserver/MasterServer/performance/commitVersions") {
+	state int versionsPerProxy = params.getInt("versionsPerProxy").orDefault(20000);
+	state int inFlight = params.getInt("inFlight").orDefault(4);
+	state int maxProxies = params.getInt("maxProxies").orDefault(64);
+	state int proxies;
+	state double unbatchedSeconds;
+	state double batchedSeconds;
+
+	printf("versionsPerProxy: %d\n", versionsPerProxy);
+	printf("inFlight: %d\n", inFlight);
+	for (proxies = 1; proxies <= maxProxies; proxies *= 2) {
+		wait(store(unbatchedSeconds, benchmarkCommitVersions(proxies, false, inFlight, versionsPerProxy)));
+		wait(store(batchedSeconds, benchmarkCommitVersions(proxies, true, inFlight, versionsPerProxy)));
+		double versions = proxies * versionsPerProxy;
+		printf("%d proxies: %.0f versions/s one at a time, %.0f versions/s batched\n",
+		       proxies,
+		       versions / unbatchedSeconds,
+		       versions / batchedSeconds);
+	}
+	return Void();
+}
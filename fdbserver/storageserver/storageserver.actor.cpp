@@ -74,6 +74,7 @@
 #include "flow/Util.h"
 #include "fdbclient/Atomic.h"
 #include "fdbclient/AuditUtils.h"
+#include "fdbclient/BTreeVersionedMap.h"
 #include "fdbclient/CommitProxyInterface.h"
 #include "fdbclient/DatabaseContext.h"
 #include "fdbclient/FDBTypes.h"
@@ -448,11 +449,12 @@ struct AddingShard : NonCopyable {
 class ShardInfo : public ReferenceCounted<ShardInfo>, NonCopyable {
 private:
 	ShardInfo(KeyRange keys, std::unique_ptr<AddingShard>&& adding, StorageServer* readWrite)
-	  : adding(std::move(adding)), readWrite(readWrite), keys(keys), shardId(0LL), desiredShardId(0LL), version(0) {}
+	  : adding(std::move(adding)), readWrite(readWrite), keys(keys), shardId(0LL), desiredShardId(0LL), version(0),
+	    lastModifiedVersion(0) {}
 	ShardInfo(KeyRange keys, std::shared_ptr<MoveInShard> moveInShard)
 	  : adding(nullptr), readWrite(nullptr), moveInShard(moveInShard), keys(keys),
 	    shardId(moveInShard->meta->destShardId()), desiredShardId(moveInShard->meta->destShardId()),
-	    version(moveInShard->meta->createVersion) {}
+	    version(moveInShard->meta->createVersion), lastModifiedVersion(0) {}
 
 	// A shard has 4 mutual exclusive states: adding, moveInShard, readWrite and notAssigned.
 	std::unique_ptr<AddingShard> adding;
@@ -464,6 +466,8 @@ private:
 	uint64_t desiredShardId;
 	std::string teamId = invalidTeamId;
 	Version version;
+	// Upper bound on the version of the latest mutation applied to the shard, for incremental backup snapshots
+	Version lastModifiedVersion;
 
 public:
 	static ShardInfo* newNotAssigned(KeyRange keys) { return new ShardInfo(keys, nullptr, nullptr); }
@@ -535,6 +539,7 @@ public:
 		}
 		this->keys = KeyRangeRef(this->keys.begin, other->range().end);
 		this->version = std::max(this->version, other->getVersion());
+		this->lastModifiedVersion = std::max(this->lastModifiedVersion, other->getLastModifiedVersion());
 		return true;
 	}
 
@@ -553,9 +558,11 @@ public:
 	AddingShard* getAddingShard() const { return adding.get(); }
 	std::shared_ptr<MoveInShard> getMoveInShard() const { return moveInShard; }
 	Version getVersion() const { return version; }
+	Version getLastModifiedVersion() const { return lastModifiedVersion; }
 	std::string getTeamId() const { return teamId; }
 
 	void setChangeCounter(uint64_t shardChangeCounter) { changeCounter = shardChangeCounter; }
+	void setLastModifiedVersion(Version v) { lastModifiedVersion = v; }
 	void setShardId(uint64_t id) { shardId = id; }
 	void setDesiredShardId(uint64_t id) { desiredShardId = id; }
 
@@ -726,6 +733,8 @@ struct UpdateEagerReadInfo {
 
 	std::vector<std::pair<KeyRef, int>> keys;
 	std::vector<Optional<Value>> value;
+	// valueInMemory[i] is true if doEagerReads() skipped keys[i] because its latest value is in versioned data
+	std::vector<bool> valueInMemory;
 
 	Arena arena;
 	bool enableClearRangeEagerReads;
@@ -785,6 +794,8 @@ struct UpdateEagerReadInfo {
 		                         }) -
 		        keys.begin();
 		ASSERT(i < keys.size() && keys[i].first == key);
+		// Skipped keys stay in versioned data until the batch is applied, so they are never looked up here
+		ASSERT(!valueInMemory[i]);
 		return value[i];
 	}
 
@@ -847,8 +858,47 @@ private:
 	int ongoingTasks = 0;
 };
 
+// Sizes durability batches in updateStorage when STORAGE_ADAPTIVE_COMMIT_BATCHING is enabled. After each engine commit
+// it smooths the observed commit throughput and picks the next batch so that a commit is expected to take at most half
+// of STORAGE_ADAPTIVE_COMMIT_TARGET_LAG, and the delay before the next commit from the lag headroom left: a lightly
+// loaded server waits longer and commits fewer, larger batches, while a server behind its target commits immediately.
+struct StorageCommitBatchController {
+	int64_t commitBytes;
+	double commitInterval;
+	double smoothedBytesPerSecond = 0;
+	double smoothedCommitDuration = 0;
+	double lastDurabilityLag = 0;
+
+	StorageCommitBatchController()
+	  : commitBytes(SERVER_KNOBS->STORAGE_COMMIT_BYTES), commitInterval(SERVER_KNOBS->STORAGE_COMMIT_INTERVAL) {}
+
+	// bytes were committed in commitDuration seconds, leaving durabilityLag seconds of versions beyond the MVCC
+	// window not yet durable.
+	void update(int64_t bytes, double commitDuration, double durabilityLag) {
+		const double alpha = SERVER_KNOBS->STORAGE_ADAPTIVE_COMMIT_SMOOTHING;
+		const double target = SERVER_KNOBS->STORAGE_ADAPTIVE_COMMIT_TARGET_LAG;
+		lastDurabilityLag = durabilityLag;
+		smoothedCommitDuration = alpha * commitDuration + (1 - alpha) * smoothedCommitDuration;
+		// Tiny commits are dominated by fixed overhead and say little about engine throughput
+		if (bytes >= SERVER_KNOBS->STORAGE_ADAPTIVE_COMMIT_MIN_BYTES && commitDuration > 0) {
+			const double rate = bytes / commitDuration;
+			smoothedBytesPerSecond =
+			    smoothedBytesPerSecond == 0 ? rate : alpha * rate + (1 - alpha) * smoothedBytesPerSecond;
+		}
+		if (smoothedBytesPerSecond > 0) {
+			commitBytes = std::clamp<int64_t>(smoothedBytesPerSecond * target / 2,
+			                                  SERVER_KNOBS->STORAGE_ADAPTIVE_COMMIT_MIN_BYTES,
+			                                  SERVER_KNOBS->STORAGE_ADAPTIVE_COMMIT_MAX_BYTES);
+		}
+		commitInterval = std::clamp((target - durabilityLag - smoothedCommitDuration) / 2,
+		                            0.0,
+		                            SERVER_KNOBS->STORAGE_ADAPTIVE_COMMIT_MAX_INTERVAL);
+	}
+};
+
 struct StorageServer : public IStorageMetricsService {
-	using VersionedData = VersionedMap<KeyRef, ValueOrClearToRef>;
+	// A PTree VersionedMap, or a BTreeVersionedMap if STORAGE_SERVER_BTREE_VERSIONED_MAP is set
+	using VersionedData = SelectableVersionedMap<KeyRef, ValueOrClearToRef>;
 
 private:
 	// versionedData contains sets and clears.
@@ -1324,6 +1374,8 @@ public:
 		Counter kvGetBytes;
 		// The number of keys read from storage engine by eagerReads.
 		Counter eagerReadsKeys;
+		// The count of atomic op eager reads not sent to the storage engine because the key was in versioned data
+		Counter eagerReadsSkipped;
 		// The count of readValue operation to the storage engine.
 		Counter kvGets;
 		// The count of readValue operation to the storage engine.
@@ -1344,6 +1396,8 @@ public:
 		// If set is within a range of clear, the clear is split. It's tracking the number of splits, the split could be
 		// expensive.
 		Counter pTreeClearSplits;
+		// Bytes returned by range streams served in export mode.
+		Counter exportStreamBytes;
 
 		ReadLatencySamples readLatencySamples;
 		std::unique_ptr<LatencySample> updateLatencySample;
@@ -1372,12 +1426,14 @@ public:
 		    fetchesFromLogs("FetchesFromLogs", cc), quickGetValueHit("QuickGetValueHit", cc),
 		    quickGetValueMiss("QuickGetValueMiss", cc), quickGetKeyValuesHit("QuickGetKeyValuesHit", cc),
 		    quickGetKeyValuesMiss("QuickGetKeyValuesMiss", cc), kvScanBytes("KVScanBytes", cc),
-		    kvGetBytes("KVGetBytes", cc), eagerReadsKeys("EagerReadsKeys", cc), kvGets("KVGets", cc),
+		    kvGetBytes("KVGetBytes", cc), eagerReadsKeys("EagerReadsKeys", cc),
+		    eagerReadsSkipped("EagerReadsSkipped", cc), kvGets("KVGets", cc),
 		    kvScans("KVScans", cc), kvCommits("KVCommits", cc), changeFeedDiskReads("ChangeFeedDiskReads", cc),
 		    getMappedRangeBytesQueried("GetMappedRangeBytesQueried", cc),
 		    finishedGetMappedRangeQueries("FinishedGetMappedRangeQueries", cc),
 		    finishedGetMappedRangeSecondaryQueries("FinishedGetMappedRangeSecondaryQueries", cc),
 		    pTreeSets("PTreeSets", cc), pTreeClears("PTreeClears", cc), pTreeClearSplits("PTreeClearSplits", cc),
+		    exportStreamBytes("ExportStreamBytes", cc),
 		    changeServerKeysAssigned("ChangeServerKeysAssigned", cc),
 		    changeServerKeysUnassigned("ChangeServerKeysUnassigned", cc),
 		    kvClearRangesInFetchKeys("KvClearRangesInFetchKeys", cc), readLatencySamples(self->thisServerID),
@@ -1435,10 +1491,12 @@ public:
 
 	std::shared_ptr<SSBulkLoadMetrics> bulkLoadMetrics = nullptr;
 
+	StorageCommitBatchController commitBatchController;
+
 	StorageServer(IKeyValueStore* storage,
 	              Reference<AsyncVar<ServerDBInfo> const> const& db,
 	              StorageServerInterface const& ssi)
-	  : shardAware(false), locality(ssi.locality),
+	  : versionedData(SERVER_KNOBS->STORAGE_SERVER_BTREE_VERSIONED_MAP), shardAware(false), locality(ssi.locality),
 	    tlogCursorReadsLatencyHistogram(Histogram::getHistogram(STORAGESERVER_HISTOGRAM_GROUP,
 	                                                            TLOG_CURSOR_READS_LATENCY_HISTOGRAM,
 	                                                            Histogram::Unit::milliseconds)),
@@ -1535,6 +1593,9 @@ public:
 	void addShard(ShardInfo* newShard) {
 		ASSERT(!newShard->range().empty());
 		newShard->setChangeCounter(++shardChangeCounter);
+		// Nothing is known about modifications made before the shard was assigned here, so start from the version
+		// being applied, which bounds all of them.
+		newShard->setLastModifiedVersion(std::max(version.get(), data().getLatestVersion()));
 		// TraceEvent("AddShard", this->thisServerID).detail("KeyBegin", newShard->keys.begin).detail("KeyEnd", newShard->keys.end).detail("State",newShard->isReadable() ? "Readable" : newShard->notAssigned() ? "NotAssigned" : "Adding").detail("Version", this->version.get());
 		/*auto affected = shards.getAffectedRangesAfterInsertion( newShard->keys, Reference<ShardInfo>() );
 		for(auto i = affected.begin(); i != affected.end(); ++i)
@@ -2307,7 +2368,7 @@ ACTOR Future<Version> watchWaitForValueChange(StorageServer* data, SpanContext p
 		                      metadata->debugID.get().first(),
 		                      "watchValueSendReply.AfterVersion"); //.detail("TaskID", g_network->getCurrentTask());
 
-	state Version minVersion = data->data().latestVersion;
+	state Version minVersion = data->data().getLatestVersion();
 	state Future<Void> watchFuture = data->watches.onChange(metadata->key);
 	state ReadOptions options;
 	loop {
@@ -2316,7 +2377,7 @@ ACTOR Future<Version> watchWaitForValueChange(StorageServer* data, SpanContext p
 			state Version latest = data->version.get();
 			options.debugID = metadata->debugID;
 
-			CODE_PROBE(latest >= minVersion && latest < data->data().latestVersion,
+			CODE_PROBE(latest >= minVersion && latest < data->data().getLatestVersion(),
 			           "Starting watch loop with latestVersion > data->version",
 			           probe::decoration::rare);
 			GetValueRequest getReq(span.context, metadata->key, latest, metadata->tags, options, VersionVector());
@@ -2402,7 +2463,7 @@ ACTOR Future<Version> watchWaitForValueChange(StorageServer* data, SpanContext p
 
 		watchFuture = data->watches.onChange(metadata->key);
 
-		wait(data->version.whenAtLeast(data->data().latestVersion));
+		wait(data->version.whenAtLeast(data->data().getLatestVersion()));
 	}
 }
 
@@ -2466,6 +2527,28 @@ ACTOR Future<Void> watchValueSendReply(StorageServer* data,
 	}
 }
 
+// Reports, once every mutation up to req.version has been applied, the last modified version of each shard intersecting
+// req.keys. Backup uses it to tell which parts of the previous snapshot can be kept.
+Future<Void> getRangeModifiedVersionsQ(StorageServer* self, RangeModifiedVersionsRequest req) {
+	co_await self->version.whenAtLeast(req.version);
+
+	try {
+		RangeModifiedVersionsReply reply;
+		for (auto& s : self->shards.intersectingRanges(req.keys)) {
+			if (!s.value()->isReadable()) {
+				throw wrong_shard_server();
+			}
+			reply.shards.emplace_back(s.range() & req.keys, s.value()->getLastModifiedVersion());
+		}
+		req.reply.send(reply);
+	} catch (Error& e) {
+		if (!canReplyWith(e)) {
+			throw;
+		}
+		self->sendErrorWithPenalty(req.reply, e, self->getPenalty());
+	}
+}
+
 // Finds a checkpoint.
 Future<Void> getCheckpointQ(StorageServer* self, GetCheckpointRequest req) {
 	// Wait until the desired version is durable.
@@ -5074,20 +5157,18 @@ ACTOR Future<Void> auditStorageShardReplicaQ(StorageServer* data, AuditStorageRe
 	return Void();
 }
 
-ACTOR Future<Void> getRangeDataToDump(StorageServer* data,
-                                      KeyRange range,
-                                      Version version,
-                                      std::shared_ptr<RangeDumpRawData> output) {
-	state std::map<Key, Value> kvsToDump;
-	output->arena = Arena();
-	output->kvs.clear();
-	output->sampled.clear();
-	state std::map<Key, Value> sample;
-	output->kvsBytes = 0;
+// Stream the data of range at version to fileWriter, starting from range.begin, until the batch reaches
+// SS_BULKDUMP_BATCH_BYTES or any read error presents. Keys arrive in order, so each reply is appended to the files
+// directly and the memory used does not grow with the batch size.
+// Return the last key covered by the batch, which is range.end if the whole range is dumped.
+ACTOR Future<Key> getRangeDataToDump(StorageServer* data,
+                                     KeyRange range,
+                                     Version version,
+                                     std::shared_ptr<BulkDumpFileWriter> fileWriter) {
 	state Key beginKey = range.begin;
-	output->lastKey = KeyRef(output->arena, range.begin);
+	state Key lastKey = range.begin;
 	state bool immediateError = true;
-	// Accumulate data read from local storage to output->kvs and make sampling until any error presents
+	// Stream data read from local storage to the files until any error presents
 	loop {
 		// Read data and stop for any error
 		state ErrorOr<GetKeyValuesReply> rep;
@@ -5117,41 +5198,35 @@ ACTOR Future<Void> getRangeDataToDump(StorageServer* data,
 		// immediateError is used in case the read is failed at the first range
 		immediateError = false;
 
-		// Given the data, create KVS and sample. Stop if the accumulated data size is too large.
+		// Append the data to the data file and the sample file. Stop if the accumulated data size is too large.
+		const KeyValueRef* lastAppended = nullptr;
 		for (const auto& kv : rep.get().data) { // TODO(BulkDump): directly read from special key space.
-			Key key = KeyRef(output->arena, kv.key);
-			Value value = ValueRef(output->arena, kv.value);
-			output->lastKey = key;
-			auto res = output->kvs.insert({ key, value });
-			ASSERT(res.second);
-			ByteSampleInfo sampleInfo = isKeyValueInSample(KeyValueRef(kv.key, kv.value));
-			if (sampleInfo.inSample) {
-				Value sampleValue = BinaryWriter::toValue(sampleInfo.sampledSize, Unversioned());
-				auto resSample = output->sampled.insert({ key, ValueRef(output->arena, sampleValue) });
-				ASSERT(resSample.second);
-			}
-			output->kvsBytes = output->kvsBytes + kv.expectedSize();
-			if (output->kvsBytes >= SERVER_KNOBS->SS_BULKDUMP_BATCH_BYTES) {
+			fileWriter->append(kv);
+			lastAppended = &kv;
+			if (fileWriter->getBytes() >= SERVER_KNOBS->SS_BULKDUMP_BATCH_BYTES) {
 				break;
 			}
 		}
+		if (lastAppended != nullptr) {
+			lastKey = lastAppended->key;
+		}
 
 		// Stop if no more data or having too large bytes
-		if (output->kvsBytes >= SERVER_KNOBS->SS_BULKDUMP_BATCH_BYTES) {
+		if (fileWriter->getBytes() >= SERVER_KNOBS->SS_BULKDUMP_BATCH_BYTES) {
 			break;
 		} else if (!rep.get().more) {
-			output->lastKey = KeyRef(output->arena, range.end); // Use the range end as the output->lastKey
+			lastKey = range.end; // Use the range end as the lastKey
 			break;
 		}
 
 		// Go to the next round
-		beginKey = keyAfter(output->lastKey);
+		beginKey = keyAfter(lastKey);
 	}
 
 	if (immediateError) {
 		throw retry();
 	}
-	return Void();
+	return lastKey;
 }
 
 // The SS actor handling bulk dump task sent from DD.
@@ -5184,7 +5259,8 @@ ACTOR Future<Void> bulkDumpQ(StorageServer* data, BulkDumpRequest req) {
 	state int retryCount = 0;
 	state uint64_t batchNum = 0;
 	state Version versionToDump;
-	state std::shared_ptr<RangeDumpRawData> rangeDumpRawData;
+	state std::shared_ptr<BulkDumpFileWriter> fileWriter;
+	state Key lastKey;
 	state UID jobId = req.bulkDumpState.getJobId();
 	state std::string rootFolderLocal = data->bulkDumpFolder;
 	state std::string rootFolderRemote = req.bulkDumpState.getJobRoot();
@@ -5196,9 +5272,6 @@ ACTOR Future<Void> bulkDumpQ(StorageServer* data, BulkDumpRequest req) {
 
 	loop {
 		try {
-			// Reset data buffer
-			rangeDumpRawData = std::make_shared<RangeDumpRawData>();
-
 			// Clear local files
 			clearFileFolder(abspath(joinPath(rootFolderLocal, taskFolder)));
 
@@ -5213,10 +5286,6 @@ ACTOR Future<Void> bulkDumpQ(StorageServer* data, BulkDumpRequest req) {
 			tr.reset();
 			wait(store(versionToDump, tr.getReadVersion()));
 
-			// Read data
-			// TODO(BulkDump): Read data from other servers at the versionToDump as much as possible
-			wait(getRangeDataToDump(data, rangeToDump, versionToDump, /*output=*/rangeDumpRawData));
-
 			// Generate local file paths and remote file paths
 			// The data in KVStore is dumped to the local folder at first and then
 			// the local files are uploaded to the remote folder
@@ -5231,6 +5300,12 @@ ACTOR Future<Void> bulkDumpQ(StorageServer* data, BulkDumpRequest req) {
 			state BulkLoadFileSet localFileSetSetting = resFileSets.first;
 			state BulkLoadFileSet remoteFileSetSetting = resFileSets.second;
 
+			// Read data and stream it to the local SST files
+			// TODO(BulkDump): Read data from other servers at the versionToDump as much as possible
+			fileWriter = std::make_shared<BulkDumpFileWriter>(data->thisServerID, localFileSetSetting);
+			Key batchLastKey = wait(getRangeDataToDump(data, rangeToDump, versionToDump, fileWriter));
+			lastKey = batchLastKey;
+
 			// Generate byte sampling setting
 			BulkLoadByteSampleSetting byteSampleSetting(0,
 			                                            "hashlittle2", // use function name to represent the method
@@ -5238,19 +5313,19 @@ ACTOR Future<Void> bulkDumpQ(StorageServer* data, BulkDumpRequest req) {
 			                                            SERVER_KNOBS->BYTE_SAMPLING_OVERHEAD,
 			                                            SERVER_KNOBS->MIN_BYTE_SAMPLING_PROBABILITY);
 
-			// Write to SST file
-			state KeyRange dataRange = rangeToDump & KeyRangeRef(rangeBegin, keyAfter(rangeDumpRawData->lastKey));
+			// Close SST files and write the manifest file
+			state KeyRange dataRange = rangeToDump & KeyRangeRef(rangeBegin, keyAfter(lastKey));
 			state BulkLoadManifest manifest =
 			    wait(dumpDataFileToLocalDirectory(data->thisServerID,
-			                                      rangeDumpRawData,
+			                                      fileWriter,
 			                                      localFileSetSetting,
 			                                      remoteFileSetSetting,
 			                                      byteSampleSetting,
 			                                      versionToDump,
-			                                      dataRange, // the actual range of the rangeDumpRawData.kvs
+			                                      dataRange, // the actual range of the dumped data
 			                                      dumpType,
 			                                      transportMethod));
-			readBytes = readBytes + rangeDumpRawData->kvsBytes;
+			readBytes = readBytes + fileWriter->getBytes();
 			TraceEvent(bulkLoadVerboseEventSev(), "SSBulkDumpDataFileGenerated", data->thisServerID)
 			    .detail("TaskID", req.bulkDumpState.getTaskId())
 			    .detail("TaskRange", req.bulkDumpState.getRange())
@@ -5260,8 +5335,8 @@ ACTOR Future<Void> bulkDumpQ(StorageServer* data, BulkDumpRequest req) {
 			    .detail("DataRange", dataRange)
 			    .detail("RootFolderLocal", rootFolderLocal)
 			    .detail("RelativeFolder", relativeFolder)
-			    .detail("DataKeyCount", rangeDumpRawData->kvs.size())
-			    .detail("DataBytes", rangeDumpRawData->kvsBytes)
+			    .detail("DataKeyCount", fileWriter->getKeyCount())
+			    .detail("DataBytes", fileWriter->getBytes())
 			    .detail("BatchNum", batchNum)
 			    .detail("RemoteFileSet", manifest.getFileSet().toString());
 
@@ -5286,7 +5361,7 @@ ACTOR Future<Void> bulkDumpQ(StorageServer* data, BulkDumpRequest req) {
 			}
 
 			// Move to the next range
-			rangeBegin = keyAfter(rangeDumpRawData->lastKey);
+			rangeBegin = keyAfter(lastKey);
 			if (rangeBegin >= rangeEnd || batchNum >= SERVER_KNOBS->SS_BULKDUMP_BATCH_COUNT_MAX_PER_REQUEST) {
 				req.reply.send(req.bulkDumpState);
 				break;
@@ -5729,6 +5804,91 @@ ACTOR Future<Void> getMappedKeyValuesQ(StorageServer* data, GetMappedKeyValuesRe
 	return Void();
 }
 
+// Reads one block of a range stream served in export mode, holding the read lock only for the duration of the read.
+ACTOR Future<GetKeyValuesReply> readExportBlock(StorageServer* data,
+                                                Version version,
+                                                KeyRange range,
+                                                int limit,
+                                                SpanContext parentSpan,
+                                                Optional<ReadOptions> options) {
+	state PriorityMultiLock::Lock readLock = wait(data->getReadLock(options));
+	if (version < data->oldestVersion.get()) {
+		throw transaction_too_old();
+	}
+	state int byteLimit = SERVER_KNOBS->RANGESTREAM_EXPORT_READ_BYTES;
+	GetKeyValuesReply rep = wait(readRange(data, version, range, limit, &byteLimit, parentSpan, options));
+	return rep;
+}
+
+// Serves a range stream whose client has declared an in-flight byte window. Blocks of RANGESTREAM_EXPORT_READ_BYTES are
+// read from the engine, and the read of the next block is issued as soon as the previous one completes, so that it
+// overlaps with waiting for the client to acknowledge. Replies are pushed until the window is full. The request's row
+// limit covers the whole stream; once it is used up the stream ends after a reply with more set, and the client
+// continues with a new request.
+ACTOR Future<Void> exportKeyValuesStream(StorageServer* data,
+                                         GetKeyValuesStreamRequest* req,
+                                         Version version,
+                                         Key begin,
+                                         Key end,
+                                         uint64_t changeCounter,
+                                         SpanContext parentSpan) {
+	state int limit = req->limit;
+	state Future<GetKeyValuesReply> nextBlock =
+	    readExportBlock(data, version, KeyRangeRef(begin, end), limit, parentSpan, req->options);
+
+	req->reply.setByteLimit(std::min(req->exportWindowBytes, SERVER_KNOBS->RANGESTREAM_EXPORT_MAX_WINDOW_BYTES));
+	loop {
+		GetKeyValuesReply block = wait(nextBlock);
+		state GetKeyValuesStreamReply r(block);
+		data->checkChangeCounter(
+		    changeCounter,
+		    KeyRangeRef(std::min<KeyRef>(begin, std::min<KeyRef>(req->begin.getKey(), req->end.getKey())),
+		                std::max<KeyRef>(end, std::max<KeyRef>(req->begin.getKey(), req->end.getKey()))));
+		if (EXPENSIVE_VALIDATION) {
+			for (int i = 0; i < r.data.size(); i++) {
+				ASSERT(r.data[i].key >= begin && r.data[i].key < end);
+			}
+			ASSERT(r.data.size() <= std::abs(limit));
+		}
+
+		state int64_t totalByteSize = 0;
+		for (int i = 0; i < r.data.size(); i++) {
+			totalByteSize += r.data[i].expectedSize();
+		}
+		if (totalByteSize > 0 && SERVER_KNOBS->READ_SAMPLING_ENABLED) {
+			int64_t bytesReadPerKSecond = std::max(totalByteSize, SERVER_KNOBS->EMPTY_READ_PENALTY) / 2;
+			data->metrics.notifyBytesReadPerKSecond(r.data[0].key, bytesReadPerKSecond);
+			data->metrics.notifyBytesReadPerKSecond(r.data.back().key, bytesReadPerKSecond);
+		}
+
+		limit += req->limit >= 0 ? -r.data.size() : r.data.size();
+		if (r.more && limit != 0) {
+			ASSERT(r.data.size());
+			if (req->limit >= 0) {
+				begin = keyAfter(r.data.back().key);
+			} else {
+				end = r.data.back().key;
+			}
+			nextBlock = readExportBlock(data, version, KeyRangeRef(begin, end), limit, parentSpan, req->options);
+		}
+
+		wait(req->reply.onReady());
+		req->reply.send(r);
+
+		data->counters.exportStreamBytes += totalByteSize;
+		data->counters.rowsQueried += r.data.size();
+		if (r.data.size() == 0) {
+			++data->counters.emptyQueries;
+		}
+		data->transactionTagCounter.addRequest(req->tags, totalByteSize);
+		if (!r.more || limit == 0) {
+			CODE_PROBE(r.more, "Export range stream reached its row limit");
+			req->reply.sendError(end_of_stream());
+			return Void();
+		}
+	}
+}
+
 ACTOR Future<Void> getKeyValuesStreamQ(StorageServer* data, GetKeyValuesStreamRequest req)
 // Throws a wrong_shard_server if the keys in the request or result depend on data outside this server OR if a large
 // selector offset prevents all data from being read in one range read
@@ -5823,6 +5983,8 @@ ACTOR Future<Void> getKeyValuesStreamQ(StorageServer* data, GetKeyValuesStreamRe
 			                                     std::max<KeyRef>(req.begin.getKey(), req.end.getKey())));
 			req.reply.send(none);
 			req.reply.sendError(end_of_stream());
+		} else if (req.exportWindowBytes > 0) {
+			wait(exportKeyValuesStream(data, &req, version, begin, end, changeCounter, span.context));
 		} else {
 			loop {
 				wait(req.reply.onReady());
@@ -6043,6 +6205,14 @@ void getQueuingMetrics(StorageServer* self, StorageQueuingMetricsRequest const&
 #pragma region Updates
 #endif
 
+// Returns true if the latest value of key is determined by versioned data alone, i.e. it was set or cleared by a version
+// that is not yet durable. convertAtomicOp() then never uses the eager read result for key. This holds until the batch
+// is applied because update() holds durableVersionLock, so changeDurableVersion() cannot remove the entry meanwhile.
+static bool latestValueInVersionedData(StorageServer* data, KeyRef key) {
+	auto i = data->data().atLatest().lastLessOrEqual(key);
+	return i && ((i->isValue() && i.key() == key) || (i->isClearTo() && i->getEndKey() > key));
+}
+
 ACTOR Future<Void> doEagerReads(StorageServer* data, UpdateEagerReadInfo* eager) {
 	eager->finishKeyBegin();
 	state ReadOptions options;
@@ -6062,8 +6232,19 @@ ACTOR Future<Void> doEagerReads(StorageServer* data, UpdateEagerReadInfo* eager)
 	}
 
 	std::vector<Future<Optional<Value>>> value(eager->keys.size());
-	for (int i = 0; i < value.size(); i++)
+	eager->valueInMemory.assign(eager->keys.size(), false);
+	for (int i = 0; i < value.size(); i++) {
+		// Hot keys (counters, versionstamped indexes) usually get atomic ops at every version, and only the first
+		// of them since the key became durable needs to read the engine.
+		if (SERVER_KNOBS->STORAGE_EAGER_READS_SKIP_IN_MEMORY_KEYS &&
+		    latestValueInVersionedData(data, eager->keys[i].first)) {
+			eager->valueInMemory[i] = true;
+			value[i] = Optional<Value>();
+			++data->counters.eagerReadsSkipped;
+			continue;
+		}
 		value[i] = data->storage.readValuePrefix(eager->keys[i].first, eager->keys[i].second, options);
+	}
 
 	state Future<std::vector<Optional<Value>>> futureValues = getAll(value);
 	std::vector<Optional<Value>> optionalValues = wait(futureValues);
@@ -6555,7 +6736,8 @@ Future<Void> bulkLoadFetchKeyValueFileToLoad(StorageServer* data,
                                              BulkLoadTaskState bulkLoadTaskState,
                                              std::shared_ptr<BulkLoadFileSetKeyMap> localFileSets) {
 	localFileSets->clear();
-	ASSERT(bulkLoadTaskState.getLoadType() == BulkLoadType::SST);
+	ASSERT(bulkLoadTaskState.getLoadType() == BulkLoadType::SST ||
+	       bulkLoadTaskState.getLoadType() == BulkLoadType::RangeFile);
 	TraceEvent(bulkLoadVerboseEventSev(), "SSBulkLoadTaskFetchSSTFile", data->thisServerID)
 	    .detail("JobID", bulkLoadTaskState.getJobId().toString())
 	    .detail("TaskID", bulkLoadTaskState.getTaskId().toString())
@@ -6568,8 +6750,13 @@ Future<Void> bulkLoadFetchKeyValueFileToLoad(StorageServer* data,
 		// Note that manifest.range may contain more than the task range. We will cut-off data outside the task
 		// range when we read the kvs.
 	}
-	co_await bulkLoadDownloadTaskFileSets(
-	    bulkLoadTaskState.getTransportMethod(), fromRemoteFileSets, localFileSets, dir, data->thisServerID);
+	if (bulkLoadTaskState.getLoadType() == BulkLoadType::RangeFile) {
+		co_await bulkLoadDownloadRangeFileSets(
+		    bulkLoadTaskState.getTransportMethod(), fromRemoteFileSets, localFileSets, dir, data->thisServerID);
+	} else {
+		co_await bulkLoadDownloadTaskFileSets(
+		    bulkLoadTaskState.getTransportMethod(), fromRemoteFileSets, localFileSets, dir, data->thisServerID);
+	}
 	// Do not need byte sampling locally in fetchKeys
 	const double duration = now() - fetchStartTime;
 	const int64_t totalBytes = bulkLoadTaskState.getTotalBytes();
@@ -7602,7 +7789,8 @@ Future<Void> bulkLoadFetchShardFileToLoad(StorageServer* data,
                                           MoveInShard* moveInShard,
                                           std::string localRoot,
                                           BulkLoadTaskState bulkLoadTaskState) {
-	ASSERT(bulkLoadTaskState.getLoadType() == BulkLoadType::SST);
+	ASSERT(bulkLoadTaskState.getLoadType() == BulkLoadType::SST ||
+	       bulkLoadTaskState.getLoadType() == BulkLoadType::RangeFile);
 	TraceEvent(bulkLoadVerboseEventSev(), "SSBulkLoadTaskFetchShardFile", data->thisServerID)
 	    .detail("JobID", bulkLoadTaskState.getJobId().toString())
 	    .detail("TaskID", bulkLoadTaskState.getTaskId().toString())
@@ -7631,6 +7819,11 @@ Future<Void> bulkLoadFetchShardFileToLoad(StorageServer* data,
 	// Download data file and byte sample file from fromRemoteFileSet to toLocalFileSet
 	BulkLoadFileSet toLocalFileSet = co_await bulkLoadDownloadTaskFileSet(
 	    bulkLoadTaskState.getTransportMethod(), fromRemoteFileSet, localRoot, data->thisServerID);
+	if (bulkLoadTaskState.getLoadType() == BulkLoadType::RangeFile && toLocalFileSet.hasDataFile()) {
+		// The SST written from the range file is sampled with the current cluster setting
+		KeyRange loadRange = bulkLoadTaskState.getRange() & bulkLoadTaskState.getManifests()[0].getRange();
+		toLocalFileSet = co_await bulkLoadConvertRangeFileToSST(toLocalFileSet, loadRange, data->thisServerID);
+	}
 	TraceEvent(bulkLoadVerboseEventSev(), "SSBulkLoadTaskFetchShardSSTFileFetched", data->thisServerID)
 	    .detail("JobID", bulkLoadTaskState.getJobId().toString())
 	    .detail("TaskID", bulkLoadTaskState.getTaskId().toString())
@@ -8433,6 +8626,7 @@ ShardInfo* ShardInfo::newShard(StorageServer* data, const StorageServerShard& sh
 void ShardInfo::addMutation(Version version, bool fromFetch, MutationRef const& mutation) {
 	ASSERT((void*)this);
 	ASSERT(keys.contains(mutation.param1));
+	lastModifiedVersion = std::max(lastModifiedVersion, version);
 	if (adding) {
 		adding->addMutation(version, fromFetch, mutation);
 	} else if (moveInShard) {
@@ -10231,7 +10425,10 @@ ACTOR Future<Void> updateStorage(StorageServer* data) {
 		state Version startOldestVersion = data->storageVersion();
 		state Version newOldestVersion = data->storageVersion();
 		state Version desiredVersion = data->desiredOldestVersion.get();
-		state int64_t bytesLeft = SERVER_KNOBS->STORAGE_COMMIT_BYTES;
+		state int64_t commitBytesLimit = SERVER_KNOBS->STORAGE_ADAPTIVE_COMMIT_BATCHING
+		                                     ? data->commitBatchController.commitBytes
+		                                     : SERVER_KNOBS->STORAGE_COMMIT_BYTES;
+		state int64_t bytesLeft = commitBytesLimit;
 		state int64_t clearRangesLeft = (data->storage.getKeyValueStoreType() == KeyValueStoreType::SSD_ROCKSDB_V1 ||
 		                                 data->storage.getKeyValueStoreType() == KeyValueStoreType::SSD_SHARDED_ROCKSDB)
 		                                    ? (SERVER_KNOBS->ROCKSDB_CLEARRANGES_LIMIT_PER_COMMIT > 0
@@ -10340,7 +10537,7 @@ ACTOR Future<Void> updateStorage(StorageServer* data) {
 				break;
 		}
 
-		recentCommitStats.back().mutationBytes = SERVER_KNOBS->STORAGE_COMMIT_BYTES - bytesLeft;
+		recentCommitStats.back().mutationBytes = commitBytesLimit - bytesLeft;
 		recentCommitStats.back().clearRangesLeft = clearRangesLeft;
 		recentCommitStats.back().beforeStorageUpdates = beforeStorageUpdates;
 
@@ -10420,8 +10617,11 @@ ACTOR Future<Void> updateStorage(StorageServer* data) {
 		recentCommitStats.back().seqId = data->counters.kvCommits.getValue();
 
 		// If the mutation bytes budget was not fully used then wait some time before the next commit
-		durableDelay =
-		    (bytesLeft > 0) ? delay(SERVER_KNOBS->STORAGE_COMMIT_INTERVAL, TaskPriority::UpdateStorage) : Void();
+		durableDelay = (bytesLeft > 0) ? delay(SERVER_KNOBS->STORAGE_ADAPTIVE_COMMIT_BATCHING
+		                                           ? data->commitBatchController.commitInterval
+		                                           : SERVER_KNOBS->STORAGE_COMMIT_INTERVAL,
+		                                       TaskPriority::UpdateStorage)
+		                               : Void();
 
 		recentCommitStats.back().whenCommit = now();
 		try {
@@ -10433,7 +10633,7 @@ ACTOR Future<Void> updateStorage(StorageServer* data) {
 					when(wait(delay(60.0))) {
 						TraceEvent(SevWarn, "CommitTooLong", data->thisServerID)
 						    .detail("FetchBytes", data->fetchKeysTotalCommitBytes)
-						    .detail("CommitBytes", SERVER_KNOBS->STORAGE_COMMIT_BYTES - bytesLeft)
+						    .detail("CommitBytes", commitBytesLimit - bytesLeft)
 						    .detail("ClearRangesLeft", clearRangesLeft);
 
 						if (data->storage.getKeyValueStoreType() == KeyValueStoreType::SSD_SHARDED_ROCKSDB &&
@@ -10460,6 +10660,13 @@ ACTOR Future<Void> updateStorage(StorageServer* data) {
 		}
 		recentCommitStats.back().commitDuration = now() - recentCommitStats.back().whenCommit;
 		recentCommitStats.back().duration = now() - beforeStorageCommit;
+		if (SERVER_KNOBS->STORAGE_ADAPTIVE_COMMIT_BATCHING) {
+			data->commitBatchController.update(
+			    recentCommitStats.back().mutationBytes + recentCommitStats.back().fetchKeyBytes,
+			    recentCommitStats.back().commitDuration,
+			    std::max<Version>(0, data->desiredOldestVersion.get() - newOldestVersion) /
+			        (double)SERVER_KNOBS->VERSIONS_PER_SECOND);
+		}
 
 		if (SERVER_KNOBS->LOGGING_COMPLETE_STORAGE_COMMIT_PROBABILITY > 0 &&
 		    deterministicRandom()->random01() < SERVER_KNOBS->LOGGING_COMPLETE_STORAGE_COMMIT_PROBABILITY) {
@@ -11450,6 +11657,14 @@ Future<Void> metricsCore(StorageServer* self, StorageServerInterface ssi) {
 		    te.detail("KvstoreBytesAvailable", sb.available);
 		    te.detail("KvstoreBytesTotal", sb.total);
 		    te.detail("KvstoreBytesTemp", sb.temp);
+		    if (SERVER_KNOBS->STORAGE_ADAPTIVE_COMMIT_BATCHING) {
+			    const StorageCommitBatchController& c = self->commitBatchController;
+			    te.detail("CommitBatchBytes", c.commitBytes);
+			    te.detail("CommitBatchInterval", c.commitInterval);
+			    te.detail("CommitBytesPerSecond", c.smoothedBytesPerSecond);
+			    te.detail("CommitDurationSmoothed", c.smoothedCommitDuration);
+			    te.detail("CommitDurabilityLag", c.lastDurabilityLag);
+		    }
 		    if (self->isTss()) {
 			    te.detail("TSSPairID", self->tssPairID);
 			    te.detail("TSSJointID",
@@ -12067,6 +12282,9 @@ ACTOR Future<Void> storageServerCore(StorageServer* self, StorageServerInterface
 
 				req.reply.send(reply);
 			}
+			when(RangeModifiedVersionsRequest req = waitNext(ssi.getRangeModifiedVersions.getFuture())) {
+				self->actors.add(getRangeModifiedVersionsQ(self, req));
+			}
 			when(GetStorageCheckSumRequest req = waitNext(ssi.getCheckSum.getFuture())) {
 				TraceEvent(SevError, "GetStorageCheckSumHasNotImplemented", ssi.id());
 				req.reply.sendError(not_implemented());
@@ -12614,7 +12832,7 @@ Possibilities:
 void versionedMapTest() {
 	VersionedMap<int, int> vm;
 
-	printf("SS Ptree node is %zu bytes\n", sizeof(StorageServer::VersionedData::PTreeT));
+	printf("SS Ptree node is %zu bytes\n", sizeof(VersionedMap<KeyRef, ValueOrClearToRef>::PTreeT));
 
 	const int NSIZE = sizeof(VersionedMap<int, int>::PTreeT);
 	const int ASIZE = NSIZE <= 64 ? 64 : nextFastAllocatedSize(NSIZE);
@@ -597,6 +597,8 @@ struct LogData : NonCopyable, public ReferenceCounted<LogData> {
 	Counter nonEmptyPeeks;
 	Counter persistentDataUpdateBatches;
 	Counter dirtyTagsProcessed;
+	Counter compressedCommitBytes; // Wire size of compressed commit requests
+	Counter uncompressedCommitBytes; // Size of the same requests once decompressed
 	std::map<Tag, LatencySample> blockingPeekLatencies;
 	std::map<Tag, LatencySample> peekVersionCounts;
 
@@ -691,7 +693,8 @@ struct LogData : NonCopyable, public ReferenceCounted<LogData> {
 	    bytesDurable("BytesDurable", cc), blockingPeeks("BlockingPeeks", cc),
 	    blockingPeekTimeouts("BlockingPeekTimeouts", cc), emptyPeeks("EmptyPeeks", cc),
 	    nonEmptyPeeks("NonEmptyPeeks", cc), persistentDataUpdateBatches("PersistentDataUpdateBatches", cc),
-	    dirtyTagsProcessed("DirtyTagsProcessed", cc), logId(interf.id()), protocolVersion(protocolVersion),
+	    dirtyTagsProcessed("DirtyTagsProcessed", cc), compressedCommitBytes("CompressedCommitBytes", cc),
+	    uncompressedCommitBytes("UncompressedCommitBytes", cc), logId(interf.id()), protocolVersion(protocolVersion),
 	    newPersistentDataVersion(invalidVersion), tLogData(tLogData), unrecoveredBefore(1), recoveredAt(1),
 	    recoveryTxnVersion(1), logSystem(new AsyncVar<Reference<ILogSystem>>()), remoteTag(remoteTag),
 	    isPrimary(isPrimary), logRouterTags(logRouterTags), logRouterPoppedVersion(0), logRouterPopToVersion(0),
@@ -2477,6 +2480,11 @@ ACTOR Future<Void> tLogCommit(TLogData* self,
 		if (req.debugID.present())
 			g_traceBatch.addEvent("CommitDebug", tlogDebugID.get().first(), "TLog.tLogCommit.Before");
 
+		if (req.messagesCompression.present()) {
+			logData->compressedCommitBytes += req.decompressMessages();
+			logData->uncompressedCommitBytes += req.messages.size();
+		}
+
 		//TraceEvent("TLogCommit", logData->logId).detail("Version", req.version);
 		commitMessages(self, logData, req.version, req.arena, req.messages);
 
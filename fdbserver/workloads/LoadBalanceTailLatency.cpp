@@ -0,0 +1,129 @@
+/*
+ * LoadBalanceTailLatency.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2026 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fdbrpc/DDSketch.h"
+#include "fdbrpc/simulator.h"
+#include "fdbclient/DatabaseContext.h"
+#include "fdbclient/NativeAPI.actor.h"
+#include "fdbserver/core/QuietDatabase.h"
+#include "fdbserver/core/TesterInterface.h"
+#include "fdbserver/tester/workloads.h"
+#include "BulkSetup.h"
+
+// Compares the read tail latency of the two load balancing replica selection policies while one storage server is
+// intermittently slow. In simulation every client repeatedly clogs its connection to the same storage server for up to
+// clogSeconds. Clients then read random keys for testDuration seconds with QueueModel's outstanding request selection,
+// and for another testDuration seconds with latency sketch selection (LOAD_BALANCE_LATENCY_SKETCH).
+struct LoadBalanceTailLatencyWorkload : KVWorkload {
+	static constexpr auto NAME = "LoadBalanceTailLatency";
+
+	double testDuration;
+	double clogSeconds;
+	double clogInterval;
+	std::vector<Future<Void>> clients;
+	PerfIntCounter queueModelReads, sketchReads;
+	DDSketch<double> queueModelLatencies, sketchLatencies;
+
+	LoadBalanceTailLatencyWorkload(WorkloadContext const& wcx)
+	  : KVWorkload(wcx), queueModelReads("QueueModelReads"), sketchReads("SketchReads") {
+		testDuration = getOption(options, "testDuration"_sr, 20.0);
+		clogSeconds = getOption(options, "clogSeconds"_sr, 0.05);
+		clogInterval = getOption(options, "clogInterval"_sr, 0.5);
+	}
+
+	Standalone<KeyValueRef> operator()(uint64_t n) { return KeyValueRef(keyForIndex(n, false), randomValue()); }
+
+	Future<Void> setup(Database const& cx) override { return bulkSetup(cx, this, nodeCount, Promise<double>()); }
+
+	Future<bool> check(Database const& cx) override { return true; }
+
+	void getMetrics(std::vector<PerfMetric>& m) override {
+		m.push_back(queueModelReads.getMetric());
+		m.push_back(sketchReads.getMetric());
+		m.emplace_back("QueueModel median latency (ms)", 1000 * queueModelLatencies.median(), Averaged::True);
+		m.emplace_back("QueueModel 99% latency (ms)", 1000 * queueModelLatencies.percentile(0.99), Averaged::True);
+		m.emplace_back("QueueModel 99.9% latency (ms)", 1000 * queueModelLatencies.percentile(0.999), Averaged::True);
+		m.emplace_back("Sketch median latency (ms)", 1000 * sketchLatencies.median(), Averaged::True);
+		m.emplace_back("Sketch 99% latency (ms)", 1000 * sketchLatencies.percentile(0.99), Averaged::True);
+		m.emplace_back("Sketch 99.9% latency (ms)", 1000 * sketchLatencies.percentile(0.999), Averaged::True);
+	}
+
+	Future<Void> start(Database const& cx) override {
+		Future<Void> slowReplica = Void();
+		if (g_network->isSimulated()) {
+			std::vector<StorageServerInterface> servers = co_await getStorageServers(cx);
+			std::sort(servers.begin(), servers.end(), [](auto const& a, auto const& b) { return a.id() < b.id(); });
+			// Every client slows down its connection to the same server
+			StorageServerInterface slow = servers[sharedRandomNumber % servers.size()];
+			TraceEvent("LoadBalanceTailLatencySlowReplica").detail("Server", slow.id()).detail("Address", slow.address());
+			slowReplica = clogLoop(slow.address().ip);
+		}
+
+		co_await runPhase(cx, false, queueModelReads, queueModelLatencies);
+		co_await runPhase(cx, true, sketchReads, sketchLatencies);
+		slowReplica.cancel();
+		cx->queueModel.latencySketchSelection = FLOW_KNOBS->LOAD_BALANCE_LATENCY_SKETCH;
+	}
+
+	Future<Void> clogLoop(IPAddress slow) {
+		IPAddress self = g_network->getLocalAddress().ip;
+		if (self == slow) {
+			co_return;
+		}
+		while (true) {
+			co_await delay(clogInterval * deterministicRandom()->random01());
+			double seconds = clogSeconds * deterministicRandom()->random01();
+			g_simulator->clogPair(self, slow, seconds);
+			g_simulator->clogPair(slow, self, seconds);
+		}
+	}
+
+	Future<Void> runPhase(Database cx, bool latencySketch, PerfIntCounter& reads, DDSketch<double>& latencies) {
+		cx->queueModel.latencySketchSelection = latencySketch;
+		for (int i = 0; i < actorCount; i++) {
+			clients.push_back(readClient(cx, &reads, &latencies));
+		}
+		co_await timeout(waitForAll(clients), testDuration, Void());
+		clients.clear();
+	}
+
+	Future<Void> readClient(Database cx, PerfIntCounter* reads, DDSketch<double>* latencies) {
+		while (true) {
+			Transaction tr(cx);
+			Key key = keyForIndex(deterministicRandom()->randomInt64(0, nodeCount), false);
+			while (true) {
+				Error err;
+				try {
+					co_await tr.getReadVersion();
+					double start = now();
+					co_await tr.get(key);
+					latencies->addSample(now() - start);
+					break;
+				} catch (Error& e) {
+					err = e;
+				}
+				co_await tr.onError(err);
+			}
+			++*reads;
+		}
+	}
+};
+
+WorkloadFactory<LoadBalanceTailLatencyWorkload> LoadBalanceTailLatencyWorkloadFactory;
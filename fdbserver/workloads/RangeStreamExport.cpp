@@ -0,0 +1,132 @@
+/*
+ * RangeStreamExport.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2026 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fdbclient/FDBOptions.g.h"
+#include "fdbclient/KeyRangeMap.h"
+#include "fdbclient/NativeAPI.actor.h"
+#include "fdbclient/SystemData.h"
+#include "fdbserver/core/TesterInterface.h"
+#include "fdbserver/tester/workloads.h"
+#include "BulkSetup.h"
+
+// Measures end-to-end getRangeStream throughput over a single shard, as a bulk exporter would see it. The first shard
+// of the loaded key space is scanned repeatedly by one client, with the range_stream_export_window option set to
+// exportWindowBytes (0 uses the default stream limits, for comparison).
+struct RangeStreamExportWorkload : KVWorkload {
+	static constexpr auto NAME = "RangeStreamExport";
+
+	double testDuration;
+	int64_t exportWindowBytes;
+	double elapsed;
+	PerfIntCounter scans, bytesRead, rowsRead;
+
+	RangeStreamExportWorkload(WorkloadContext const& wcx)
+	  : KVWorkload(wcx), elapsed(0.0), scans("Scans"), bytesRead("BytesRead"), rowsRead("RowsRead") {
+		testDuration = getOption(options, "testDuration"_sr, 30.0);
+		exportWindowBytes = getOption(options, "exportWindowBytes"_sr, (int64_t)32e6);
+	}
+
+	Standalone<KeyValueRef> operator()(uint64_t n) { return KeyValueRef(keyForIndex(n, false), randomValue()); }
+
+	Future<Void> setup(Database const& cx) override { return bulkSetup(cx, this, nodeCount, Promise<double>()); }
+
+	Future<Void> start(Database const& cx) override {
+		if (clientId != 0) {
+			return Void();
+		}
+		return timeout(exportClient(cx), testDuration, Void());
+	}
+
+	Future<bool> check(Database const& cx) override { return true; }
+
+	void getMetrics(std::vector<PerfMetric>& m) override {
+		if (clientId != 0) {
+			return;
+		}
+		m.push_back(scans.getMetric());
+		m.push_back(rowsRead.getMetric());
+		m.push_back(bytesRead.getMetric());
+		m.emplace_back("Export window (bytes)", exportWindowBytes, Averaged::False);
+		m.emplace_back("MB/s", elapsed > 0 ? bytesRead.getValue() / elapsed / 1e6 : 0.0, Averaged::False);
+	}
+
+	// Returns the first shard boundary range that intersects the loaded keys
+	Future<KeyRange> firstShard(Database cx) {
+		Transaction tr(cx);
+		KeyRange loaded(KeyRangeRef(keyForIndex(0, false), keyForIndex(nodeCount, false)));
+		while (true) {
+			Error err;
+			try {
+				tr.setOption(FDBTransactionOptions::ACCESS_SYSTEM_KEYS);
+				RangeResult shards = co_await krmGetRanges(&tr, keyServersPrefix, loaded, 2, CLIENT_KNOBS->TOO_MANY);
+				ASSERT(shards.size() >= 2);
+				co_return KeyRange(KeyRangeRef(shards[0].key, shards[1].key));
+			} catch (Error& e) {
+				err = e;
+			}
+			co_await tr.onError(err);
+		}
+	}
+
+	Future<Void> exportClient(Database cx) {
+		KeyRange shard = co_await firstShard(cx);
+		TraceEvent("RangeStreamExportShard").detail("Range", shard).detail("ExportWindowBytes", exportWindowBytes);
+
+		double start = now();
+		while (true) {
+			Transaction tr(cx);
+			Key next = shard.begin;
+			while (true) {
+				PromiseStream<RangeResult> results;
+				Error err;
+				try {
+					if (exportWindowBytes > 0) {
+						tr.setOption(FDBTransactionOptions::RANGE_STREAM_EXPORT_WINDOW,
+						             StringRef((uint8_t*)&exportWindowBytes, sizeof(int64_t)));
+					}
+					Future<Void> stream = tr.getRangeStream(results,
+					                                        KeySelector(firstGreaterOrEqual(next), next.arena()),
+					                                        KeySelector(firstGreaterOrEqual(shard.end), shard.arena()),
+					                                        GetRangeLimits());
+					while (true) {
+						RangeResult range = co_await results.getFuture();
+						for (const auto& kv : range) {
+							bytesRead += kv.key.size() + kv.value.size();
+						}
+						rowsRead += range.size();
+						elapsed = now() - start;
+						if (!range.empty()) {
+							next = keyAfter(range.back().key);
+						}
+					}
+				} catch (Error& e) {
+					err = e;
+				}
+				if (err.code() == error_code_end_of_stream) {
+					break;
+				}
+				co_await tr.onError(err);
+			}
+			++scans;
+		}
+	}
+};
+
+WorkloadFactory<RangeStreamExportWorkload> RangeStreamExportWorkloadFactory;
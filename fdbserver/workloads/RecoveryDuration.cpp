@@ -0,0 +1,123 @@
+/*
+ * RecoveryDuration.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2026 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fdbrpc/DDSketch.h"
+#include "fdbrpc/SimulatorProcessInfo.h"
+#include "fdbrpc/simulator.h"
+#include "fdbclient/ReadYourWrites.h"
+#include "fdbserver/core/RecoveryState.h"
+#include "fdbserver/core/ServerDBInfo.h"
+#include "fdbserver/core/TesterInterface.h"
+#include "fdbserver/tester/workloads.h"
+
+// Measures how long the cluster is unavailable for writes during a recovery. In simulation the process running the
+// sequencer is rebooted numRecoveries times, and each sample is the time from the reboot until a commit succeeds
+// again. The duration of every recovery phase is traced by the cluster controller with the RecoveryDuration event.
+struct RecoveryDurationWorkload : TestWorkload {
+	static constexpr auto NAME = "RecoveryDuration";
+
+	int numRecoveries;
+	double delayBetweenRecoveries;
+	PerfIntCounter recoveries;
+	DDSketch<double> recoveryTimes;
+	double maxRecoveryTime;
+
+	RecoveryDurationWorkload(WorkloadContext const& wcx)
+	  : TestWorkload(wcx), recoveries("Recoveries"), maxRecoveryTime(0.0) {
+		numRecoveries = getOption(options, "numRecoveries"_sr, 5);
+		delayBetweenRecoveries = getOption(options, "delayBetweenRecoveries"_sr, 5.0);
+	}
+
+	void disableFailureInjectionWorkloads(std::set<std::string>& out) const override { out.insert("all"); }
+
+	Future<Void> setup(Database const& cx) override { return Void(); }
+
+	Future<Void> start(Database const& cx) override {
+		if (clientId != 0 || !g_network->isSimulated()) {
+			return Void();
+		}
+		return recoveryLoop(cx);
+	}
+
+	Future<bool> check(Database const& cx) override { return true; }
+
+	void getMetrics(std::vector<PerfMetric>& m) override {
+		if (clientId != 0) {
+			return;
+		}
+		m.push_back(recoveries.getMetric());
+		m.emplace_back("Mean recovery time (ms)", 1000 * recoveryTimes.mean(), Averaged::False);
+		m.emplace_back("Median recovery time (ms)", 1000 * recoveryTimes.median(), Averaged::False);
+		m.emplace_back("Max recovery time (ms)", 1000 * maxRecoveryTime, Averaged::False);
+	}
+
+	Future<Void> acceptingCommits() {
+		while (dbInfo->get().recoveryState < RecoveryState::ACCEPTING_COMMITS) {
+			co_await dbInfo->onChange();
+		}
+	}
+
+	// Commits a self conflicting transaction, which succeeds only once the new transaction subsystem accepts commits
+	Future<Void> commitOnce(Database cx) {
+		ReadYourWritesTransaction tr(cx);
+		while (true) {
+			Error err;
+			try {
+				tr.setOption(FDBTransactionOptions::LOCK_AWARE);
+				tr.setOption(FDBTransactionOptions::PRIORITY_SYSTEM_IMMEDIATE);
+				co_await tr.getReadVersion();
+				tr.makeSelfConflicting();
+				co_await tr.commit();
+				co_return;
+			} catch (Error& e) {
+				err = e;
+			}
+			co_await tr.onError(err);
+		}
+	}
+
+	Future<Void> recoveryLoop(Database cx) {
+		for (int i = 0; i < numRecoveries; i++) {
+			co_await delay(delayBetweenRecoveries);
+			co_await acceptingCommits();
+			co_await commitOnce(cx);
+
+			NetworkAddress master = dbInfo->get().master.address();
+			TraceEvent("RecoveryDurationRebootSequencer").detail("Index", i).detail("Address", master);
+			double start = now();
+			g_simulator->rebootProcess(g_simulator->getProcessByAddress(master), ISimulator::KillType::Reboot);
+
+			// Wait for the recovery to start before waiting for it to finish
+			while (dbInfo->get().master.address() == master &&
+			       dbInfo->get().recoveryState >= RecoveryState::ACCEPTING_COMMITS) {
+				co_await dbInfo->onChange();
+			}
+			co_await commitOnce(cx);
+
+			double duration = now() - start;
+			recoveryTimes.addSample(duration);
+			maxRecoveryTime = std::max(maxRecoveryTime, duration);
+			++recoveries;
+			TraceEvent("RecoveryDurationSample").detail("Index", i).detail("Duration", duration);
+		}
+	}
+};
+
+WorkloadFactory<RecoveryDurationWorkload> RecoveryDurationWorkloadFactory;
@@ -56,6 +56,10 @@ struct S3ClientWorkload : TestWorkload {
 	double corruptionRate;
 	double maxDelay;
 
+	// Large object round trip, measuring the download throughput of copyDownFile
+	int64_t largeFileBytes;
+	double largeFileDownloadSeconds;
+
 	S3ClientWorkload(WorkloadContext const& wcx) : TestWorkload(wcx), enabled(true), pass(true) {
 		s3Url = getOption(options, "s3Url"_sr, ""_sr).toString();
 		if (s3Url.empty()) {
@@ -73,6 +77,9 @@ struct S3ClientWorkload : TestWorkload {
 		delayRate = getOption(options, "delayRate"_sr, 0.1);
 		corruptionRate = getOption(options, "corruptionRate"_sr, 0.01);
 		maxDelay = getOption(options, "maxDelay"_sr, 2.0);
+
+		largeFileBytes = getOption(options, "largeFileBytes"_sr, (int64_t)0);
+		largeFileDownloadSeconds = 0.0;
 	}
 	~S3ClientWorkload() override {
 		if (pass) {
@@ -90,7 +97,16 @@ struct S3ClientWorkload : TestWorkload {
 
 	Future<bool> check(Database const& cx) override { return true; }
 
-	void getMetrics(std::vector<PerfMetric>& m) override {}
+	void getMetrics(std::vector<PerfMetric>& m) override {
+		if (clientId != 0 || largeFileBytes <= 0) {
+			return;
+		}
+		m.emplace_back("Large file bytes", largeFileBytes, Averaged::False);
+		m.emplace_back("Large file download seconds", largeFileDownloadSeconds, Averaged::False);
+		m.emplace_back("Large file download MB/s",
+		               largeFileDownloadSeconds > 0 ? largeFileBytes / largeFileDownloadSeconds / 1e6 : 0.0,
+		               Averaged::False);
+	}
 
 private:
 	void setupCredentialsFile() {
@@ -153,6 +169,34 @@ private:
 		}
 	}
 
+	// Upload a file of largeFileBytes random bytes, time its download and check the downloaded content.
+	// The object spans many parts, so this exercises the concurrent ranged GETs of copyDownFile.
+	Future<Void> largeFileRoundTrip(std::string runDir) {
+		std::string upload = joinPath(runDir, "large_upload");
+		std::string download = joinPath(runDir, "large_download");
+		std::string content(largeFileBytes, '\0');
+		deterministicRandom()->randomBytes((uint8_t*)content.data(), content.size());
+		writeFile(upload, content);
+
+		std::string fileUrl =
+		    addFileToUrl(format("large_%08x_%08x", clientId, deterministicRandom()->randomInt(0, 1000000)), s3Url);
+		co_await copyUpFile(upload, fileUrl);
+		double start = now();
+		co_await copyDownFile(fileUrl, download);
+		largeFileDownloadSeconds = now() - start;
+		co_await deleteResource(fileUrl);
+
+		if (readFileBytes(download, largeFileBytes) != content) {
+			TraceEvent(SevError, "S3ClientWorkloadLargeFileContentMismatch").detail("Bytes", largeFileBytes);
+			throw file_not_found();
+		}
+		TraceEvent("S3ClientWorkloadLargeFileRoundTrip")
+		    .detail("Bytes", largeFileBytes)
+		    .detail("DownloadSeconds", largeFileDownloadSeconds);
+		deleteFile(upload);
+		deleteFile(download);
+	}
+
 	Future<Void> start(Database const& cx) override {
 		if (clientId != 0) {
 			// Our simulation test can trigger multiple same workloads at the same time
@@ -269,6 +313,10 @@ private:
 			throw file_not_found();
 		}
 
+		if (largeFileBytes > 0) {
+			co_await largeFileRoundTrip(uniqueRunDir);
+		}
+
 		// Cleanup local files - each operation handles its own errors non-fatally
 		// Delete credentials file
 		try {
@@ -0,0 +1,127 @@
+/*
+ * StorageServerIngest.cpp
+ *
+ * This source file is part of the FoundationDB open source project
+ *
+ * Copyright 2013-2026 Apple Inc. and the FoundationDB project authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "fdbrpc/DDSketch.h"
+#include "fdbclient/NativeAPI.actor.h"
+#include "fdbserver/core/TesterInterface.h"
+#include "fdbserver/tester/workloads.h"
+
+// Measures how fast storage servers apply small mutations. Clients blindly write batches of small values spread over
+// the key space, and once the write phase ends the workload measures how long it takes for a read at the latest
+// committed version to be served, i.e. how far the storage servers' update loops trail the commit pipeline.
+// Storage servers still apply the mutations of a version serially on their network thread, since all shards share
+// one VersionedData; this workload is a baseline for that path, not a test of a concurrent one.
+struct StorageServerIngestWorkload : KVWorkload {
+	static constexpr auto NAME = "StorageServerIngest";
+
+	int keysPerTransaction;
+	bool sequentialKeys;
+	double testDuration;
+	double catchUpTime;
+	std::vector<Future<Void>> clients;
+	PerfIntCounter transactions, retries, mutations, bytesWritten;
+	DDSketch<double> commitLatencies;
+
+	StorageServerIngestWorkload(WorkloadContext const& wcx)
+	  : KVWorkload(wcx), catchUpTime(0.0), transactions("Transactions"), retries("Retries"), mutations("Mutations"),
+	    bytesWritten("BytesWritten"), commitLatencies() {
+		testDuration = getOption(options, "testDuration"_sr, 10.0);
+		keysPerTransaction = getOption(options, "keysPerTransaction"_sr, 500);
+		// Sequential keys hit few shards per version, random keys spread each version over many shards
+		sequentialKeys = getOption(options, "sequentialKeys"_sr, false);
+	}
+
+	Future<bool> check(Database const& cx) override { return true; }
+
+	void getMetrics(std::vector<PerfMetric>& m) override {
+		m.emplace_back("Measured Duration", testDuration, Averaged::True);
+		m.emplace_back("Transactions/sec", transactions.getValue() / testDuration, Averaged::False);
+		m.emplace_back("Mutations/sec", mutations.getValue() / testDuration, Averaged::False);
+		m.emplace_back("Bytes written/sec", bytesWritten.getValue() / testDuration, Averaged::False);
+		m.push_back(transactions.getMetric());
+		m.push_back(retries.getMetric());
+		m.emplace_back("Median Commit Latency (ms, averaged)", 1000 * commitLatencies.median(), Averaged::True);
+		m.emplace_back("98% Commit Latency (ms, averaged)", 1000 * commitLatencies.percentile(0.98), Averaged::True);
+		m.emplace_back("Storage catch-up time (seconds)", catchUpTime, Averaged::True);
+	}
+
+	Future<Void> start(Database const& cx) override {
+		for (int i = 0; i < actorCount; i++) {
+			clients.push_back(writeClient(cx, this));
+		}
+
+		co_await timeout(waitForAll(clients), testDuration, Void());
+		clients.clear();
+
+		// A read at the latest version waits until the storage server owning the key has applied every mutation up
+		// to that version, which measures the ingest backlog left behind by the write phase.
+		double start = now();
+		Transaction tr(cx);
+		while (true) {
+			Error err;
+			try {
+				co_await tr.getReadVersion();
+				co_await tr.get(keyForIndex(deterministicRandom()->randomInt64(0, nodeCount), false));
+				break;
+			} catch (Error& e) {
+				err = e;
+			}
+			co_await tr.onError(err);
+		}
+		catchUpTime = now() - start;
+	}
+
+	Future<Void> writeClient(Database cx, StorageServerIngestWorkload* self) {
+		while (true) {
+			Transaction tr(cx);
+			uint64_t startIdx =
+			    deterministicRandom()->random01() * std::max<int64_t>(0, self->nodeCount - self->keysPerTransaction);
+			int64_t bytes = 0;
+			while (true) {
+				Error err;
+				try {
+					bytes = 0;
+					for (int i = 0; i < self->keysPerTransaction; i++) {
+						uint64_t idx = self->sequentialKeys ? startIdx + i
+						                                    : deterministicRandom()->randomInt64(0, self->nodeCount);
+						Key key = self->keyForIndex(idx, false);
+						Value value = self->randomValue();
+						bytes += key.size() + value.size();
+						tr.set(key, value, AddConflictRange::False);
+					}
+
+					double start = now();
+					co_await tr.commit();
+					self->commitLatencies.addSample(now() - start);
+					break;
+				} catch (Error& e) {
+					err = e;
+				}
+				co_await tr.onError(err);
+				++self->retries;
+			}
+			++self->transactions;
+			self->mutations += self->keysPerTransaction;
+			self->bytesWritten += bytes;
+		}
+	}
+};
+
+WorkloadFactory<StorageServerIngestWorkload> StorageServerIngestWorkloadFactory;
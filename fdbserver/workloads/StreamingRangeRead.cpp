@@ -20,6 +20,8 @@
 
 #include "fdbclient/FDBOptions.g.h"
 #include "fdbclient/NativeAPI.actor.h"
+#include "fdbclient/ReadYourWrites.h"
+#include "fdbclient/SystemData.h"
 #include "fdbserver/core/TesterInterface.h"
 #include "fdbserver/tester/workloads.h"
 #include "BulkSetup.h"
@@ -30,15 +32,20 @@
 #include "flow/serialize.h"
 #include <cstring>
 
-Future<Void> streamUsingGetRange(PromiseStream<RangeResult> results, Transaction* tr, KeyRange keys) {
-	KeySelectorRef begin = firstGreaterOrEqual(keys.begin);
-	KeySelectorRef end = firstGreaterOrEqual(keys.end);
+// With parallel set the range is read in FDB_STREAMING_MODE_PARALLEL, which only applies to firstGreaterOrEqual
+// selectors, so every batch begins with one
+Future<Void> streamUsingGetRange(PromiseStream<RangeResult> results, Transaction* tr, KeyRange keys, bool parallel) {
+	KeySelector begin = firstGreaterOrEqual(keys.begin);
+	KeySelector end = firstGreaterOrEqual(keys.end);
 
 	try {
 		while (true) {
 			GetRangeLimits limits(GetRangeLimits::ROW_LIMIT_UNLIMITED, 1e6);
 			limits.minRows = 0;
-			RangeResult rep = co_await tr->getRange(begin, end, limits, Snapshot::True);
+			limits.parallel = parallel;
+			// The parallel path also records the read conflict range of non-snapshot reads
+			Snapshot snapshot(!parallel || deterministicRandom()->coinflip());
+			RangeResult rep = co_await tr->getRange(begin, end, limits, snapshot);
 
 			results.send(rep);
 
@@ -47,7 +54,8 @@ Future<Void> streamUsingGetRange(PromiseStream<RangeResult> results, Transaction
 				co_return;
 			}
 
-			begin = rep.nextBeginKeySelector();
+			Key next = rep.getReadThrough();
+			begin = KeySelector(firstGreaterOrEqual(next), next.arena());
 		}
 	} catch (Error& e) {
 		if (e.code() == error_code_actor_cancelled) {
@@ -77,10 +85,13 @@ Future<Void> convertStream(PromiseStream<RangeResult> input, PromiseStream<KeyVa
 struct StreamingRangeReadWorkload : KVWorkload {
 	static constexpr auto NAME = "StreamingRangeRead";
 	double testDuration;
+	bool parallelGetRange;
 	Future<Void> client;
 
 	StreamingRangeReadWorkload(WorkloadContext const& wcx) : KVWorkload(wcx) {
 		testDuration = getOption(options, "testDuration"_sr, 60.0);
+		// Compare the stream against FDB_STREAMING_MODE_PARALLEL reads instead of serial ones
+		parallelGetRange = getOption(options, "parallelGetRange"_sr, sharedRandomNumber % 2 == 0);
 	}
 
 	Standalone<KeyValueRef> operator()(uint64_t n) { return KeyValueRef(keyForIndex(n, false), randomValue()); }
@@ -93,11 +104,54 @@ struct StreamingRangeReadWorkload : KVWorkload {
 
 	Future<bool> check(Database const& cx) override {
 		client = Void();
-		return true;
+		if (clientId != 0) {
+			return true;
+		}
+		return checkParallelShards(cx);
 	}
 
 	void getMetrics(std::vector<PerfMetric>& m) override {}
 
+	// Reads the database through ReadYourWrites in FDB_STREAMING_MODE_PARALLEL and checks that a range spanning several
+	// shards is read with more than one shard request in flight at once
+	Future<bool> checkParallelShards(Database cx) {
+		ReadYourWritesTransaction tr(cx);
+		while (true) {
+			Error err;
+			try {
+				tr.setOption(FDBTransactionOptions::READ_SYSTEM_KEYS);
+				RangeResult shards = co_await tr.getRange(
+				    KeyRangeRef(keyServersKey(normalKeys.begin), keyServersKey(normalKeys.end)), CLIENT_KNOBS->TOO_MANY);
+				// Look up the locations again so that the read sees the shards counted above
+				cx->invalidateCache(normalKeys);
+
+				int64_t batches = cx->transactionGetRangeParallelBatches.getValue();
+				int64_t shardRequests = cx->transactionGetRangeParallelShardRequests.getValue();
+				GetRangeLimits limits(GetRangeLimits::ROW_LIMIT_UNLIMITED, 1e6);
+				limits.parallel = true;
+				co_await tr.getRange(
+				    firstGreaterOrEqual(normalKeys.begin), firstGreaterOrEqual(normalKeys.end), limits, Snapshot::True);
+				batches = cx->transactionGetRangeParallelBatches.getValue() - batches;
+				shardRequests = cx->transactionGetRangeParallelShardRequests.getValue() - shardRequests;
+
+				if (shards.size() > 1 && CLIENT_KNOBS->GET_RANGE_PARALLEL_SHARDS > 1) {
+					CODE_PROBE(true, "Parallel getRange through ReadYourWrites spans several shards");
+					if (batches == 0 || shardRequests <= batches) {
+						TraceEvent(SevError, "StreamingRangeReadParallelShardsNotConcurrent")
+						    .detail("Shards", shards.size())
+						    .detail("Batches", batches)
+						    .detail("ShardRequests", shardRequests);
+						co_return false;
+					}
+				}
+				co_return true;
+			} catch (Error& e) {
+				err = e;
+			}
+			co_await tr.onError(err);
+		}
+	}
+
 	// Reads the database using both the normal get range API and the streaming API and compares the results
 	Future<Void> streamingClient(Database cx) {
 		Transaction tr(cx);
@@ -118,7 +172,7 @@ struct StreamingRangeReadWorkload : KVWorkload {
 			try {
 				compareConvert = convertStream(compareRaw, compareResults);
 				streamConvert = convertStream(streamRaw, streamResults);
-				compare = streamUsingGetRange(compareRaw, &tr, KeyRangeRef(next, normalKeys.end));
+				compare = streamUsingGetRange(compareRaw, &tr, KeyRangeRef(next, normalKeys.end), parallelGetRange);
 				stream = tr.getRangeStream(streamRaw,
 				                           KeySelector(firstGreaterOrEqual(next), next.arena()),
 				                           KeySelector(firstGreaterOrEqual(normalKeys.end)),
@@ -83,6 +83,9 @@ public: // introduced features
     API_VERSION_FEATURE(@FDB_AV_GET_CLIENT_STATUS@, GetClientStatus);
     API_VERSION_FEATURE(@FDB_AV_INITIALIZE_TRACE_ON_SETUP@, InitializeTraceOnSetup);
     API_VERSION_FEATURE(@FDB_AV_TENANT_GET_ID@, TenantGetId);
+    API_VERSION_FEATURE(@FDB_AV_WARM_LOCATION_CACHE@, WarmLocationCache);
+    API_VERSION_FEATURE(@FDB_AV_PARALLEL_RANGE_READS@, ParallelRangeReads);
+    API_VERSION_FEATURE(@FDB_AV_MULTIPLE_KEY_OPERATIONS@, MultipleKeyOperations);
 };
 
 #endif // FLOW_CODE_API_VERSION_H
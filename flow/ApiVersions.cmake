@@ -25,3 +25,6 @@ set(FDB_AV_FUTURE_GET_DOUBLE                "730")
 set(FDB_AV_GET_CLIENT_STATUS                "730")
 set(FDB_AV_INITIALIZE_TRACE_ON_SETUP        "730")
 set(FDB_AV_TENANT_GET_ID                    "730")
+set(FDB_AV_WARM_LOCATION_CACHE              "800")
+set(FDB_AV_PARALLEL_RANGE_READS             "800")
+set(FDB_AV_MULTIPLE_KEY_OPERATIONS          "800")
@@ -297,6 +297,11 @@ void FlowKnobs::initialize(Randomize randomize, IsSimulated isSimulated) {
 	init( FUTURE_VERSION_BACKOFF_GROWTH,                       2.0 );
 	init( LOAD_BALANCE_MAX_BAD_OPTIONS,                          1 ); //should be the same as MAX_MACHINES_FALLING_BEHIND
 	init( LOAD_BALANCE_PENALTY_IS_BAD,                        true );
+	init( LOAD_BALANCE_LATENCY_SKETCH,                       false ); if( randomize && BUGGIFY ) LOAD_BALANCE_LATENCY_SKETCH = true;
+	init( LOAD_BALANCE_SKETCH_PERCENTILE,                     0.99 );
+	init( LOAD_BALANCE_SKETCH_WINDOW,                         10.0 ); if( randomize && BUGGIFY ) LOAD_BALANCE_SKETCH_WINDOW = 1.0;
+	init( LOAD_BALANCE_SKETCH_MIN_SAMPLES,                      20 ); if( randomize && BUGGIFY ) LOAD_BALANCE_SKETCH_MIN_SAMPLES = 1;
+	init( LOAD_BALANCE_SKETCH_HEDGE_LATENCY,                  0.01 ); if( randomize && BUGGIFY ) LOAD_BALANCE_SKETCH_HEDGE_LATENCY = 0.0;
 	init( BASIC_LOAD_BALANCE_UPDATE_RATE,                     10.0 ); //should be longer than the rate we log network metrics
 	init( BASIC_LOAD_BALANCE_MAX_CHANGE,                      0.10 );
 	init( BASIC_LOAD_BALANCE_MAX_PROB,                         2.0 );
@@ -351,6 +351,11 @@ public:
 	double FUTURE_VERSION_BACKOFF_GROWTH;
 	int LOAD_BALANCE_MAX_BAD_OPTIONS;
 	bool LOAD_BALANCE_PENALTY_IS_BAD;
+	bool LOAD_BALANCE_LATENCY_SKETCH; // Pick replicas by predicted tail latency, using two random choices
+	double LOAD_BALANCE_SKETCH_PERCENTILE; // Latency percentile replicas are compared by
+	double LOAD_BALANCE_SKETCH_WINDOW; // Seconds of latency samples kept per replica
+	int LOAD_BALANCE_SKETCH_MIN_SAMPLES; // Samples needed before a replica's latency is predicted
+	double LOAD_BALANCE_SKETCH_HEDGE_LATENCY; // Hedge reads to replicas predicted to be slower than this
 	double BASIC_LOAD_BALANCE_UPDATE_RATE;
 	double BASIC_LOAD_BALANCE_MAX_CHANGE;
 	double BASIC_LOAD_BALANCE_MAX_PROB;